@@ -16,6 +16,10 @@
 
 #include "DTK_Benchmark_CartesianMesh.hpp"
 
+#include <Teuchos_DefaultMpiComm.hpp>
+
+#include <numeric>
+
 namespace DataTransferKit
 {
 namespace Benchmark
@@ -39,6 +43,8 @@ CartesianMesh::CartesianMesh(
     _num_i_blocks = num_i_blocks;
     _num_j_blocks = num_j_blocks;
     _num_k_blocks = num_k_blocks;
+    _local_edges = {local_x_edges, local_y_edges, local_z_edges};
+    _edge_offsets = {x_edge_offset, y_edge_offset, z_edge_offset};
 
     // Compute the local number of nodes.
     int x_local_num_node = local_x_edges.size();
@@ -170,6 +176,26 @@ CartesianMesh::CartesianMesh(
     }
 }
 
+//---------------------------------------------------------------------------//
+// Build a locator for the global grid of the set of this mesh.
+RectilinearGridLocator CartesianMesh::createGridLocator() const
+{
+    std::array<int, 3> num_blocks = {
+        {_num_i_blocks, _num_j_blocks, _num_k_blocks}};
+    std::array<int, 3> ijk_block;
+    ijk_block[0] = _block_id % num_blocks[0];
+    ijk_block[1] = ( _block_id / num_blocks[0] ) % num_blocks[1];
+    ijk_block[2] = _block_id / ( num_blocks[0] * num_blocks[1] );
+
+    // The blocks of a set are owned by consecutive ranks.
+    std::vector<int> block_ranks( numBlocks() );
+    std::iota( block_ranks.begin(), block_ranks.end(), _set_id * numBlocks() );
+
+    return RectilinearGridLocator( Teuchos::getRawMpiComm( *_comm ),
+                                   num_blocks, ijk_block, _local_edges,
+                                   _edge_offsets, block_ranks );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Benchmark
@@ -17,6 +17,7 @@
 #ifndef DTK_CARTESIANMESH_HPP
 #define DTK_CARTESIANMESH_HPP
 
+#include "DTK_RectilinearGridLocator.hpp"
 #include "DTK_Types.h"
 
 #include <Kokkos_Core.hpp>
@@ -24,6 +25,7 @@
 #include <Teuchos_Comm.hpp>
 #include <Teuchos_RCP.hpp>
 
+#include <array>
 #include <vector>
 
 namespace DataTransferKit
@@ -178,6 +180,20 @@ class CartesianMesh
         return _local_cell_center_coords;
     }
 
+    // Get the local edges (node locations) in a given dimension.
+    const std::vector<double> &localEdges( const int dim ) const
+    {
+        return _local_edges[dim];
+    }
+
+    // Get the starting index of the local nodes in the global edges in a
+    // given dimension.
+    int edgeOffset( const int dim ) const { return _edge_offsets[dim]; }
+
+    // Build a locator for the global grid of the set of this mesh. This is a
+    // collective operation over the communicator of the mesh.
+    RectilinearGridLocator createGridLocator() const;
+
   private:
     // Communicator.
     Teuchos::RCP<const Teuchos::Comm<int>> _comm;
@@ -211,6 +227,13 @@ class CartesianMesh
 
     // Local cell center coordinates.
     Kokkos::View<Coordinate **> _local_cell_center_coords;
+
+    // Local edges in each dimension.
+    std::array<std::vector<double>, 3> _local_edges;
+
+    // Starting index of the local nodes in the global edges in each
+    // dimension.
+    std::array<int, 3> _edge_offsets;
 };
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,247 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file DTK_Benchmark_CellTransfer.cpp
+ * \brief Transfer of cell-centered data between the Cartesian meshes of the
+ * hybrid transport benchmark.
+ */
+//---------------------------------------------------------------------------//
+
+#include "DTK_Benchmark_CellTransfer.hpp"
+#include "DTK_DBC.hpp"
+
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_DefaultMpiComm.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace DataTransferKit
+{
+namespace Benchmark
+{
+//---------------------------------------------------------------------------//
+// Constructor.
+CellTransfer::CellTransfer( const CartesianMesh &source_mesh,
+                            const CartesianMesh &target_mesh,
+                            const ReplicationMode mode )
+    : CellTransfer( target_mesh, mode )
+{
+    DTK_REQUIRE( source_mesh.comm()->getSize() == _comm->getSize() );
+
+    // Locate the target cell centers in the source mesh. Processes which
+    // receive their values through the broadcast have nothing to locate but
+    // the locator construction is collective.
+    auto source_locator = source_mesh.createGridLocator();
+    Kokkos::View<Coordinate **> centers =
+        computesValues() ? target_mesh.localCellCenterCoordinates()
+                         : Kokkos::View<Coordinate **>( "centers", 0, 3 );
+    Kokkos::View<int *> source_ranks;
+    Kokkos::View<GlobalOrdinal *> source_cell_ids;
+    Kokkos::View<LocalOrdinal *> source_local_cell_ids;
+    source_locator.locate( centers, source_ranks, source_cell_ids,
+                           source_local_cell_ids );
+
+    // Each target cell gets the value of the source cell containing its
+    // center, if any.
+    std::vector<int> offsets( _num_target_cells + 1, 0 );
+    std::vector<int> ranks;
+    std::vector<int> cells;
+    std::vector<double> weights;
+    int num_centers = centers.extent( 0 );
+    for ( int t = 0; t < num_centers; ++t )
+    {
+        if ( source_ranks( t ) >= 0 )
+        {
+            ranks.push_back( source_ranks( t ) );
+            cells.push_back( source_local_cell_ids( t ) );
+            weights.push_back( 1.0 );
+        }
+        offsets[t + 1] = ranks.size();
+    }
+
+    buildPlan( offsets, ranks, cells, weights );
+}
+
+//---------------------------------------------------------------------------//
+// Constructor for derived classes.
+CellTransfer::CellTransfer( const CartesianMesh &target_mesh,
+                            const ReplicationMode mode )
+    : _comm( target_mesh.comm() )
+    , _mode( mode )
+{
+    _computes_values = ( EachSet == _mode ) || ( 0 == target_mesh.setId() );
+    _num_target_cells = target_mesh.localCellGlobalIds().extent( 0 );
+
+    // Group the processes owning the same block in every set. Ordering by
+    // set id makes the process of the first set the root of the broadcast.
+    _replica_comm = _comm->split( target_mesh.blockId(), target_mesh.setId() );
+}
+
+//---------------------------------------------------------------------------//
+// Transfer the values.
+void CellTransfer::apply( Kokkos::View<const double *> source_values,
+                          Kokkos::View<double *> target_values ) const
+{
+    DTK_REQUIRE( target_values.extent( 0 ) ==
+                 static_cast<std::size_t>( _num_target_cells ) );
+
+    // Send the requested source values to the ranks sharing cells with this
+    // process only.
+    std::vector<double> export_values( _export_cells.size() );
+    for ( std::size_t i = 0; i < _export_cells.size(); ++i )
+        export_values[i] = source_values( _export_cells[i] );
+    std::vector<double> import_values( _import_offsets.back() );
+    exchangeValues( export_values, import_values );
+
+    // Compute the target values.
+    if ( _computes_values )
+    {
+        for ( int t = 0; t < _num_target_cells; ++t )
+        {
+            target_values( t ) = 0.;
+            for ( int e = _target_offsets[t]; e < _target_offsets[t + 1];
+                  ++e )
+                target_values( t ) +=
+                    _weights[e] * import_values[_entry_imports[e]];
+        }
+    }
+
+    // Fan the values of the first set out to the other sets.
+    if ( FirstSetBroadcast == _mode && _replica_comm->getSize() > 1 )
+        Teuchos::broadcast( *_replica_comm, 0, _num_target_cells,
+                            target_values.data() );
+}
+
+//---------------------------------------------------------------------------//
+// Build the communication plan.
+void CellTransfer::buildPlan( const std::vector<int> &offsets,
+                              const std::vector<int> &ranks,
+                              const std::vector<int> &cells,
+                              const std::vector<double> &weights )
+{
+    DTK_REQUIRE( offsets.size() ==
+                 static_cast<std::size_t>( _num_target_cells + 1 ) );
+    DTK_REQUIRE( ranks.size() == cells.size() );
+    DTK_REQUIRE( ranks.size() == weights.size() );
+    DTK_REQUIRE( computesValues() || ranks.empty() );
+
+    _target_offsets = offsets;
+    _weights = weights;
+
+    // Only request each source cell once even if several entries use it.
+    int num_entries = ranks.size();
+    std::vector<std::pair<int, int>> requests( num_entries );
+    for ( int e = 0; e < num_entries; ++e )
+        requests[e] = std::make_pair( ranks[e], cells[e] );
+    std::sort( requests.begin(), requests.end() );
+    requests.erase( std::unique( requests.begin(), requests.end() ),
+                    requests.end() );
+    _entry_imports.resize( num_entries );
+    for ( int e = 0; e < num_entries; ++e )
+    {
+        auto request = std::lower_bound( requests.begin(), requests.end(),
+                                         std::make_pair( ranks[e], cells[e] ) );
+        _entry_imports[e] = std::distance( requests.begin(), request );
+    }
+
+    // Group the requests by rank.
+    int comm_size = _comm->getSize();
+    std::vector<int> import_counts( comm_size, 0 );
+    std::vector<int> import_cells( requests.size() );
+    for ( std::size_t i = 0; i < requests.size(); ++i )
+    {
+        ++import_counts[requests[i].first];
+        import_cells[i] = requests[i].second;
+    }
+
+    // Tell each rank how many of its cells are requested. This is the only
+    // collective exchange of the plan, the requests and the values are then
+    // sent point to point between the ranks sharing cells.
+    MPI_Comm comm = Teuchos::getRawMpiComm( *_comm );
+    std::vector<int> export_counts( comm_size, 0 );
+    MPI_Alltoall( import_counts.data(), 1, MPI_INT, export_counts.data(), 1,
+                  MPI_INT, comm );
+    _import_ranks.clear();
+    _import_offsets.assign( 1, 0 );
+    _export_ranks.clear();
+    _export_offsets.assign( 1, 0 );
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        if ( import_counts[r] > 0 )
+        {
+            _import_ranks.push_back( r );
+            _import_offsets.push_back( _import_offsets.back() +
+                                       import_counts[r] );
+        }
+        if ( export_counts[r] > 0 )
+        {
+            _export_ranks.push_back( r );
+            _export_offsets.push_back( _export_offsets.back() +
+                                       export_counts[r] );
+        }
+    }
+
+    // Send the requests to the ranks owning the source cells. The requests
+    // travel in the opposite direction of the values.
+    _export_cells.resize( _export_offsets.back() );
+    std::vector<MPI_Request> mpi_requests;
+    mpi_requests.reserve( _import_ranks.size() + _export_ranks.size() );
+    for ( std::size_t i = 0; i < _export_ranks.size(); ++i )
+    {
+        mpi_requests.emplace_back();
+        MPI_Irecv( _export_cells.data() + _export_offsets[i],
+                   _export_offsets[i + 1] - _export_offsets[i], MPI_INT,
+                   _export_ranks[i], 0, comm, &mpi_requests.back() );
+    }
+    for ( std::size_t i = 0; i < _import_ranks.size(); ++i )
+    {
+        mpi_requests.emplace_back();
+        MPI_Isend( import_cells.data() + _import_offsets[i],
+                   _import_offsets[i + 1] - _import_offsets[i], MPI_INT,
+                   _import_ranks[i], 0, comm, &mpi_requests.back() );
+    }
+    MPI_Waitall( mpi_requests.size(), mpi_requests.data(),
+                 MPI_STATUSES_IGNORE );
+}
+
+//---------------------------------------------------------------------------//
+// Send the exported values and receive the imported values.
+void CellTransfer::exchangeValues( const std::vector<double> &export_values,
+                                   std::vector<double> &import_values ) const
+{
+    MPI_Comm comm = Teuchos::getRawMpiComm( *_comm );
+    std::vector<MPI_Request> mpi_requests;
+    mpi_requests.reserve( _import_ranks.size() + _export_ranks.size() );
+    for ( std::size_t i = 0; i < _import_ranks.size(); ++i )
+    {
+        mpi_requests.emplace_back();
+        MPI_Irecv( import_values.data() + _import_offsets[i],
+                   _import_offsets[i + 1] - _import_offsets[i], MPI_DOUBLE,
+                   _import_ranks[i], 0, comm, &mpi_requests.back() );
+    }
+    for ( std::size_t i = 0; i < _export_ranks.size(); ++i )
+    {
+        mpi_requests.emplace_back();
+        MPI_Isend( export_values.data() + _export_offsets[i],
+                   _export_offsets[i + 1] - _export_offsets[i], MPI_DOUBLE,
+                   _export_ranks[i], 0, comm, &mpi_requests.back() );
+    }
+    MPI_Waitall( mpi_requests.size(), mpi_requests.data(),
+                 MPI_STATUSES_IGNORE );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Benchmark
+} // end namespace DataTransferKit
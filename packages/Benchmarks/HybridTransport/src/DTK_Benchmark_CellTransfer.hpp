@@ -0,0 +1,164 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file DTK_Benchmark_CellTransfer.hpp
+ * \brief Transfer of cell-centered data between the Cartesian meshes of the
+ * hybrid transport benchmark.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_CELLTRANSFER_HPP
+#define DTK_CELLTRANSFER_HPP
+
+#include "DTK_Benchmark_CartesianMesh.hpp"
+#include "DTK_Types.h"
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_Comm.hpp>
+#include <Teuchos_RCP.hpp>
+
+#include <vector>
+
+namespace DataTransferKit
+{
+namespace Benchmark
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \class CellTransfer
+ * \brief Transfer cell-centered data from a source Cartesian mesh to a target
+ * Cartesian mesh living on the same communicator.
+ *
+ * Each target cell receives the value of the source cell containing its
+ * center. The source cells are located with a RectilinearGridLocator so no
+ * search tree is built.
+ *
+ * The target mesh may be replicated over several sets (e.g. a
+ * MonteCarloMesh). Since every set holds an identical copy of the grid with
+ * an identical block decomposition, the transfer only needs to be computed
+ * for one set. In the FirstSetBroadcast mode the search and the
+ * point-to-point fetch of the source values are done by the first set only
+ * and the values are then broadcast to the processes owning the same block
+ * in the other sets. In the EachSet mode every set searches and fetches its
+ * values independently, which sends every source value once per set.
+ */
+class CellTransfer
+{
+  public:
+    // Replication modes.
+    enum ReplicationMode
+    {
+        EachSet,
+        FirstSetBroadcast
+    };
+
+    /*!
+     * \brief Constructor. This is a collective operation over the
+     * communicator of the meshes.
+     *
+     * \param source_mesh The local source Cartesian mesh. Its cells must be
+     * uniquely owned within a set.
+     *
+     * \param target_mesh The local target Cartesian mesh.
+     *
+     * \param mode The replication mode used when the target mesh has several
+     * sets.
+     */
+    CellTransfer( const CartesianMesh &source_mesh,
+                  const CartesianMesh &target_mesh,
+                  const ReplicationMode mode = FirstSetBroadcast );
+
+    // Destructor.
+    virtual ~CellTransfer() = default;
+
+    /*!
+     * \brief Transfer the values. This is a collective operation over the
+     * communicator of the meshes.
+     *
+     * \param source_values The values at the local source cells.
+     *
+     * \param target_values The values at the local target cells. Target cells
+     * that do not receive any value are set to zero.
+     */
+    void apply( Kokkos::View<const double *> source_values,
+                Kokkos::View<double *> target_values ) const;
+
+  protected:
+    // Constructor for derived classes which provide their own coefficients
+    // through buildPlan().
+    CellTransfer( const CartesianMesh &target_mesh,
+                  const ReplicationMode mode );
+
+    // Whether this process computes the values of its target cells or
+    // receives them through the broadcast from the first set.
+    bool computesValues() const { return _computes_values; }
+
+    // Build the communication plan. The value of target cell t is the sum
+    // over entries e in [offsets[t], offsets[t+1]) of weights[e] times the
+    // value of the source cell cells[e] owned by ranks[e].
+    void buildPlan( const std::vector<int> &offsets,
+                    const std::vector<int> &ranks,
+                    const std::vector<int> &cells,
+                    const std::vector<double> &weights );
+
+  private:
+    // Send the exported values to the ranks requesting them and receive the
+    // imported values. Only the ranks sharing cells with this process are
+    // contacted.
+    void exchangeValues( const std::vector<double> &export_values,
+                         std::vector<double> &import_values ) const;
+
+    // Communicator.
+    Teuchos::RCP<const Teuchos::Comm<int>> _comm;
+
+    // Communicator of the processes owning the same block in every set. The
+    // process of the first set has rank 0.
+    Teuchos::RCP<const Teuchos::Comm<int>> _replica_comm;
+
+    // Replication mode.
+    ReplicationMode _mode;
+
+    // Whether this process computes the values of its target cells.
+    bool _computes_values;
+
+    // Number of local target cells.
+    int _num_target_cells;
+
+    // Offsets of the entries of each target cell.
+    std::vector<int> _target_offsets;
+
+    // Weight of each entry.
+    std::vector<double> _weights;
+
+    // Position of the value of each entry in the imported values.
+    std::vector<int> _entry_imports;
+
+    // Ranks the values are imported from and offsets of their values in the
+    // imported values.
+    std::vector<int> _import_ranks;
+    std::vector<int> _import_offsets;
+
+    // Local source cells exported to other ranks.
+    std::vector<int> _export_cells;
+
+    // Ranks the values are exported to and offsets of their cells in the
+    // exported cells.
+    std::vector<int> _export_ranks;
+    std::vector<int> _export_offsets;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Benchmark
+} // end namespace DataTransferKit
+
+#endif // end DTK_CELLTRANSFER_HPP
@@ -0,0 +1,149 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file DTK_Benchmark_ConservativeRemap.cpp
+ * \brief Conservative remap of cell-centered data between the Cartesian
+ * meshes of the hybrid transport benchmark.
+ */
+//---------------------------------------------------------------------------//
+
+#include "DTK_Benchmark_ConservativeRemap.hpp"
+#include "DTK_DBC.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace DataTransferKit
+{
+namespace Benchmark
+{
+//---------------------------------------------------------------------------//
+// Constructor.
+ConservativeRemap::ConservativeRemap( const CartesianMesh &source_mesh,
+                                      const CartesianMesh &target_mesh,
+                                      const ReplicationMode mode )
+    : CellTransfer( target_mesh, mode )
+{
+    // The locator gives access to the global source edges and to the owners
+    // of the source cells. Its construction is collective.
+    auto source_locator = source_mesh.createGridLocator();
+
+    int num_target_cells = target_mesh.localCellGlobalIds().extent( 0 );
+    std::vector<int> offsets( num_target_cells + 1, 0 );
+    std::vector<int> ranks;
+    std::vector<int> cells;
+    std::vector<double> weights;
+
+    // Processes which receive their values through the broadcast only
+    // participate in the communication.
+    if ( computesValues() )
+    {
+        // Compute the 1D overlaps in each dimension.
+        std::array<int, 3> num_cells;
+        std::array<std::vector<int>, 3> overlap_offsets;
+        std::array<std::vector<int>, 3> overlap_cells;
+        std::array<std::vector<double>, 3> overlap_lengths;
+        for ( int d = 0; d < 3; ++d )
+        {
+            num_cells[d] = target_mesh.localEdges( d ).size() - 1;
+            computeOverlaps( target_mesh.localEdges( d ),
+                             source_locator.globalEdges( d ),
+                             overlap_offsets[d], overlap_cells[d],
+                             overlap_lengths[d] );
+        }
+        DTK_CHECK( num_cells[0] * num_cells[1] * num_cells[2] ==
+                   num_target_cells );
+
+        // The overlaps of a target cell are the tensor product of its 1D
+        // overlaps. Loop over the target cells in the local cell order.
+        auto const &x_edges = target_mesh.localEdges( 0 );
+        auto const &y_edges = target_mesh.localEdges( 1 );
+        auto const &z_edges = target_mesh.localEdges( 2 );
+        int t = 0;
+        for ( int k = 0; k < num_cells[2]; ++k )
+            for ( int j = 0; j < num_cells[1]; ++j )
+                for ( int i = 0; i < num_cells[0]; ++i, ++t )
+                {
+                    double volume = ( x_edges[i + 1] - x_edges[i] ) *
+                                    ( y_edges[j + 1] - y_edges[j] ) *
+                                    ( z_edges[k + 1] - z_edges[k] );
+                    for ( int c = overlap_offsets[2][k];
+                          c < overlap_offsets[2][k + 1]; ++c )
+                        for ( int b = overlap_offsets[1][j];
+                              b < overlap_offsets[1][j + 1]; ++b )
+                            for ( int a = overlap_offsets[0][i];
+                                  a < overlap_offsets[0][i + 1]; ++a )
+                            {
+                                std::array<int, 3> ijk_cell = {
+                                    overlap_cells[0][a], overlap_cells[1][b],
+                                    overlap_cells[2][c]};
+                                int rank;
+                                LocalOrdinal cell;
+                                source_locator.cellOwner( ijk_cell, rank,
+                                                          cell );
+                                if ( rank < 0 )
+                                    continue;
+                                ranks.push_back( rank );
+                                cells.push_back( cell );
+                                weights.push_back( overlap_lengths[0][a] *
+                                                   overlap_lengths[1][b] *
+                                                   overlap_lengths[2][c] /
+                                                   volume );
+                            }
+                    offsets[t + 1] = ranks.size();
+                }
+    }
+
+    buildPlan( offsets, ranks, cells, weights );
+}
+
+//---------------------------------------------------------------------------//
+// Compute the overlaps of the target intervals with the source intervals in
+// one dimension.
+void ConservativeRemap::computeOverlaps(
+    const std::vector<double> &target_edges,
+    const std::vector<double> &source_edges, std::vector<int> &offsets,
+    std::vector<int> &source_cells, std::vector<double> &lengths ) const
+{
+    int num_target_cells = target_edges.size() - 1;
+    int num_source_cells = source_edges.size() - 1;
+    offsets.assign( num_target_cells + 1, 0 );
+    source_cells.clear();
+    lengths.clear();
+    for ( int t = 0; t < num_target_cells; ++t )
+    {
+        double lo = target_edges[t];
+        double hi = target_edges[t + 1];
+
+        // Start from the source cell containing the lower edge of the target
+        // cell (or the first source cell) and walk up to the upper edge.
+        auto upper =
+            std::upper_bound( source_edges.begin(), source_edges.end(), lo );
+        int first = std::distance( source_edges.begin(), upper ) - 1;
+        for ( int s = std::max( first, 0 );
+              s < num_source_cells && source_edges[s] < hi; ++s )
+        {
+            double length = std::min( hi, source_edges[s + 1] ) -
+                            std::max( lo, source_edges[s] );
+            if ( length > 0. )
+            {
+                source_cells.push_back( s );
+                lengths.push_back( length );
+            }
+        }
+        offsets[t + 1] = source_cells.size();
+    }
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Benchmark
+} // end namespace DataTransferKit
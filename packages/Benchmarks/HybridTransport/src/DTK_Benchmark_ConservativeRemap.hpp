@@ -0,0 +1,89 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file DTK_Benchmark_ConservativeRemap.hpp
+ * \brief Conservative remap of cell-centered data between the Cartesian
+ * meshes of the hybrid transport benchmark.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef DTK_CONSERVATIVEREMAP_HPP
+#define DTK_CONSERVATIVEREMAP_HPP
+
+#include "DTK_Benchmark_CartesianMesh.hpp"
+#include "DTK_Benchmark_CellTransfer.hpp"
+
+#include <vector>
+
+namespace DataTransferKit
+{
+namespace Benchmark
+{
+//---------------------------------------------------------------------------//
+/*!
+ * \class ConservativeRemap
+ * \brief Volume-weighted conservative remap of cell-centered data between
+ * two Cartesian meshes.
+ *
+ * The value of a target cell is the volume average of the source values over
+ * the cell:
+ *
+ * \f[
+ *   u_t = \frac{1}{|T|} \sum_s |T \cap S| u_s
+ * \f]
+ *
+ * The cells of rectilinear grids are tensor products of intervals so the
+ * overlap volumes are products of 1D interval overlaps. These are computed
+ * once per dimension for the local target edges and no geometric search is
+ * needed. The integral of the field over the parts of the domain covered by
+ * both meshes is conserved. Target cells only partially covered by the
+ * source mesh are averaged with a zero value outside of the source mesh.
+ *
+ * The communication and the replication over sets are handled as in
+ * CellTransfer.
+ */
+class ConservativeRemap : public CellTransfer
+{
+  public:
+    /*!
+     * \brief Constructor. This is a collective operation over the
+     * communicator of the meshes.
+     *
+     * \param source_mesh The local source Cartesian mesh. Its cells must be
+     * uniquely owned within a set.
+     *
+     * \param target_mesh The local target Cartesian mesh.
+     *
+     * \param mode The replication mode used when the target mesh has several
+     * sets.
+     */
+    ConservativeRemap( const CartesianMesh &source_mesh,
+                       const CartesianMesh &target_mesh,
+                       const ReplicationMode mode = FirstSetBroadcast );
+
+  private:
+    // Compute the overlaps of the target intervals with the source intervals
+    // in one dimension. The source cells overlapping target cell t are
+    // source_cells[offsets[t]] to source_cells[offsets[t+1]-1] and their
+    // overlaps are lengths[offsets[t]] to lengths[offsets[t+1]-1].
+    void computeOverlaps( const std::vector<double> &target_edges,
+                          const std::vector<double> &source_edges,
+                          std::vector<int> &offsets,
+                          std::vector<int> &source_cells,
+                          std::vector<double> &lengths ) const;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Benchmark
+} // end namespace DataTransferKit
+
+#endif // end DTK_CONSERVATIVEREMAP_HPP
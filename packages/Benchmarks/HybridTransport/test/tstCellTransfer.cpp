@@ -0,0 +1,111 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_Benchmark_CellTransfer.hpp"
+#include "DTK_Benchmark_DeterministicMesh.hpp"
+#include "DTK_Benchmark_MonteCarloMesh.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <cmath>
+#include <vector>
+
+//---------------------------------------------------------------------------//
+// Transfer the source cell ids from a deterministic mesh to a replicated
+// Monte Carlo mesh.
+void transferTest(
+    const DataTransferKit::Benchmark::CellTransfer::ReplicationMode mode,
+    bool &success, Teuchos::FancyOStream &out )
+{
+    // Get the communicator.
+    auto comm = Teuchos::DefaultComm<int>::getComm();
+    int comm_size = comm->getSize();
+
+    // Build the source mesh.
+    int x_source_num_cell = 12;
+    int y_source_num_cell = 9;
+    int z_source_num_cell = 6;
+    double dx = 0.4;
+    double dy = 0.5;
+    double dz = 0.3;
+    DataTransferKit::Benchmark::DeterministicMesh source_mesh(
+        comm, x_source_num_cell, y_source_num_cell, z_source_num_cell, dx, dy,
+        dz );
+
+    // Build the target mesh with cells 1.5 times larger than the source
+    // cells so that no target cell center lies on a source cell face. Use 2
+    // sets if we can and partition the set in X.
+    int num_sets = ( 0 == comm_size % 2 ) ? 2 : 1;
+    int num_blocks = comm_size / num_sets;
+    double x_max = x_source_num_cell * dx;
+    std::vector<double> x_bnd_mesh( num_blocks + 1 );
+    for ( int n = 0; n < num_blocks + 1; ++n )
+        x_bnd_mesh[n] = x_max * n / ( num_blocks + 0.07 );
+    x_bnd_mesh.front() = -0.1;
+    x_bnd_mesh.back() = x_max + 0.1;
+    std::vector<double> y_bnd_mesh = {-0.1, y_source_num_cell * dy + 0.1};
+    std::vector<double> z_bnd_mesh = {-0.1, z_source_num_cell * dz + 0.1};
+    DataTransferKit::Benchmark::MonteCarloMesh target_mesh(
+        comm, num_sets, x_source_num_cell * 2 / 3, y_source_num_cell * 2 / 3,
+        z_source_num_cell * 2 / 3, 1.5 * dx, 1.5 * dy, 1.5 * dz, x_bnd_mesh,
+        y_bnd_mesh, z_bnd_mesh );
+
+    // Use the source cell ids as the source values.
+    auto source_ids = source_mesh.cartesianMesh()->localCellGlobalIds();
+    int source_num_cell = source_ids.extent( 0 );
+    Kokkos::View<double *> source_values( "source_values", source_num_cell );
+    for ( int c = 0; c < source_num_cell; ++c )
+        source_values( c ) = source_ids( c );
+
+    // Transfer.
+    DataTransferKit::Benchmark::CellTransfer transfer(
+        *( source_mesh.cartesianMesh() ), *( target_mesh.cartesianMesh() ),
+        mode );
+    auto target_centers =
+        target_mesh.cartesianMesh()->localCellCenterCoordinates();
+    int target_num_cell = target_centers.extent( 0 );
+    Kokkos::View<double *> target_values( "target_values", target_num_cell );
+    transfer.apply( source_values, target_values );
+
+    // Every target cell in every set gets the id of the source cell
+    // containing its center.
+    for ( int c = 0; c < target_num_cell; ++c )
+    {
+        int i = std::floor( target_centers( c, 0 ) / dx );
+        int j = std::floor( target_centers( c, 1 ) / dy );
+        int k = std::floor( target_centers( c, 2 ) / dz );
+        double expected_id = i + x_source_num_cell * j +
+                             x_source_num_cell * y_source_num_cell * k;
+        TEST_EQUALITY( target_values( c ), expected_id );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Search and fetch in every set.
+TEUCHOS_UNIT_TEST( CellTransfer, each_set )
+{
+    transferTest( DataTransferKit::Benchmark::CellTransfer::EachSet, success,
+                  out );
+}
+
+//---------------------------------------------------------------------------//
+// Search and fetch in the first set and broadcast to the other sets.
+TEUCHOS_UNIT_TEST( CellTransfer, first_set_broadcast )
+{
+    transferTest( DataTransferKit::Benchmark::CellTransfer::FirstSetBroadcast,
+                  success, out );
+}
+
+//---------------------------------------------------------------------------//
@@ -0,0 +1,177 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_Benchmark_ConservativeRemap.hpp"
+#include "DTK_Benchmark_DeterministicMesh.hpp"
+#include "DTK_Benchmark_MonteCarloMesh.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <cmath>
+#include <vector>
+
+//---------------------------------------------------------------------------//
+// Create the boundary mesh of a Monte Carlo mesh partitioned in X with
+// planes that intersect cells.
+void createBoundaryMesh( const int num_blocks, const double x_max,
+                         const double y_max, const double z_max,
+                         std::vector<double> &x_bnd_mesh,
+                         std::vector<double> &y_bnd_mesh,
+                         std::vector<double> &z_bnd_mesh )
+{
+    x_bnd_mesh.resize( num_blocks + 1 );
+    for ( int n = 0; n < num_blocks + 1; ++n )
+        x_bnd_mesh[n] = x_max * n / ( num_blocks + 0.07 );
+    x_bnd_mesh.front() = -0.1;
+    x_bnd_mesh.back() = x_max + 0.1;
+    y_bnd_mesh = {-0.1, y_max + 0.1};
+    z_bnd_mesh = {-0.1, z_max + 0.1};
+}
+
+//---------------------------------------------------------------------------//
+// Remap a constant from a deterministic mesh to a replicated Monte Carlo mesh
+// with different edges.
+TEUCHOS_UNIT_TEST( ConservativeRemap, constant )
+{
+    // Get the communicator.
+    auto comm = Teuchos::DefaultComm<int>::getComm();
+    int comm_size = comm->getSize();
+
+    // Build the source mesh.
+    DataTransferKit::Benchmark::DeterministicMesh source_mesh(
+        comm, 12, 9, 6, 0.4, 0.5, 0.3 );
+
+    // Build the target mesh over the same domain. Use 2 sets if we can.
+    int num_sets = ( 0 == comm_size % 2 ) ? 2 : 1;
+    std::vector<double> x_bnd_mesh;
+    std::vector<double> y_bnd_mesh;
+    std::vector<double> z_bnd_mesh;
+    createBoundaryMesh( comm_size / num_sets, 4.8, 4.5, 1.8, x_bnd_mesh,
+                        y_bnd_mesh, z_bnd_mesh );
+    DataTransferKit::Benchmark::MonteCarloMesh target_mesh(
+        comm, num_sets, 7, 10, 4, 4.8 / 7, 0.45, 0.45, x_bnd_mesh,
+        y_bnd_mesh, z_bnd_mesh );
+
+    // Remap.
+    int source_num_cell =
+        source_mesh.cartesianMesh()->localCellGlobalIds().extent( 0 );
+    Kokkos::View<double *> source_values( "source_values", source_num_cell );
+    Kokkos::deep_copy( source_values, 3.0 );
+    DataTransferKit::Benchmark::ConservativeRemap remap(
+        *( source_mesh.cartesianMesh() ), *( target_mesh.cartesianMesh() ) );
+    int target_num_cell =
+        target_mesh.cartesianMesh()->localCellGlobalIds().extent( 0 );
+    Kokkos::View<double *> target_values( "target_values", target_num_cell );
+    remap.apply( source_values, target_values );
+
+    // The constant is reproduced in every set.
+    for ( int c = 0; c < target_num_cell; ++c )
+        TEST_FLOATING_EQUALITY( target_values( c ), 3.0, 1.0e-12 );
+}
+
+//---------------------------------------------------------------------------//
+// Remap from a Monte Carlo mesh to a deterministic mesh with graded edges and
+// check that the integral is conserved.
+TEUCHOS_UNIT_TEST( ConservativeRemap, conservation )
+{
+    // Get the communicator.
+    auto comm = Teuchos::DefaultComm<int>::getComm();
+    int comm_size = comm->getSize();
+
+    // Build the source mesh. Use 2 sets if we can.
+    int num_sets = ( 0 == comm_size % 2 ) ? 2 : 1;
+    int x_source_num_cell = 10;
+    int y_source_num_cell = 8;
+    int z_source_num_cell = 6;
+    double dx = 0.6;
+    double dy = 0.5;
+    double dz = 0.4;
+    double x_max = x_source_num_cell * dx;
+    double y_max = y_source_num_cell * dy;
+    double z_max = z_source_num_cell * dz;
+    std::vector<double> x_bnd_mesh;
+    std::vector<double> y_bnd_mesh;
+    std::vector<double> z_bnd_mesh;
+    createBoundaryMesh( comm_size / num_sets, x_max, y_max, z_max, x_bnd_mesh,
+                        y_bnd_mesh, z_bnd_mesh );
+    DataTransferKit::Benchmark::MonteCarloMesh source_mesh(
+        comm, num_sets, x_source_num_cell, y_source_num_cell,
+        z_source_num_cell, dx, dy, dz, x_bnd_mesh, y_bnd_mesh, z_bnd_mesh );
+
+    // Build the target mesh over the same domain with graded edges.
+    int x_target_num_cell = 13;
+    int y_target_num_cell = 7;
+    int z_target_num_cell = 5;
+    std::vector<double> global_x_edges( x_target_num_cell + 1 );
+    for ( int n = 0; n < x_target_num_cell + 1; ++n )
+        global_x_edges[n] = x_max * std::pow( 1.0 * n / x_target_num_cell, 2 );
+    std::vector<double> global_y_edges( y_target_num_cell + 1 );
+    for ( int n = 0; n < y_target_num_cell + 1; ++n )
+        global_y_edges[n] =
+            y_max * std::pow( 1.0 * n / y_target_num_cell, 1.5 );
+    std::vector<double> global_z_edges( z_target_num_cell + 1 );
+    for ( int n = 0; n < z_target_num_cell + 1; ++n )
+        global_z_edges[n] = z_max * n / z_target_num_cell;
+    global_x_edges.back() = x_max;
+    global_y_edges.back() = y_max;
+    global_z_edges.back() = z_max;
+    DataTransferKit::Benchmark::DeterministicMesh target_mesh(
+        comm, global_x_edges, global_y_edges, global_z_edges );
+
+    // Use a function of the global source cell ids as the source values.
+    auto source_ids = source_mesh.cartesianMesh()->localCellGlobalIds();
+    int source_num_cell = source_ids.extent( 0 );
+    Kokkos::View<double *> source_values( "source_values", source_num_cell );
+    for ( int c = 0; c < source_num_cell; ++c )
+        source_values( c ) = 1.0 + source_ids( c ) % 17;
+
+    // Remap.
+    DataTransferKit::Benchmark::ConservativeRemap remap(
+        *( source_mesh.cartesianMesh() ), *( target_mesh.cartesianMesh() ) );
+    auto target_mesh_ptr = target_mesh.cartesianMesh();
+    int target_num_cell = target_mesh_ptr->localCellGlobalIds().extent( 0 );
+    Kokkos::View<double *> target_values( "target_values", target_num_cell );
+    remap.apply( source_values, target_values );
+
+    // Compute the integral over the target mesh. Its cells are uniquely
+    // owned.
+    double local_integral = 0.;
+    auto const &x_edges = target_mesh_ptr->localEdges( 0 );
+    auto const &y_edges = target_mesh_ptr->localEdges( 1 );
+    auto const &z_edges = target_mesh_ptr->localEdges( 2 );
+    int t = 0;
+    for ( unsigned int k = 0; k < z_edges.size() - 1; ++k )
+        for ( unsigned int j = 0; j < y_edges.size() - 1; ++j )
+            for ( unsigned int i = 0; i < x_edges.size() - 1; ++i, ++t )
+                local_integral += target_values( t ) *
+                                  ( x_edges[i + 1] - x_edges[i] ) *
+                                  ( y_edges[j + 1] - y_edges[j] ) *
+                                  ( z_edges[k + 1] - z_edges[k] );
+    double target_integral = 0.;
+    Teuchos::reduceAll( *comm, Teuchos::REDUCE_SUM, local_integral,
+                        Teuchos::ptrFromRef( target_integral ) );
+
+    // Compute the integral over the source mesh from the global cell ids.
+    double source_integral = 0.;
+    int source_global_num_cell =
+        x_source_num_cell * y_source_num_cell * z_source_num_cell;
+    for ( int c = 0; c < source_global_num_cell; ++c )
+        source_integral += ( 1.0 + c % 17 ) * dx * dy * dz;
+
+    TEST_FLOATING_EQUALITY( target_integral, source_integral, 1.0e-12 );
+}
+
+//---------------------------------------------------------------------------//
@@ -0,0 +1,170 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_Benchmark_DeterministicMesh.hpp"
+#include "DTK_Benchmark_MonteCarloMesh.hpp"
+#include "DTK_RectilinearGridLocator.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_RCP.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <cmath>
+#include <vector>
+
+//---------------------------------------------------------------------------//
+// Locate the local cell centers of a mesh and check the results.
+void checkCellCenters(
+    const DataTransferKit::Benchmark::CartesianMesh &mesh,
+    const DataTransferKit::RectilinearGridLocator &locator,
+    bool &success, Teuchos::FancyOStream &out )
+{
+    // Get the communicator.
+    auto comm = mesh.comm();
+    int comm_rank = comm->getRank();
+    int set_first_rank = mesh.setId() * mesh.numBlocks();
+
+    // Locate the cell centers.
+    auto centers = mesh.localCellCenterCoordinates();
+    Kokkos::View<int *> ranks;
+    Kokkos::View<DataTransferKit::GlobalOrdinal *> cell_ids;
+    Kokkos::View<DataTransferKit::LocalOrdinal *> local_cell_ids;
+    locator.locate( centers, ranks, cell_ids, local_cell_ids );
+
+    // Every center must be found in the cell it is the center of. The owning
+    // rank is in the set of this process and is this process unless the
+    // cell is ghosted.
+    auto global_ids = mesh.localCellGlobalIds();
+    int local_num_cell = global_ids.extent( 0 );
+    for ( int c = 0; c < local_num_cell; ++c )
+    {
+        TEST_EQUALITY( cell_ids( c ), global_ids( c ) );
+        TEST_ASSERT( set_first_rank <= ranks( c ) );
+        TEST_ASSERT( ranks( c ) < set_first_rank + mesh.numBlocks() );
+        if ( ranks( c ) == comm_rank )
+            TEST_EQUALITY( local_cell_ids( c ), c );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Locate points in a deterministic mesh with non-uniform edges.
+TEUCHOS_UNIT_TEST( RectilinearGridLocator, deterministic_mesh )
+{
+    // Get the communicator.
+    auto comm = Teuchos::DefaultComm<int>::getComm();
+    int comm_rank = comm->getRank();
+
+    // Create geometrically graded edges in X and Y and uniform edges in Z.
+    int x_global_num_cell = 20;
+    int y_global_num_cell = 18;
+    int z_global_num_cell = 7;
+    std::vector<double> global_x_edges( x_global_num_cell + 1 );
+    for ( int n = 0; n < x_global_num_cell + 1; ++n )
+        global_x_edges[n] = std::pow( 1.1, n ) - 1.0;
+    std::vector<double> global_y_edges( y_global_num_cell + 1 );
+    for ( int n = 0; n < y_global_num_cell + 1; ++n )
+        global_y_edges[n] = 0.1 * n * n;
+    std::vector<double> global_z_edges( z_global_num_cell + 1 );
+    for ( int n = 0; n < z_global_num_cell + 1; ++n )
+        global_z_edges[n] = -1.0 + 0.3 * n;
+
+    // Build a deterministic mesh.
+    DataTransferKit::Benchmark::DeterministicMesh mesh(
+        comm, global_x_edges, global_y_edges, global_z_edges );
+
+    // Build the locator.
+    auto locator = mesh.cartesianMesh()->createGridLocator();
+    TEST_ASSERT( !locator.isUniform( 0 ) );
+    TEST_ASSERT( !locator.isUniform( 1 ) );
+    TEST_ASSERT( locator.isUniform( 2 ) );
+    TEST_COMPARE_ARRAYS( locator.globalEdges( 0 ), global_x_edges );
+    TEST_COMPARE_ARRAYS( locator.globalEdges( 1 ), global_y_edges );
+    TEST_COMPARE_ARRAYS( locator.globalEdges( 2 ), global_z_edges );
+
+    // Deterministic meshes do not have ghosted cells so every cell center is
+    // owned by this process.
+    checkCellCenters( *( mesh.cartesianMesh() ), locator, success, out );
+    auto centers = mesh.cartesianMesh()->localCellCenterCoordinates();
+    Kokkos::View<int *> ranks;
+    Kokkos::View<DataTransferKit::GlobalOrdinal *> cell_ids;
+    Kokkos::View<DataTransferKit::LocalOrdinal *> local_cell_ids;
+    locator.locate( centers, ranks, cell_ids, local_cell_ids );
+    for ( unsigned int c = 0; c < centers.extent( 0 ); ++c )
+        TEST_EQUALITY( ranks( c ), comm_rank );
+
+    // Points outside of the grid and on its corners.
+    Kokkos::View<DataTransferKit::Coordinate **> points( "points", 3, 3 );
+    points( 0, 0 ) = -0.5;
+    points( 0, 1 ) = 1.0;
+    points( 0, 2 ) = 0.0;
+    points( 1, 0 ) = global_x_edges.front();
+    points( 1, 1 ) = global_y_edges.front();
+    points( 1, 2 ) = global_z_edges.front();
+    points( 2, 0 ) = global_x_edges.back();
+    points( 2, 1 ) = global_y_edges.back();
+    points( 2, 2 ) = global_z_edges.back();
+    locator.locate( points, ranks, cell_ids, local_cell_ids );
+    TEST_EQUALITY( ranks( 0 ), -1 );
+    TEST_EQUALITY( cell_ids( 0 ), -1 );
+    TEST_EQUALITY( local_cell_ids( 0 ), -1 );
+    TEST_EQUALITY( ranks( 1 ), 0 );
+    TEST_EQUALITY( cell_ids( 1 ), 0 );
+    TEST_EQUALITY( local_cell_ids( 1 ), 0 );
+    TEST_EQUALITY( ranks( 2 ), comm->getSize() - 1 );
+    int global_num_cell =
+        x_global_num_cell * y_global_num_cell * z_global_num_cell;
+    TEST_EQUALITY( cell_ids( 2 ), global_num_cell - 1 );
+}
+
+//---------------------------------------------------------------------------//
+// Locate points in a replicated Monte Carlo mesh with overlapping blocks.
+TEUCHOS_UNIT_TEST( RectilinearGridLocator, monte_carlo_mesh )
+{
+    // Get the communicator.
+    auto comm = Teuchos::DefaultComm<int>::getComm();
+    int comm_size = comm->getSize();
+
+    // Use 2 sets if we can and partition the set in X with planes that
+    // intersect cells.
+    int num_sets = ( 0 == comm_size % 2 ) ? 2 : 1;
+    int num_blocks = comm_size / num_sets;
+    int x_global_num_cell = 24;
+    int y_global_num_cell = 16;
+    int z_global_num_cell = 20;
+    double dx = 0.4;
+    double dy = 0.5;
+    double dz = 0.3;
+    double x_max = x_global_num_cell * dx;
+    std::vector<double> x_bnd_mesh( num_blocks + 1 );
+    for ( int n = 0; n < num_blocks + 1; ++n )
+        x_bnd_mesh[n] = x_max * n / ( num_blocks + 0.07 );
+    x_bnd_mesh.front() = -0.1;
+    x_bnd_mesh.back() = x_max + 0.1;
+    std::vector<double> y_bnd_mesh = {-0.1, y_global_num_cell * dy + 0.1};
+    std::vector<double> z_bnd_mesh = {-0.1, z_global_num_cell * dz + 0.1};
+
+    // Build a Monte Carlo mesh.
+    DataTransferKit::Benchmark::MonteCarloMesh mesh(
+        comm, num_sets, x_global_num_cell, y_global_num_cell,
+        z_global_num_cell, dx, dy, dz, x_bnd_mesh, y_bnd_mesh, z_bnd_mesh );
+
+    // Build the locator and check the results.
+    auto locator = mesh.cartesianMesh()->createGridLocator();
+    for ( int d = 0; d < 3; ++d )
+        TEST_ASSERT( locator.isUniform( d ) );
+    TEST_EQUALITY( locator.globalEdges( 0 ).size(),
+                   static_cast<std::size_t>( x_global_num_cell + 1 ) );
+    checkCellCenters( *( mesh.cartesianMesh() ), locator, success, out );
+}
+
+//---------------------------------------------------------------------------//
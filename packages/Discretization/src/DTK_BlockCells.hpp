@@ -0,0 +1,77 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_BLOCK_CELLS_HPP
+#define DTK_BLOCK_CELLS_HPP
+
+#include <DTK_Types.h>
+
+#include <Kokkos_Macros.hpp>
+#include <Kokkos_View.hpp>
+
+#include <cstddef>
+
+namespace DataTransferKit
+{
+/**
+ * Access to the nodes of the cells of a given topology. The accessor behaves
+ * like a (n cells, n nodes per cell, dim) View but the coordinates are read
+ * through the connectivity of the Mesh. Therefore, the coordinates of the
+ * nodes shared by several cells are not duplicated.
+ */
+template <typename DeviceType>
+struct BlockCells
+{
+    BlockCells() = default;
+
+    BlockCells( Kokkos::View<unsigned int *, DeviceType> cells_,
+                Kokkos::View<unsigned int *, DeviceType> node_offsets_,
+                unsigned int const n_nodes_,
+                Kokkos::View<Coordinate **, DeviceType> nodes_coordinates_ )
+        : cells( cells_ )
+        , node_offsets( node_offsets_ )
+        , n_nodes( n_nodes_ )
+        , nodes_coordinates( nodes_coordinates_ )
+    {
+    }
+
+    /**
+     * Return the coordinate \p d of the node \p node of the cell \p cell.
+     */
+    KOKKOS_INLINE_FUNCTION
+    Coordinate operator()( int const cell, int const node, int const d ) const
+    {
+        return nodes_coordinates( cells( node_offsets( cell ) + node ), d );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    std::size_t extent( unsigned int const r ) const
+    {
+        if ( r == 0 )
+            return node_offsets.extent( 0 );
+        if ( r == 1 )
+            return n_nodes;
+        return nodes_coordinates.extent( 1 );
+    }
+
+    /// Cells vertices associated to each cell of the Mesh (see Mesh::cells)
+    Kokkos::View<unsigned int *, DeviceType> cells;
+    /// Position in cells of the first node of each cell of the block (n cells
+    /// in the block)
+    Kokkos::View<unsigned int *, DeviceType> node_offsets;
+    /// Number of nodes per cell
+    unsigned int n_nodes = 0;
+    /// Coordinates of all the nodes in the Mesh (n vertices, dim)
+    Kokkos::View<Coordinate **, DeviceType> nodes_coordinates;
+};
+} // namespace DataTransferKit
+
+#endif
@@ -12,6 +12,8 @@
 #ifndef DTK_DISCRETIZATION_HELPERS
 #define DTK_DISCRETIZATION_HELPERS
 
+#include <DTK_BlockCells.hpp>
+#include <DTK_Mesh.hpp>
 #include <DTK_Topology.hpp>
 
 #include <Kokkos_Macros.hpp>
@@ -74,6 +76,24 @@ std::array<unsigned int, DTK_N_TOPO> computeNCellsPerTopology(
     return n_cells_per_topo;
 }
 
+/**
+ * Return the indices of all the cells of the mesh.
+ */
+template <typename DeviceType>
+Kokkos::View<LocalOrdinal *, DeviceType> getAllCells(
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies )
+{
+    unsigned int const n_cells = cell_topologies.extent( 0 );
+    Kokkos::View<LocalOrdinal *, DeviceType> cells( "all_cells", n_cells );
+    using ExecutionSpace = typename DeviceType::execution_space;
+    Kokkos::parallel_for( DTK_MARK_REGION( "fill_all_cells" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
+                          KOKKOS_LAMBDA( int const i ) { cells( i ) = i; } );
+    Kokkos::fence();
+
+    return cells;
+}
+
 template <typename DeviceType>
 void checkOffsetOverflow( Kokkos::View<unsigned int *, DeviceType> offset )
 {
@@ -170,16 +190,20 @@ struct MeshOffsets
 
         unsigned int const n_cells = mesh.cell_topologies.extent( 0 );
 
+        // The node offsets do not depend on the topology so they are computed
+        // once and shared.
+        Kokkos::View<unsigned int *, DeviceType> node_offset( "node_offset",
+                                                              n_cells );
+        computeNodeOffset( mesh.cell_topologies, n_nodes_per_topo,
+                           node_offset );
+
         for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
         {
             offsets[topo_id] = Kokkos::View<unsigned int *, DeviceType>(
                 "offset_" + std::to_string( topo_id ), n_cells );
             computeOffset( mesh.cell_topologies, topo_id, offsets[topo_id] );
 
-            node_offsets[topo_id] = Kokkos::View<unsigned int *, DeviceType>(
-                "node_offset", n_cells );
-            computeNodeOffset( mesh.cell_topologies, n_nodes_per_topo,
-                               node_offsets[topo_id] );
+            node_offsets[topo_id] = node_offset;
         }
     }
 
@@ -189,65 +213,48 @@ struct MeshOffsets
     Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> n_nodes_per_topo;
 };
 
-template <typename DeviceType>
-KOKKOS_FUNCTION void
-buildBlockCells( unsigned int const dim, int const i,
-                 unsigned int const n_nodes, unsigned int const node_offset,
-                 Kokkos::View<unsigned int *, DeviceType> cells,
-                 Kokkos::View<unsigned int *, DeviceType> offset,
-                 Kokkos::View<Coordinate **, DeviceType> coordinates,
-                 Kokkos::View<Coordinate ***, DeviceType> block_cells )
-{
-    unsigned int const k = offset( i );
-    for ( unsigned int node = 0; node < n_nodes; ++node )
-    {
-        unsigned int const n = node_offset + node;
-        for ( unsigned int d = 0; d < dim; ++d )
-        {
-            // Copy the coordinated in block_cells
-            block_cells( k, node, d ) = coordinates( cells( n ), d );
-        }
-    }
-}
-
 /**
- * Convert the 1D Kokkos View cells and coordinates to arrays of 3D Kokkos
- * Views more suitable for Intrepid2.
+ * Build, for each topology, the accessor to the nodes of the cells through the
+ * connectivity of the mesh. Only the position of the first node of each cell
+ * is stored, the coordinates of the nodes are not copied.
  */
 template <typename DeviceType>
-void convertMesh( Mesh<DeviceType> const &mesh,
-                  MeshOffsets<DeviceType> const &mesh_offsets,
-                  std::array<Kokkos::View<Coordinate ***, DeviceType>,
-                             DTK_N_TOPO> &block_cells )
+std::array<BlockCells<DeviceType>, DTK_N_TOPO>
+buildBlockCells( Mesh<DeviceType> const &mesh,
+                 MeshOffsets<DeviceType> const &mesh_offsets,
+                 std::array<unsigned int, DTK_N_TOPO> const &n_cells_per_topo )
 {
     using ExecutionSpace = typename DeviceType::execution_space;
+    Topologies topologies;
+    std::array<BlockCells<DeviceType>, DTK_N_TOPO> block_cells;
     for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
     {
         DTK_REQUIRE( mesh_offsets.offsets[topo_id].extent( 0 ) ==
                      mesh.cell_topologies.extent( 0 ) );
-        DTK_REQUIRE( block_cells[topo_id].extent( 2 ) ==
-                     mesh.nodes_coordinates.extent( 1 ) );
 
-        unsigned int const dim = mesh.nodes_coordinates.extent( 1 );
+        Kokkos::View<unsigned int *, DeviceType> block_node_offsets(
+            "block_node_offsets_" + std::to_string( topo_id ),
+            n_cells_per_topo[topo_id] );
         unsigned int const n_cells = mesh.cell_topologies.extent( 0 );
-        auto block_cells_topo = block_cells[topo_id];
         auto node_offset = mesh_offsets.node_offsets[topo_id];
         auto offset = mesh_offsets.offsets[topo_id];
+        auto cell_topologies = mesh.cell_topologies;
 
         Kokkos::parallel_for(
             DTK_MARK_REGION( "build_block_cells_" + std::to_string( topo_id ) ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
             KOKKOS_LAMBDA( int const i ) {
-                if ( mesh.cell_topologies( i ) == topo_id )
-                {
-                    buildBlockCells( dim, i,
-                                     mesh_offsets.n_nodes_per_topo( topo_id ),
-                                     node_offset( i ), mesh.cells, offset,
-                                     mesh.nodes_coordinates, block_cells_topo );
-                }
+                if ( cell_topologies( i ) == topo_id )
+                    block_node_offsets( offset( i ) ) = node_offset( i );
             } );
         Kokkos::fence();
+
+        block_cells[topo_id] = BlockCells<DeviceType>(
+            mesh.cells, block_node_offsets, topologies[topo_id].n_nodes,
+            mesh.nodes_coordinates );
     }
+
+    return block_cells;
 }
 
 template <typename DeviceType>
@@ -255,9 +262,7 @@ KOKKOS_FUNCTION void
 buildBoundingBoxes( unsigned int const dim, int const i,
                     unsigned int const n_nodes, unsigned int const node_offset,
                     Kokkos::View<unsigned int *, DeviceType> cells,
-                    unsigned int const offset,
                     Kokkos::View<Coordinate **, DeviceType> coordinates,
-                    Kokkos::View<Coordinate ***, DeviceType> block_cells,
                     Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes )
 {
     ArborX::Box bounding_box;
@@ -270,16 +275,15 @@ buildBoundingBoxes( unsigned int const dim, int const i,
     }
     for ( unsigned int node = 0; node < n_nodes; ++node )
     {
-        unsigned int const n = node_offset + node;
+        unsigned int const n = cells( node_offset + node );
         for ( unsigned int d = 0; d < dim; ++d )
         {
-            // Copy the coordinated in block_cells
-            block_cells( offset, node, d ) = coordinates( cells( n ), d );
             // Build the bounding box.
-            if ( block_cells( offset, node, d ) < bounding_box.minCorner()[d] )
-                bounding_box.minCorner()[d] = block_cells( offset, node, d );
-            if ( block_cells( offset, node, d ) > bounding_box.maxCorner()[d] )
-                bounding_box.maxCorner()[d] = block_cells( offset, node, d );
+            Coordinate const x = coordinates( n, d );
+            if ( x < bounding_box.minCorner()[d] )
+                bounding_box.minCorner()[d] = x;
+            if ( x > bounding_box.maxCorner()[d] )
+                bounding_box.maxCorner()[d] = x;
         }
     }
     bounding_boxes( i ) = bounding_box;
@@ -292,8 +296,6 @@ buildBoundingBoxes( unsigned int const dim, int const i,
 template <typename DeviceType>
 void createBoundingBoxes(
     Mesh<DeviceType> const &mesh, MeshOffsets<DeviceType> const &mesh_offsets,
-    std::array<Kokkos::View<Coordinate ***, DeviceType>, DTK_N_TOPO> const
-        &block_cells,
     Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes,
     Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell )
 {
@@ -311,7 +313,6 @@ void createBoundingBoxes(
         unsigned int const dim = mesh.nodes_coordinates.extent( 1 );
         unsigned int const n_cells = mesh.cell_topologies.extent( 0 );
         auto node_offset = mesh_offsets.node_offsets[topo_id];
-        auto block_cells_topo = block_cells[topo_id];
         auto offset = mesh_offsets.offsets[topo_id];
 
         Kokkos::parallel_for(
@@ -323,8 +324,7 @@ void createBoundingBoxes(
                 {
                     buildBoundingBoxes(
                         dim, i, mesh_offsets.n_nodes_per_topo( topo_id ),
-                        node_offset( i ), mesh.cells, offset( i ),
-                        mesh.nodes_coordinates, block_cells_topo,
+                        node_offset( i ), mesh.cells, mesh.nodes_coordinates,
                         bounding_boxes );
                 }
             } );
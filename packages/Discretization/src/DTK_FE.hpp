@@ -59,6 +59,25 @@ enum class FE {
     DUMMY
 };
 
+/**
+ * Quadratic Lagrange polynomials on [-1, 1]. The nodes are ordered as in the
+ * Intrepid2 C2 bases: first the vertices -1 and 1, then the midpoint 0. The
+ * basis functions of HEX_HGRAD_2 and QUAD_HGRAD_2 are tensor products of
+ * these polynomials.
+ */
+struct LagrangeQuadratic1D
+{
+    static constexpr unsigned int n_nodes = 3;
+
+    KOKKOS_INLINE_FUNCTION
+    static void getValues( double const x, double values[n_nodes] )
+    {
+        values[0] = 0.5 * x * ( x - 1. );
+        values[1] = 0.5 * x * ( x + 1. );
+        values[2] = ( 1. - x ) * ( 1. + x );
+    }
+};
+
 struct HEX_HCURL_1
 {
     typedef Intrepid2::Impl::Basis_HCURL_HEX_I1_FEM::Serial<
@@ -97,6 +116,28 @@ struct HEX_HGRAD_2
 
     template <typename T1, typename T2, typename T3>
     using basis_type = Intrepid2::Basis_HGRAD_HEX_C2_FEM<T1, T2, T3>;
+
+    // Data used by the sum-factorized evaluation (see
+    // Functor::SumFactorizedHgradInterpolation).
+    static constexpr unsigned int dim = 3;
+    static constexpr unsigned int n_basis = 27;
+    typedef LagrangeQuadratic1D basis_1d_type;
+
+    /**
+     * Return the position of the j-th Intrepid2 basis function in the
+     * tensor-product ordering a + 3 * b + 9 * c where a, b, and c are the
+     * indices of the 1D polynomials in the x, y, and z directions.
+     */
+    KOKKOS_INLINE_FUNCTION
+    static unsigned int tensorIndex( unsigned int const j )
+    {
+        // Vertices, edges, center, and faces.
+        unsigned int const tensor_index[n_basis] = {
+            0,  1,  4,  3,  9,  10, 13, 12, 2,  7,  5,  6,  18, 19,
+            22, 21, 11, 16, 14, 15, 26, 8,  17, 24, 25, 20, 23};
+
+        return tensor_index[j];
+    }
 };
 
 struct PYR_HGRAD_1
@@ -147,6 +188,27 @@ struct QUAD_HGRAD_2
 
     template <typename T1, typename T2, typename T3>
     using basis_type = Intrepid2::Basis_HGRAD_QUAD_C2_FEM<T1, T2, T3>;
+
+    // Data used by the sum-factorized evaluation (see
+    // Functor::SumFactorizedHgradInterpolation).
+    static constexpr unsigned int dim = 2;
+    static constexpr unsigned int n_basis = 9;
+    typedef LagrangeQuadratic1D basis_1d_type;
+
+    /**
+     * Return the position of the j-th Intrepid2 basis function in the
+     * tensor-product ordering a + 3 * b where a and b are the indices of the
+     * 1D polynomials in the x and y directions.
+     */
+    KOKKOS_INLINE_FUNCTION
+    static unsigned int tensorIndex( unsigned int const j )
+    {
+        // Vertices, edges, and center.
+        unsigned int const tensor_index[n_basis] = {0, 1, 4, 3, 2,
+                                                    7, 5, 6, 8};
+
+        return tensor_index[j];
+    }
 };
 
 struct TET_HCURL_1
@@ -110,6 +110,79 @@ class HgradInterpolation
     Kokkos::View<Scalar **, DeviceType> _dof_values;
     Kokkos::View<Scalar **, DeviceType> _output;
 };
+
+/**
+ * Interpolation for tensor-product HGRAD elements (HEX_HGRAD_2 and
+ * QUAD_HGRAD_2). Instead of evaluating every basis function, the 1D basis is
+ * evaluated once per direction and the degrees of freedom are contracted one
+ * direction at a time. FEType must provide dim, n_basis, basis_1d_type, and
+ * tensorIndex().
+ */
+template <typename Scalar, typename FEType, typename DeviceType>
+class SumFactorizedHgradInterpolation
+{
+  public:
+    SumFactorizedHgradInterpolation(
+        Kokkos::View<Coordinate **, DeviceType> reference_points,
+        Kokkos::View<LocalOrdinal **, DeviceType> cell_dofs_ids,
+        Kokkos::View<Scalar **, DeviceType> dof_values,
+        Kokkos::View<Scalar **, DeviceType> output )
+        : _n_fields( dof_values.extent( 1 ) )
+        , _reference_points( reference_points )
+        , _cell_dofs_ids( cell_dofs_ids )
+        , _dof_values( dof_values )
+        , _output( output )
+    {
+        DTK_REQUIRE( _output.extent( 1 ) == dof_values.extent( 1 ) );
+        DTK_REQUIRE( _cell_dofs_ids.extent( 1 ) == FEType::n_basis );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( int const i ) const
+    {
+        using Basis1D = typename FEType::basis_1d_type;
+        unsigned int constexpr n_nodes = Basis1D::n_nodes;
+
+        // Evaluate the 1D basis in each direction.
+        double basis_values[FEType::dim][n_nodes];
+        for ( unsigned int d = 0; d < FEType::dim; ++d )
+            Basis1D::getValues( _reference_points( i, d ), basis_values[d] );
+
+        for ( unsigned int k = 0; k < _n_fields; ++k )
+        {
+            // Gather the dofs of the cell in the tensor-product ordering.
+            Scalar values[FEType::n_basis];
+            for ( unsigned int j = 0; j < FEType::n_basis; ++j )
+                values[FEType::tensorIndex( j )] =
+                    _dof_values( _cell_dofs_ids( i, j ), k );
+
+            // Contract one direction at a time. The contraction can be done in
+            // place because the m-th value only depends on entries with an
+            // index larger or equal to m.
+            unsigned int size = FEType::n_basis;
+            for ( unsigned int d = 0; d < FEType::dim; ++d )
+            {
+                size /= n_nodes;
+                for ( unsigned int m = 0; m < size; ++m )
+                {
+                    Scalar sum = 0.;
+                    for ( unsigned int a = 0; a < n_nodes; ++a )
+                        sum += basis_values[d][a] * values[a + n_nodes * m];
+                    values[m] = sum;
+                }
+            }
+
+            _output( i, k ) += values[0];
+        }
+    }
+
+  private:
+    unsigned int _n_fields;
+    Kokkos::View<Coordinate **, DeviceType> _reference_points;
+    Kokkos::View<LocalOrdinal **, DeviceType> _cell_dofs_ids;
+    Kokkos::View<Scalar **, DeviceType> _dof_values;
+    Kokkos::View<Scalar **, DeviceType> _output;
+};
 } // namespace Functor
 } // namespace DataTransferKit
 
@@ -48,11 +48,26 @@ class Interpolation
      * cells * n dofs per cell)
      * @param fe_type type of the finite element (DTK_HGRAD, DTK_HDIV, or
      * DTK_CURL)
+     * @param imbalance_threshold threshold used to redistribute the candidates
+     * of the search (see PointSearch)
      */
     Interpolation( MPI_Comm comm, Mesh<DeviceType> const &mesh,
                    Kokkos::View<Coordinate **, DeviceType> points_coordinates,
                    Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids,
-                   DTK_FEType fe_type );
+                   DTK_FEType fe_type, double imbalance_threshold = 0. );
+
+    /**
+     * Constructor restricting the search to the cells on the boundary of the
+     * mesh.
+     * @param boundary_cells indices of the cells on the boundary (see
+     * CellList::boundary_cells)
+     * For the other parameters see the constructor above.
+     */
+    Interpolation( MPI_Comm comm, Mesh<DeviceType> const &mesh,
+                   Kokkos::View<LocalOrdinal *, DeviceType> boundary_cells,
+                   Kokkos::View<Coordinate **, DeviceType> points_coordinates,
+                   Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids,
+                   DTK_FEType fe_type, double imbalance_threshold = 0. );
 
     /**
      * This function performs the interpolation.
@@ -92,6 +107,16 @@ class Interpolation
                       Kokkos::View<Scalar **, DeviceType> X,
                       Kokkos::View<Scalar **, DeviceType> Y );
 
+    /**
+     * Helper function that calls Functor::SumFactorizedHgradInterpolation.
+     */
+    template <typename Scalar, typename FEType>
+    void sumFactorizedInterpolate(
+        Kokkos::View<Coordinate **, DeviceType> ref_points,
+        Kokkos::View<LocalOrdinal **, DeviceType> cell_dofs_ids,
+        Kokkos::View<Scalar **, DeviceType> X,
+        Kokkos::View<Scalar **, DeviceType> Y );
+
     template <typename Scalar>
     void interpolateDispatch( FE fe, unsigned int fe_id,
                               Kokkos::View<Scalar **, DeviceType> X,
@@ -193,41 +218,19 @@ Interpolation<DeviceType>::apply( Kokkos::View<Scalar **, DeviceType> X,
     {
         // Because of the MPI communications and the sorting by topologies, all
         // the queries have been reordered. So we put them back in the initial
-        // order using the query ids.
+        // order using the query ids. The points found in multiple cells, e.g.,
+        // points on vertices, have already been filtered by PointSearch so
+        // each query is received at most once.
         ArborX::Details::DistributedSearchTreeImpl<DeviceType>::sortResults(
             space, imported_query_ids, imported_query_ids, imported_Y );
 
-        // We have finally all the values in the right order but before we can
-        // finally return the values we need to filter the data one more time.
-        // Some points are correctly found on multiple cells, e.g., point on
-        // vertices, so we need to get rid of the duplicates.
-        Kokkos::View<unsigned int *, DeviceType> mask( "mask", n_imports );
-        Kokkos::deep_copy( mask, 1 );
-        Kokkos::parallel_for(
-            DTK_MARK_REGION( "compute_mask" ),
-            Kokkos::RangePolicy<ExecutionSpace>( 1, n_imports ),
-            KOKKOS_LAMBDA( int const i ) {
-                if ( imported_query_ids( i - 1 ) == imported_query_ids( i ) )
-                    mask( i ) = 0;
-            } );
-        Kokkos::fence();
-
-        Kokkos::View<unsigned int *, DeviceType> query_offset( "query_offset",
-                                                               n_imports );
-        ArborX::exclusivePrefixSum( space, mask, query_offset );
-
         Kokkos::parallel_for(
             DTK_MARK_REGION( "fill_Y" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
             KOKKOS_LAMBDA( int const i ) {
-                if ( ( i == 0 ) || ( imported_query_ids( i - 1 ) !=
-                                     imported_query_ids( i ) ) )
-                {
-                    unsigned int k = query_offset( i );
-                    for ( unsigned int j = 0; j < n_fields; ++j )
-                        Y( k, j ) = imported_Y( i, j );
-                    found_query_ids( k ) = imported_query_ids( i );
-                }
+                for ( unsigned int j = 0; j < n_fields; ++j )
+                    Y( i, j ) = imported_Y( i, j );
+                found_query_ids( i ) = imported_query_ids( i );
             } );
         Kokkos::fence();
     }
@@ -269,6 +272,23 @@ void Interpolation<DeviceType>::hgradInterpolate(
         interpolation_functor );
 }
 
+template <typename DeviceType>
+template <typename Scalar, typename FEType>
+void Interpolation<DeviceType>::sumFactorizedInterpolate(
+    Kokkos::View<Coordinate **, DeviceType> ref_points,
+    Kokkos::View<LocalOrdinal **, DeviceType> cell_dofs_ids,
+    Kokkos::View<Scalar **, DeviceType> X,
+    Kokkos::View<Scalar **, DeviceType> Y_fe )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    Functor::SumFactorizedHgradInterpolation<Scalar, FEType, DeviceType>
+        interpolation_functor( ref_points, cell_dofs_ids, X, Y_fe );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "interpolate" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, ref_points.extent( 0 ) ),
+        interpolation_functor );
+}
+
 template <typename DeviceType>
 template <typename Scalar>
 void Interpolation<DeviceType>::interpolateDispatch(
@@ -304,7 +324,9 @@ void Interpolation<DeviceType>::interpolateDispatch(
     }
     case FE::HEX_HGRAD_2:
     {
-        hgradInterpolate<Scalar, HEX_HGRAD_2::feop_type>(
+        // Tensor-product element: use sum factorization instead of
+        // evaluating every basis function.
+        sumFactorizedInterpolate<Scalar, HEX_HGRAD_2>(
             _point_search._reference_points[topo_id], _dofs_ids[topo_id], X,
             Y_fe );
 
@@ -344,7 +366,9 @@ void Interpolation<DeviceType>::interpolateDispatch(
     }
     case FE::QUAD_HGRAD_2:
     {
-        hgradInterpolate<Scalar, QUAD_HGRAD_2::feop_type>(
+        // Tensor-product element: use sum factorization instead of
+        // evaluating every basis function.
+        sumFactorizedInterpolate<Scalar, QUAD_HGRAD_2>(
             _point_search._reference_points[topo_id], _dofs_ids[topo_id], X,
             Y_fe );
 
@@ -12,6 +12,7 @@
 #ifndef DTK_INTERPOLATION_DEF_HPP
 #define DTK_INTERPOLATION_DEF_HPP
 
+#include <DTK_DiscretizationHelpers.hpp>
 #include <DTK_FE.hpp>
 #include <DTK_PointInCell.hpp>
 
@@ -21,8 +22,25 @@ template <typename DeviceType>
 Interpolation<DeviceType>::Interpolation(
     MPI_Comm comm, Mesh<DeviceType> const &mesh,
     Kokkos::View<Coordinate **, DeviceType> points_coordinates,
-    Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids, DTK_FEType fe_type )
-    : _point_search( comm, mesh, points_coordinates )
+    Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids, DTK_FEType fe_type,
+    double imbalance_threshold )
+    : Interpolation( comm, mesh,
+                     Discretization::Helpers::getAllCells(
+                         mesh.cell_topologies ),
+                     points_coordinates, cell_dof_ids, fe_type,
+                     imbalance_threshold )
+{
+}
+
+template <typename DeviceType>
+Interpolation<DeviceType>::Interpolation(
+    MPI_Comm comm, Mesh<DeviceType> const &mesh,
+    Kokkos::View<LocalOrdinal *, DeviceType> boundary_cells,
+    Kokkos::View<Coordinate **, DeviceType> points_coordinates,
+    Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids, DTK_FEType fe_type,
+    double imbalance_threshold )
+    : _point_search( comm, mesh, boundary_cells, points_coordinates,
+                     imbalance_threshold )
 {
     // Fill up _finite_element, i.e., fill up a map between topo_id and FE
     Topologies topologies;
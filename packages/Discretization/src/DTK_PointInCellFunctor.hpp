@@ -12,21 +12,493 @@
 #ifndef DTK_POINT_IN_CELL_FUNCTOR_HPP
 #define DTK_POINT_IN_CELL_FUNCTOR_HPP
 
+#include <DTK_BlockCells.hpp>
+#include <DTK_FE.hpp>
+#include <DTK_Topology.hpp>
+
 #include <Intrepid2_CellTools_Serial.hpp>
 #include <Kokkos_Macros.hpp>
 #include <Kokkos_View.hpp>
 
+#include <cmath>
+
 namespace DataTransferKit
 {
+/**
+ * Affine map x = x_0 + J (xi - xi_0) from the reference cell to a physical
+ * cell, where x_0 is the first node of the cell and xi_0 its coordinates in
+ * the reference frame. The map exists for the linear simplices and for the
+ * parallelograms/parallelepipeds among QUAD_4 and HEX_8. Cells without a
+ * specialization use the Newton solver of Intrepid2.
+ */
+template <typename CellType>
+struct AffineMap
+{
+    static constexpr bool is_available = false;
+};
+
+template <>
+struct AffineMap<TET_4>
+{
+    static constexpr bool is_available = true;
+    static constexpr unsigned int dim = 3;
+    static constexpr double ref_origin = 0.;
+
+    /**
+     * Compute the Jacobian of the map. Return false if the cell is not affine.
+     */
+    template <typename CellsView>
+    KOKKOS_INLINE_FUNCTION static bool
+    computeJacobian( CellsView const &cells, int const cell_index,
+                     double jacobian[dim][dim] )
+    {
+        for ( unsigned int d = 0; d < dim; ++d )
+            for ( unsigned int c = 0; c < dim; ++c )
+                jacobian[d][c] =
+                    cells( cell_index, c + 1, d ) - cells( cell_index, 0, d );
+
+        return true;
+    }
+};
+
+template <>
+struct AffineMap<TRI_3>
+{
+    static constexpr bool is_available = true;
+    static constexpr unsigned int dim = 2;
+    static constexpr double ref_origin = 0.;
+
+    template <typename CellsView>
+    KOKKOS_INLINE_FUNCTION static bool
+    computeJacobian( CellsView const &cells, int const cell_index,
+                     double jacobian[dim][dim] )
+    {
+        for ( unsigned int d = 0; d < dim; ++d )
+            for ( unsigned int c = 0; c < dim; ++c )
+                jacobian[d][c] =
+                    cells( cell_index, c + 1, d ) - cells( cell_index, 0, d );
+
+        return true;
+    }
+};
+
+template <>
+struct AffineMap<QUAD_4>
+{
+    static constexpr bool is_available = true;
+    static constexpr unsigned int dim = 2;
+    static constexpr double ref_origin = -1.;
+
+    /**
+     * The map is affine if the cell is a parallelogram, i.e., if x_0 + x_2 =
+     * x_1 + x_3.
+     */
+    template <typename CellsView>
+    KOKKOS_INLINE_FUNCTION static bool
+    computeJacobian( CellsView const &cells, int const cell_index,
+                     double jacobian[dim][dim] )
+    {
+        double scale = 0.;
+        double deviation = 0.;
+        for ( unsigned int d = 0; d < dim; ++d )
+        {
+            double const x_0 = cells( cell_index, 0, d );
+            double const x_1 = cells( cell_index, 1, d );
+            double const x_2 = cells( cell_index, 2, d );
+            double const x_3 = cells( cell_index, 3, d );
+            jacobian[d][0] = 0.5 * ( x_1 - x_0 );
+            jacobian[d][1] = 0.5 * ( x_3 - x_0 );
+            scale = std::fmax( scale, std::abs( x_1 - x_0 ) );
+            scale = std::fmax( scale, std::abs( x_3 - x_0 ) );
+            deviation =
+                std::fmax( deviation, std::abs( x_0 + x_2 - x_1 - x_3 ) );
+        }
+
+        return deviation <= affine_tolerance * scale;
+    }
+
+    static constexpr double affine_tolerance = 1e-12;
+};
+
+template <>
+struct AffineMap<HEX_8>
+{
+    static constexpr bool is_available = true;
+    static constexpr unsigned int dim = 3;
+    static constexpr double ref_origin = -1.;
+
+    /**
+     * The map is affine if the cell is a parallelepiped, i.e., if every node
+     * can be obtained from x_0 and the three edges leaving x_0.
+     */
+    template <typename CellsView>
+    KOKKOS_INLINE_FUNCTION static bool
+    computeJacobian( CellsView const &cells, int const cell_index,
+                     double jacobian[dim][dim] )
+    {
+        double scale = 0.;
+        double deviation = 0.;
+        for ( unsigned int d = 0; d < dim; ++d )
+        {
+            double x[8];
+            for ( unsigned int n = 0; n < 8; ++n )
+                x[n] = cells( cell_index, n, d );
+            double const e_1 = x[1] - x[0];
+            double const e_3 = x[3] - x[0];
+            double const e_4 = x[4] - x[0];
+            jacobian[d][0] = 0.5 * e_1;
+            jacobian[d][1] = 0.5 * e_3;
+            jacobian[d][2] = 0.5 * e_4;
+            scale = std::fmax( scale, std::abs( e_1 ) );
+            scale = std::fmax( scale, std::abs( e_3 ) );
+            scale = std::fmax( scale, std::abs( e_4 ) );
+            deviation =
+                std::fmax( deviation, std::abs( x[2] - x[0] - e_1 - e_3 ) );
+            deviation =
+                std::fmax( deviation, std::abs( x[5] - x[0] - e_1 - e_4 ) );
+            deviation =
+                std::fmax( deviation, std::abs( x[7] - x[0] - e_3 - e_4 ) );
+            deviation = std::fmax(
+                deviation, std::abs( x[6] - x[0] - e_1 - e_3 - e_4 ) );
+        }
+
+        return deviation <= affine_tolerance * scale;
+    }
+
+    static constexpr double affine_tolerance = 1e-12;
+};
+
+/**
+ * Points whose convex hull contains the cell. The shape functions of the
+ * linear cells are nonnegative and therefore, the cell is contained in the
+ * convex hull of its nodes. This is not true for the quadratic Lagrange cells
+ * which can bulge outside of the hull of their nodes. Their Bernstein control
+ * points are used instead. The points are computed in place from the nodes of
+ * the cell stored as (n nodes, dim). Cells without a specialization are not
+ * culled before the Newton solver.
+ */
+template <typename CellType>
+struct ConvexHull
+{
+    static constexpr bool is_available = false;
+
+    KOKKOS_INLINE_FUNCTION
+    static void computeHullPoints( double *, unsigned int const ) {}
+};
+
+struct LinearConvexHull
+{
+    static constexpr bool is_available = true;
+
+    KOKKOS_INLINE_FUNCTION
+    static void computeHullPoints( double *, unsigned int const ) {}
+};
+
+template <>
+struct ConvexHull<HEX_8> : LinearConvexHull
+{
+};
+
+template <>
+struct ConvexHull<PYRAMID_5> : LinearConvexHull
+{
+};
+
+template <>
+struct ConvexHull<QUAD_4> : LinearConvexHull
+{
+};
+
+template <>
+struct ConvexHull<WEDGE_6> : LinearConvexHull
+{
+};
+
+/**
+ * The Bernstein control point associated to the mid-edge node m of the edge
+ * (a, b) is 2 m - (a + b) / 2. The vertices are left unchanged.
+ */
+KOKKOS_INLINE_FUNCTION
+void computeEdgeControlPoint( double *points, unsigned int const dim,
+                              unsigned int const a, unsigned int const b,
+                              unsigned int const m )
+{
+    for ( unsigned int d = 0; d < dim; ++d )
+        points[m * dim + d] =
+            2. * points[m * dim + d] -
+            0.5 * ( points[a * dim + d] + points[b * dim + d] );
+}
+
+template <>
+struct ConvexHull<TRI_6>
+{
+    static constexpr bool is_available = true;
+
+    KOKKOS_INLINE_FUNCTION
+    static void computeHullPoints( double *points, unsigned int const dim )
+    {
+        unsigned int const edges[3][2] = {{0, 1}, {1, 2}, {2, 0}};
+        for ( unsigned int e = 0; e < 3; ++e )
+            computeEdgeControlPoint( points, dim, edges[e][0], edges[e][1],
+                                     3 + e );
+    }
+};
+
+template <>
+struct ConvexHull<TET_10>
+{
+    static constexpr bool is_available = true;
+
+    KOKKOS_INLINE_FUNCTION
+    static void computeHullPoints( double *points, unsigned int const dim )
+    {
+        unsigned int const edges[6][2] = {{0, 1}, {1, 2}, {2, 0},
+                                          {0, 3}, {1, 3}, {2, 3}};
+        for ( unsigned int e = 0; e < 6; ++e )
+            computeEdgeControlPoint( points, dim, edges[e][0], edges[e][1],
+                                     4 + e );
+    }
+};
+
+/**
+ * The control points of the tensor-product cells are obtained by applying the
+ * 1D transformation in each direction. The points are reordered following the
+ * tensor-product ordering of the FE type which does not matter for the hull.
+ */
+template <typename FEType>
+struct TensorConvexHull
+{
+    static constexpr bool is_available = true;
+
+    KOKKOS_INLINE_FUNCTION
+    static void computeHullPoints( double *points, unsigned int const dim )
+    {
+        unsigned int constexpr n_points = FEType::n_basis;
+        double tensor_points[n_points * FEType::dim];
+        for ( unsigned int j = 0; j < n_points; ++j )
+            for ( unsigned int d = 0; d < dim; ++d )
+                tensor_points[FEType::tensorIndex( j ) * dim + d] =
+                    points[j * dim + d];
+
+        // The 1D nodes are ordered -1, 1, 0.
+        unsigned int stride = 1;
+        for ( unsigned int direction = 0; direction < dim; ++direction )
+        {
+            for ( unsigned int t = 0; t < n_points; ++t )
+                if ( ( t / stride ) % 3 == 2 )
+                    computeEdgeControlPoint( tensor_points, dim,
+                                             t - 2 * stride, t - stride, t );
+            stride *= 3;
+        }
+
+        for ( unsigned int i = 0; i < n_points * dim; ++i )
+            points[i] = tensor_points[i];
+    }
+};
+
+template <>
+struct ConvexHull<HEX_27> : TensorConvexHull<HEX_HGRAD_2>
+{
+};
+
+template <>
+struct ConvexHull<QUAD_9> : TensorConvexHull<QUAD_HGRAD_2>
+{
+};
+
 namespace Functor
 {
-template <typename CellType, typename DeviceType>
+/**
+ * Invert a 2x2 or 3x3 matrix. Return false if the matrix is singular.
+ */
+KOKKOS_INLINE_FUNCTION
+bool invertMatrix( double const a[2][2], double inverse[2][2] )
+{
+    double const det = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+    if ( det == 0. )
+        return false;
+
+    inverse[0][0] = a[1][1] / det;
+    inverse[0][1] = -a[0][1] / det;
+    inverse[1][0] = -a[1][0] / det;
+    inverse[1][1] = a[0][0] / det;
+
+    return true;
+}
+
+KOKKOS_INLINE_FUNCTION
+bool invertMatrix( double const a[3][3], double inverse[3][3] )
+{
+    double const cofactor_0 = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+    double const cofactor_1 = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+    double const cofactor_2 = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+    double const det =
+        a[0][0] * cofactor_0 + a[0][1] * cofactor_1 + a[0][2] * cofactor_2;
+    if ( det == 0. )
+        return false;
+
+    inverse[0][0] = cofactor_0 / det;
+    inverse[0][1] = ( a[0][2] * a[2][1] - a[0][1] * a[2][2] ) / det;
+    inverse[0][2] = ( a[0][1] * a[1][2] - a[0][2] * a[1][1] ) / det;
+    inverse[1][0] = cofactor_1 / det;
+    inverse[1][1] = ( a[0][0] * a[2][2] - a[0][2] * a[2][0] ) / det;
+    inverse[1][2] = ( a[0][2] * a[1][0] - a[0][0] * a[1][2] ) / det;
+    inverse[2][0] = cofactor_2 / det;
+    inverse[2][1] = ( a[0][1] * a[2][0] - a[0][0] * a[2][1] ) / det;
+    inverse[2][2] = ( a[0][0] * a[1][1] - a[0][1] * a[1][0] ) / det;
+
+    return true;
+}
+
+/**
+ * Check if a point is inside the k-DOP, i.e., the intersection of slabs along
+ * the axes and the diagonals of the coordinate planes, bounding the given
+ * points. The slabs are enlarged by \p threshold times the largest extent of
+ * the k-DOP so that the test is consistent with the tolerance used in the
+ * reference frame.
+ */
+template <typename PointView>
+KOKKOS_INLINE_FUNCTION bool
+insideKDOP( PointView const &point, double const *hull_points,
+            unsigned int const n_points, unsigned int const dim,
+            double const threshold )
+{
+    // In 2D, only the first two axes and the first two diagonals are used.
+    unsigned int constexpr max_n_directions = 9;
+    int const directions[max_n_directions][3] = {
+        {1, 0, 0}, {0, 1, 0},  {1, 1, 0}, {1, -1, 0}, {0, 0, 1},
+        {1, 0, 1}, {1, 0, -1}, {0, 1, 1}, {0, 1, -1}};
+    unsigned int const n_directions = ( dim == 3 ) ? 9 : 4;
+
+    double min_projection[max_n_directions];
+    double max_projection[max_n_directions];
+    double point_projection[max_n_directions];
+    double max_extent = 0.;
+    for ( unsigned int k = 0; k < n_directions; ++k )
+    {
+        point_projection[k] = 0.;
+        for ( unsigned int d = 0; d < dim; ++d )
+            point_projection[k] += directions[k][d] * point( d );
+        for ( unsigned int n = 0; n < n_points; ++n )
+        {
+            double projection = 0.;
+            for ( unsigned int d = 0; d < dim; ++d )
+                projection += directions[k][d] * hull_points[n * dim + d];
+            if ( n == 0 || projection < min_projection[k] )
+                min_projection[k] = projection;
+            if ( n == 0 || projection > max_projection[k] )
+                max_projection[k] = projection;
+        }
+        max_extent =
+            std::fmax( max_extent, max_projection[k] - min_projection[k] );
+    }
+
+    double const tolerance = threshold * max_extent;
+    for ( unsigned int k = 0; k < n_directions; ++k )
+        if ( ( point_projection[k] < min_projection[k] - tolerance ) ||
+             ( point_projection[k] > max_projection[k] + tolerance ) )
+            return false;
+
+    return true;
+}
+
+/**
+ * Compute the coordinates of a point in the reference frame of a cell using the
+ * Newton solver of Intrepid2. The nodes of the cell are gathered in a local
+ * buffer so that \p cells can be either a (n cells, n nodes, dim) View or a
+ * BlockCells accessor reading the nodes through the connectivity of the mesh.
+ * Before running the Newton solver, the point is tested against a k-DOP
+ * bounding the cell. The bounding boxes used by the coarse search are loose
+ * for skewed or curved cells and most of the candidates can be discarded
+ * cheaply. Return false if the point was culled, in which case \p ref_point
+ * is not computed.
+ */
+template <typename CellType, typename ExecutionSpace, typename RefPointView,
+          typename PhysPointView, typename CellsType>
+KOKKOS_INLINE_FUNCTION bool
+mapToReferenceFrame( RefPointView ref_point, PhysPointView phys_point,
+                     CellsType const &cells, int const cell_index,
+                     double const threshold )
+{
+    // HEX_27 is the supported topology with the largest number of nodes.
+    unsigned int constexpr max_n_nodes = 27;
+    unsigned int constexpr max_dim = 3;
+    unsigned int const n_nodes = cells.extent( 1 );
+    unsigned int const dim = cells.extent( 2 );
+    double nodes_buffer[max_n_nodes * max_dim];
+    for ( unsigned int n = 0; n < n_nodes; ++n )
+        for ( unsigned int d = 0; d < dim; ++d )
+            nodes_buffer[n * dim + d] = cells( cell_index, n, d );
+
+    if ( ConvexHull<CellType>::is_available )
+    {
+        double hull_points[max_n_nodes * max_dim];
+        for ( unsigned int i = 0; i < n_nodes * dim; ++i )
+            hull_points[i] = nodes_buffer[i];
+        ConvexHull<CellType>::computeHullPoints( hull_points, dim );
+        if ( !insideKDOP( phys_point, hull_points, n_nodes, dim, threshold ) )
+            return false;
+    }
+
+    Kokkos::View<double **, Kokkos::LayoutRight, ExecutionSpace,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+        nodes( nodes_buffer, n_nodes, dim );
+
+    Intrepid2::Impl::CellTools::Serial::mapToReferenceFrame<
+        typename CellType::basis_type>( ref_point, phys_point, nodes );
+
+    return true;
+}
+
+/**
+ * Compute once per cell the inverse Jacobian of the affine map. The cells
+ * that are not affine are flagged and use the Newton solver.
+ */
+template <typename CellType, typename DeviceType,
+          typename CellsType = Kokkos::View<Coordinate ***, DeviceType>>
+class AffineMapSetup
+{
+  public:
+    AffineMapSetup( CellsType cells,
+                    Kokkos::View<double ***, DeviceType> inverse_jacobians,
+                    Kokkos::View<bool *, DeviceType> is_affine )
+        : _cells( cells )
+        , _inverse_jacobians( inverse_jacobians )
+        , _is_affine( is_affine )
+    {
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( int const cell_index ) const
+    {
+        unsigned int constexpr dim = AffineMap<CellType>::dim;
+        double jacobian[dim][dim];
+        double inverse[dim][dim];
+        bool const is_affine =
+            AffineMap<CellType>::computeJacobian( _cells, cell_index,
+                                                  jacobian ) &&
+            invertMatrix( jacobian, inverse );
+        _is_affine( cell_index ) = is_affine;
+        if ( is_affine )
+            for ( unsigned int d = 0; d < dim; ++d )
+                for ( unsigned int c = 0; c < dim; ++c )
+                    _inverse_jacobians( cell_index, d, c ) = inverse[d][c];
+    }
+
+  private:
+    CellsType _cells;
+    Kokkos::View<double ***, DeviceType> _inverse_jacobians;
+    Kokkos::View<bool *, DeviceType> _is_affine;
+};
+
+template <typename CellType, typename DeviceType,
+          typename CellsType = Kokkos::View<Coordinate ***, DeviceType>>
 class PointInCell
 {
   public:
     PointInCell( double threshold,
                  Kokkos::View<double **, DeviceType> physical_points,
-                 Kokkos::View<double ***, DeviceType> cells,
+                 CellsType cells,
                  Kokkos::View<int *, DeviceType> coarse_search_output_cells,
                  Kokkos::View<double **, DeviceType> reference_points,
                  Kokkos::View<bool *, DeviceType> point_in_cell )
@@ -44,28 +516,100 @@ class PointInCell
     {
         // Extract the indices computed by the coarse search
         int const cell_index = _coarse_search_output_cells( i );
-        // Get the subviews corresponding the reference point (dim), the
-        // physical point (dim), the current cell (nodes, dim)
+        // Get the subviews corresponding the reference point (dim) and the
+        // physical point (dim)
         using ExecutionSpace = typename DeviceType::execution_space;
         Kokkos::View<double *, Kokkos::LayoutStride, ExecutionSpace> ref_point(
             _reference_points, i, Kokkos::ALL() );
         Kokkos::View<double *, Kokkos::LayoutStride, ExecutionSpace> phys_point(
             _physical_points, i, Kokkos::ALL() );
-        Kokkos::View<double **, Kokkos::LayoutStride, ExecutionSpace> nodes(
-            _cells, cell_index, Kokkos::ALL(), Kokkos::ALL() );
 
         // Compute the reference point and return true if the
         // point is inside the cell
-        Intrepid2::Impl::CellTools::Serial::mapToReferenceFrame<
-            typename CellType::basis_type>( ref_point, phys_point, nodes );
         _point_in_cell[i] =
+            mapToReferenceFrame<CellType, ExecutionSpace>(
+                ref_point, phys_point, _cells, cell_index, _threshold ) &&
+            CellType::topo_type::checkPointInclusion( ref_point, _threshold );
+    }
+
+  private:
+    double _threshold;
+    Kokkos::View<double **, DeviceType> _physical_points;
+    CellsType _cells;
+    Kokkos::View<int *, DeviceType> _coarse_search_output_cells;
+    Kokkos::View<double **, DeviceType> _reference_points;
+    Kokkos::View<bool *, DeviceType> _point_in_cell;
+};
+
+/**
+ * Same as PointInCell but the reference coordinates of the points in affine
+ * cells are computed in closed form using the inverse Jacobians computed by
+ * AffineMapSetup. The other cells use the Newton solver.
+ */
+template <typename CellType, typename DeviceType,
+          typename CellsType = Kokkos::View<Coordinate ***, DeviceType>>
+class AffinePointInCell
+{
+  public:
+    AffinePointInCell(
+        double threshold, Kokkos::View<double **, DeviceType> physical_points,
+        CellsType cells, Kokkos::View<double ***, DeviceType> inverse_jacobians,
+        Kokkos::View<bool *, DeviceType> is_affine,
+        Kokkos::View<int *, DeviceType> coarse_search_output_cells,
+        Kokkos::View<double **, DeviceType> reference_points,
+        Kokkos::View<bool *, DeviceType> point_in_cell )
+        : _threshold( threshold )
+        , _physical_points( physical_points )
+        , _cells( cells )
+        , _inverse_jacobians( inverse_jacobians )
+        , _is_affine( is_affine )
+        , _coarse_search_output_cells( coarse_search_output_cells )
+        , _reference_points( reference_points )
+        , _point_in_cell( point_in_cell )
+    {
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( unsigned int const i ) const
+    {
+        int const cell_index = _coarse_search_output_cells( i );
+        using ExecutionSpace = typename DeviceType::execution_space;
+        Kokkos::View<double *, Kokkos::LayoutStride, ExecutionSpace> ref_point(
+            _reference_points, i, Kokkos::ALL() );
+
+        bool candidate = true;
+        if ( _is_affine( cell_index ) )
+        {
+            // xi = xi_0 + J^{-1} (x - x_0)
+            unsigned int constexpr dim = AffineMap<CellType>::dim;
+            for ( unsigned int d = 0; d < dim; ++d )
+            {
+                double xi = AffineMap<CellType>::ref_origin;
+                for ( unsigned int c = 0; c < dim; ++c )
+                    xi += _inverse_jacobians( cell_index, d, c ) *
+                          ( _physical_points( i, c ) -
+                            _cells( cell_index, 0, c ) );
+                ref_point( d ) = xi;
+            }
+        }
+        else
+        {
+            Kokkos::View<double *, Kokkos::LayoutStride, ExecutionSpace>
+                phys_point( _physical_points, i, Kokkos::ALL() );
+            candidate = mapToReferenceFrame<CellType, ExecutionSpace>(
+                ref_point, phys_point, _cells, cell_index, _threshold );
+        }
+        _point_in_cell[i] =
+            candidate &&
             CellType::topo_type::checkPointInclusion( ref_point, _threshold );
     }
 
   private:
     double _threshold;
     Kokkos::View<double **, DeviceType> _physical_points;
-    Kokkos::View<double ***, DeviceType> _cells;
+    CellsType _cells;
+    Kokkos::View<double ***, DeviceType> _inverse_jacobians;
+    Kokkos::View<bool *, DeviceType> _is_affine;
     Kokkos::View<int *, DeviceType> _coarse_search_output_cells;
     Kokkos::View<double **, DeviceType> _reference_points;
     Kokkos::View<bool *, DeviceType> _point_in_cell;
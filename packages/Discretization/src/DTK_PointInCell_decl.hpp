@@ -13,6 +13,7 @@
 #define DTK_POINT_IN_CELL_DECL_HPP
 
 #include "DTK_ConfigDefs.hpp"
+#include <DTK_BlockCells.hpp>
 #include <DTK_CellTypes.h>
 #include <DTK_DBC.hpp>
 
@@ -46,9 +47,22 @@ class PointInCell
             Kokkos::View<bool *, DeviceType> point_in_cell );
 
     /**
-     * Same function as above. However, the function is virtual so that the user
-     * can provide their own implementation. If the function is not overriden,
-     * it throws an exception.
+     * Same function as above but the nodes of the cells are read through the
+     * connectivity of the mesh instead of being copied in a (n_cells, n_nodes,
+     * dim) View.
+     */
+    static void
+    search( Kokkos::View<Coordinate **, DeviceType> physical_points,
+            BlockCells<DeviceType> const &cells,
+            Kokkos::View<int *, DeviceType> coarse_search_output_cells,
+            DTK_CellTopology cell_topo,
+            Kokkos::View<Coordinate **, DeviceType> reference_points,
+            Kokkos::View<bool *, DeviceType> point_in_cell );
+
+    /**
+     * Same function as the first one. However, the function is virtual so
+     * that the user can provide their own implementation. If the function is
+     * not overriden, it throws an exception.
      *    @param[in] physical_points The coordinates of the points in the
      * physical space (coarse_output_size, dim)
      *    @param[in] cells Cells owned by the processor (n_cells, n_nodes, dim)
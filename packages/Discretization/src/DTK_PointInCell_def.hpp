@@ -16,54 +16,101 @@
 #include <DTK_PointInCellFunctor.hpp>
 #include <DTK_Topology.hpp>
 
+#include <type_traits>
+
 namespace DataTransferKit
 {
 // Because search is static, we cannot use a private function so put the
 // function in its own namespace.
 namespace internal
 {
-template <typename CellType, typename DeviceType>
+// Generic cells: use the Newton solver of Intrepid2 for every candidate.
+template <typename CellType, typename DeviceType, typename CellsType>
+void performPointInCell(
+    std::false_type, double threshold,
+    Kokkos::View<double **, DeviceType> physical_points, CellsType cells,
+    Kokkos::View<int *, DeviceType> coarse_search_output_cells,
+    Kokkos::View<double **, DeviceType> reference_points,
+    Kokkos::View<bool *, DeviceType> point_in_cell )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    int const n_ref_pts = reference_points.extent( 0 );
+
+    Functor::PointInCell<CellType, DeviceType, CellsType> search_functor(
+        threshold, physical_points, cells, coarse_search_output_cells,
+        reference_points, point_in_cell );
+    Kokkos::parallel_for( DTK_MARK_REGION( "point_in_cell" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_ref_pts ),
+                          search_functor );
+}
+
+// Cells that may be affine: compute the inverse Jacobian once per cell and
+// then map every candidate in closed form. Cells that turn out not to be
+// affine fall back to the Newton solver.
+template <typename CellType, typename DeviceType, typename CellsType>
+void performPointInCell(
+    std::true_type, double threshold,
+    Kokkos::View<double **, DeviceType> physical_points, CellsType cells,
+    Kokkos::View<int *, DeviceType> coarse_search_output_cells,
+    Kokkos::View<double **, DeviceType> reference_points,
+    Kokkos::View<bool *, DeviceType> point_in_cell )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    int const n_ref_pts = reference_points.extent( 0 );
+    int const n_cells = cells.extent( 0 );
+    unsigned int constexpr dim = AffineMap<CellType>::dim;
+
+    Kokkos::View<double ***, DeviceType> inverse_jacobians(
+        Kokkos::ViewAllocateWithoutInitializing( "inverse_jacobians" ),
+        n_cells, dim, dim );
+    Kokkos::View<bool *, DeviceType> is_affine( "is_affine", n_cells );
+    Functor::AffineMapSetup<CellType, DeviceType, CellsType> setup_functor(
+        cells, inverse_jacobians, is_affine );
+    Kokkos::parallel_for( DTK_MARK_REGION( "affine_map_setup" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
+                          setup_functor );
+
+    Functor::AffinePointInCell<CellType, DeviceType, CellsType> search_functor(
+        threshold, physical_points, cells, inverse_jacobians, is_affine,
+        coarse_search_output_cells, reference_points, point_in_cell );
+    Kokkos::parallel_for( DTK_MARK_REGION( "point_in_cell" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_ref_pts ),
+                          search_functor );
+}
+
+template <typename CellType, typename DeviceType, typename CellsType>
 void pointInCell( double threshold,
                   Kokkos::View<Coordinate **, DeviceType> physical_points,
-                  Kokkos::View<Coordinate ***, DeviceType> cells,
+                  CellsType const &cells,
                   Kokkos::View<int *, DeviceType> coarse_search_output_cells,
                   Kokkos::View<Coordinate **, DeviceType> reference_points,
                   Kokkos::View<bool *, DeviceType> point_in_cell )
 {
-    using ExecutionSpace = typename DeviceType::execution_space;
-    int const n_ref_pts = reference_points.extent( 0 );
-
     // Functor::PointInCell uses Intrepid2 which assumme that the coordinates of
-    // the point is double not float.
+    // the point is double not float. The coordinates of the nodes are
+    // converted by the functor when they are loaded.
     Kokkos::View<double **, DeviceType> physical_dp_points(
         "physical_dp_points", physical_points.extent( 0 ),
         physical_points.extent( 1 ) );
     Kokkos::deep_copy( physical_dp_points, physical_points );
-    Kokkos::View<double ***, DeviceType> dp_cells(
-        "dp_cells", cells.extent( 0 ), cells.extent( 1 ), cells.extent( 2 ) );
-    Kokkos::deep_copy( dp_cells, cells );
     Kokkos::View<double **, DeviceType> reference_dp_points(
         "reference_dp_points", reference_points.extent( 0 ),
         reference_points.extent( 1 ) );
     Kokkos::deep_copy( reference_dp_points, reference_points );
 
-    Functor::PointInCell<CellType, DeviceType> search_functor(
-        threshold, physical_dp_points, dp_cells, coarse_search_output_cells,
+    performPointInCell<CellType>(
+        std::integral_constant<bool, AffineMap<CellType>::is_available>(),
+        threshold, physical_dp_points, cells, coarse_search_output_cells,
         reference_dp_points, point_in_cell );
-    Kokkos::parallel_for( DTK_MARK_REGION( "point_in_cell" ),
-                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_ref_pts ),
-                          search_functor );
 
     Kokkos::deep_copy( physical_points, physical_dp_points );
-    Kokkos::deep_copy( cells, dp_cells );
     Kokkos::deep_copy( reference_points, reference_dp_points );
 }
-} // namespace internal
 
-template <typename DeviceType>
-void PointInCell<DeviceType>::search(
-    Kokkos::View<Coordinate **, DeviceType> physical_points,
-    Kokkos::View<Coordinate ***, DeviceType> cells,
+template <typename DeviceType, typename CellsType>
+void pointInCellDispatch(
+    double threshold, Kokkos::View<Coordinate **, DeviceType> physical_points,
+    CellsType const &cells,
     Kokkos::View<int *, DeviceType> coarse_search_output_cells,
     DTK_CellTopology cell_topo,
     Kokkos::View<Coordinate **, DeviceType> reference_points,
@@ -80,81 +127,83 @@ void PointInCell<DeviceType>::search(
     // Note that if the Newton solver does not converge, Intrepid2 will just
     // return the last results and there is no way to know that the coordinates
     // in the reference frames where not found.
+    // Affine cells (TET_4, TRI_3, and parallelogram/parallelepiped QUAD_4 and
+    // HEX_8) do not use the Newton solver.
     switch ( cell_topo )
     {
     case DTK_HEX_8:
     {
-        internal::pointInCell<HEX_8, DeviceType>(
+        pointInCell<HEX_8, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
     }
     case DTK_HEX_27:
     {
-        internal::pointInCell<HEX_27, DeviceType>(
+        pointInCell<HEX_27, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
     }
     case DTK_PYRAMID_5:
     {
-        internal::pointInCell<PYRAMID_5, DeviceType>(
+        pointInCell<PYRAMID_5, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
     }
     case DTK_QUAD_4:
     {
-        internal::pointInCell<QUAD_4, DeviceType>(
+        pointInCell<QUAD_4, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
     }
     case DTK_QUAD_9:
     {
-        internal::pointInCell<QUAD_9, DeviceType>(
+        pointInCell<QUAD_9, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
     }
     case DTK_TET_4:
     {
-        internal::pointInCell<TET_4, DeviceType>(
+        pointInCell<TET_4, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
     }
     case DTK_TET_10:
     {
-        internal::pointInCell<TET_10, DeviceType>(
+        pointInCell<TET_10, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
     }
     case DTK_TRI_3:
     {
-        internal::pointInCell<TRI_3, DeviceType>(
+        pointInCell<TRI_3, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
     }
     case DTK_TRI_6:
     {
-        internal::pointInCell<TRI_6, DeviceType>(
+        pointInCell<TRI_6, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
     }
     case DTK_WEDGE_6:
     {
-        internal::pointInCell<WEDGE_6, DeviceType>(
+        pointInCell<WEDGE_6, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
     }
     case DTK_WEDGE_18:
     {
-        internal::pointInCell<WEDGE_18, DeviceType>(
+        pointInCell<WEDGE_18, DeviceType>(
             threshold, physical_points, cells, coarse_search_output_cells,
             reference_points, point_in_cell );
         break;
@@ -166,6 +215,35 @@ void PointInCell<DeviceType>::search(
     }
     Kokkos::fence();
 }
+} // namespace internal
+
+template <typename DeviceType>
+void PointInCell<DeviceType>::search(
+    Kokkos::View<Coordinate **, DeviceType> physical_points,
+    Kokkos::View<Coordinate ***, DeviceType> cells,
+    Kokkos::View<int *, DeviceType> coarse_search_output_cells,
+    DTK_CellTopology cell_topo,
+    Kokkos::View<Coordinate **, DeviceType> reference_points,
+    Kokkos::View<bool *, DeviceType> point_in_cell )
+{
+    internal::pointInCellDispatch( threshold, physical_points, cells,
+                                   coarse_search_output_cells, cell_topo,
+                                   reference_points, point_in_cell );
+}
+
+template <typename DeviceType>
+void PointInCell<DeviceType>::search(
+    Kokkos::View<Coordinate **, DeviceType> physical_points,
+    BlockCells<DeviceType> const &cells,
+    Kokkos::View<int *, DeviceType> coarse_search_output_cells,
+    DTK_CellTopology cell_topo,
+    Kokkos::View<Coordinate **, DeviceType> reference_points,
+    Kokkos::View<bool *, DeviceType> point_in_cell )
+{
+    internal::pointInCellDispatch( threshold, physical_points, cells,
+                                   coarse_search_output_cells, cell_topo,
+                                   reference_points, point_in_cell );
+}
 } // namespace DataTransferKit
 
 // Explicit instantiation macro
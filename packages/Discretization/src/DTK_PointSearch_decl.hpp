@@ -14,6 +14,7 @@
 
 #include "DTK_ConfigDefs.hpp"
 #include <ArborX.hpp>
+#include <DTK_BlockCells.hpp>
 #include <DTK_CellTypes.h>
 #include <DTK_Mesh.hpp>
 
@@ -22,14 +23,18 @@
 #include <mpi.h>
 
 #include <array>
+#include <memory>
 #include <tuple>
+#include <vector>
 
 namespace DataTransferKit
 {
 /**
  * This class performs the search of a set of given points in a given mesh and
- * returns the cell(s) on which each point has been found as well as the
- * position of the points in the reference frame.
+ * returns the cell on which each point has been found as well as the position
+ * of the points in the reference frame. When a point is found in several
+ * cells, e.g., a point on a vertex shared by several cells, the point is
+ * owned by the cell with the lowest index on the lowest rank.
  */
 template <typename DeviceType>
 class PointSearch
@@ -44,9 +49,27 @@ class PointSearch
      * that we are looking for.
      * For a more detailed documentation on \p cell_topologies, \p
      * cells, and \p nodes_coordinates see the documentation of CellList.
+     * @param imbalance_threshold if positive, the candidates of the
+     * distributed search are redistributed when the largest number of
+     * candidates on a processor is larger than \p imbalance_threshold times
+     * the average number of candidates. The geometry of the cells is sent with
+     * the candidates.
      */
     PointSearch( MPI_Comm comm, Mesh<DeviceType> const &mesh,
-                 Kokkos::View<Coordinate **, DeviceType> points_coordinates );
+                 Kokkos::View<Coordinate **, DeviceType> points_coordinates,
+                 double imbalance_threshold = 0. );
+
+    /**
+     * Constructor restricting the search to the cells on the boundary of the
+     * mesh, e.g., for a transfer on a coupling surface. Only the bounding
+     * boxes of these cells are inserted in the search tree.
+     * @param boundary_cells indices of the cells on the boundary (see
+     * CellList::boundary_cells). A cell may appear several times.
+     */
+    PointSearch( MPI_Comm comm, Mesh<DeviceType> const &mesh,
+                 Kokkos::View<LocalOrdinal *, DeviceType> boundary_cells,
+                 Kokkos::View<Coordinate **, DeviceType> points_coordinates,
+                 double imbalance_threshold = 0. );
 
     /**
      * Return the result of the search. The tuple contains the rank where the
@@ -59,9 +82,56 @@ class PointSearch
                Kokkos::View<unsigned int *, DeviceType>>
     getSearchResults() const;
 
+    /**
+     * Return the number of candidates of other processors evaluated on this
+     * processor by the last search because of the redistribution of the
+     * candidates (see \p imbalance_threshold).
+     */
+    unsigned int getNumberOfRemoteCandidates() const
+    {
+        return _n_remote_candidates;
+    }
+
+    /**
+     * Return the number of times the distributed tree was built, i.e., once
+     * by the constructor and once by each call to refit() that rebuilt it.
+     */
+    unsigned int getNumberOfTreeBuilds() const { return _n_tree_builds; }
+
+    /**
+     * Update the search for new coordinates of the points, e.g., particles or
+     * nodes of a moving mesh. The points must be given in the same order as
+     * in the constructor. Each point walks through the mesh, on the processor
+     * owning the cell where it was previously found, starting from this cell:
+     * while the point is not inside the current cell, it moves to the
+     * neighbor across the face it left through. The distributed search is
+     * only performed for the points that leave the local part of the mesh or
+     * that are not found after \p max_steps steps, and for the points that
+     * were not found before.
+     */
+    void relocate( Kokkos::View<Coordinate **, DeviceType> points_coordinates,
+                   unsigned int max_steps = 10 );
+
+    /**
+     * Update the search after the nodes of the mesh moved. The connectivity of
+     * the mesh must not change. The bounding boxes of the cells are recomputed
+     * in place. The first time this function is called, the distributed tree
+     * is rebuilt using bounding boxes enlarged by \p margin times their
+     * largest extent. Afterwards, the tree is only rebuilt when a cell moves
+     * out of its enlarged bounding box on any processor. The points are then
+     * relocated (see relocate()) unless neither the nodes nor the points moved
+     * on any processor since the last update. A zero \p margin rebuilds the
+     * tree at every call.
+     */
+    void refit( Kokkos::View<Coordinate **, DeviceType> nodes_coordinates,
+                Kokkos::View<Coordinate **, DeviceType> points_coordinates,
+                double margin = 0.1 );
+
     /**
      * Perform the distributed search and sends the points and the cell indices
-     * to the processors owning the cells.
+     * to the processors owning the cells. \p point_ids are the query ids
+     * associated to the points. If it is empty, the query ids are the indices
+     * of the points.
      *
      * @note This function should be <b>private</b> but lambda functions can
      * only be called from a public function in CUDA.
@@ -71,7 +141,18 @@ class PointSearch
                Kokkos::View<int *, DeviceType>>
     performDistributedSearch(
         Kokkos::View<Coordinate **, DeviceType> points_coord,
-        Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes );
+        Kokkos::View<int *, DeviceType> point_ids =
+            Kokkos::View<int *, DeviceType>() );
+
+    /**
+     * Build the distributed tree from the bounding boxes of the searched
+     * cells. If \p margin is positive, the bounding boxes are enlarged by \p
+     * margin times their largest extent.
+     *
+     * @note This function should be <b>private</b> but lambda functions can
+     * only be called from a public function in CUDA.
+     */
+    void buildDistributedTree( double margin );
 
     /**
      * Keep cell_indices, points, query_ids, and ranks that satisfy a given
@@ -107,6 +188,37 @@ class PointSearch
         Kokkos::View<int *, DeviceType> filtered_per_topo_ranks,
         unsigned int topo_id );
 
+    /**
+     * Only keep the owner of the points found in multiple cells. The other
+     * hits are removed so that each point is interpolated and sent back
+     * exactly once.
+     *
+     * @note This function should be <b>private</b> but lambda functions can
+     * only be called from a public function in CUDA.
+     */
+    void resolveDuplicates(
+        unsigned int n_points,
+        std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO>
+            &filtered_ranks );
+
+    /**
+     * Send the candidates to the processors given in \p export_ranks with the
+     * nodes of their cell. These processors compute the position of the
+     * points in the reference frame and send back the candidates that are
+     * inside their cell. These candidates are added to the results.
+     *
+     * @note This function should be <b>private</b> but lambda functions can
+     * only be called from a public function in CUDA.
+     */
+    void evaluateRemoteCandidates(
+        Kokkos::View<ArborX::Point *, DeviceType> points,
+        Kokkos::View<int *, DeviceType> cell_indices,
+        Kokkos::View<int *, DeviceType> query_ids,
+        Kokkos::View<int *, DeviceType> ranks,
+        std::vector<int> const &export_ranks,
+        std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO>
+            &filtered_ranks );
+
   private:
     /**
      * Compute the number of cells associated to each topology.
@@ -114,12 +226,51 @@ class PointSearch
     std::array<unsigned int, DTK_N_TOPO> computeNCellsPerTopology(
         Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies );
 
+    /**
+     * Compute the position in the reference frame of the candidates of all
+     * the topologies and keep the points that are inside the cells. Return the
+     * ranks owning the points that were found.
+     */
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> searchCandidates(
+        Kokkos::View<ArborX::Point *, DeviceType> imported_points,
+        Kokkos::View<int *, DeviceType> imported_cell_indices,
+        Kokkos::View<int *, DeviceType> imported_query_ids,
+        Kokkos::View<int *, DeviceType> imported_ranks );
+
+    /**
+     * Same as searchCandidates() but all the candidates are evaluated on this
+     * processor. This function does not communicate.
+     */
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO>
+    searchLocalCandidates(
+        Kokkos::View<ArborX::Point *, DeviceType> points,
+        Kokkos::View<int *, DeviceType> cell_indices,
+        Kokkos::View<int *, DeviceType> query_ids,
+        Kokkos::View<int *, DeviceType> ranks );
+
+    /**
+     * Decide if the candidates need to be redistributed. All the processors
+     * take the same decision. The candidates above the average number of
+     * candidates are assigned to the processors below the average. Return the
+     * ranks of the processors where the last \p export_ranks.size()
+     * candidates are evaluated.
+     */
+    bool planRedistribution( unsigned int n_candidates,
+                             std::vector<int> &export_ranks );
+
+    /**
+     * Build the list of the face neighbors of each cell, i.e., the cells
+     * sharing at least dim vertices with it, and the vertices of the shared
+     * faces.
+     */
+    void buildAdjacency();
+
     /**
      * Compute the position in the reference frame of candidates found by the
      * search.
      */
     Kokkos::View<int *, DeviceType> performPointInCell(
-        Kokkos::View<Coordinate ***, DeviceType> cells,
+        BlockCells<DeviceType> const &cells,
         Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell,
         Kokkos::View<int *, DeviceType> imported_cell_indices,
         Kokkos::View<ArborX::Point *, DeviceType> imported_points,
@@ -139,12 +290,45 @@ class PointSearch
 
     MPI_Comm _comm;
     ArborX::Details::Distributor<DeviceType> _target_to_source_distributor;
+    Mesh<DeviceType> _mesh;
+    std::array<BlockCells<DeviceType>, DTK_N_TOPO> _block_cells;
+    Kokkos::View<unsigned int **, DeviceType> _bounding_box_to_cell;
+    Kokkos::View<ArborX::Box *, DeviceType> _bounding_boxes;
+    std::unique_ptr<ArborX::DistributedSearchTree<DeviceType>>
+        _distributed_tree;
+    // Cells searched by _distributed_tree, i.e., all the cells or only the
+    // cells on the boundary
+    Kokkos::View<int *, DeviceType> _tree_cells;
+    // Bounding boxes of _tree_cells used to build _distributed_tree. They are
+    // enlarged by _tree_margin after the first call to refit().
+    Kokkos::View<ArborX::Box *, DeviceType> _tree_bounding_boxes;
+    double _tree_margin = 0.;
+    // Copies of the coordinates of the nodes and of the points used by the
+    // last call to refit() and relocate() to detect if they moved
+    Kokkos::View<Coordinate **, DeviceType> _nodes_coordinates;
+    Kokkos::View<Coordinate **, DeviceType> _points_coordinates;
+    double _imbalance_threshold;
+    unsigned int _n_remote_candidates = 0;
+    unsigned int _n_tree_builds = 0;
     unsigned int _dim;
     std::array<Kokkos::View<Coordinate **, DeviceType>, DTK_N_TOPO>
         _reference_points;
     std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> _query_ids;
     std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> _cell_indices;
     std::array<std::vector<unsigned int>, DTK_N_TOPO> _cell_indices_map;
+    // Rank and cell index owning each point. The rank is
+    // std::numeric_limits<int>::max() if the point was not found.
+    std::vector<int> _owner_ranks;
+    std::vector<int> _owner_cells;
+    // Face neighbors of each cell (CSR format) and vertices of the face shared
+    // with each neighbor (CSR format over the neighbors). The adjacency is only
+    // built if the points are relocated.
+    Kokkos::View<unsigned int *, DeviceType> _adjacency_offsets;
+    Kokkos::View<int *, DeviceType> _adjacent_cells;
+    Kokkos::View<unsigned int *, DeviceType> _face_node_offsets;
+    Kokkos::View<unsigned int *, DeviceType> _face_nodes;
+    // Position in Mesh::cells of the first node of each cell (n cells + 1)
+    Kokkos::View<unsigned int *, DeviceType> _cell_node_offsets;
 };
 } // namespace DataTransferKit
 
@@ -20,6 +20,16 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 namespace DataTransferKit
 {
 namespace internal
@@ -114,7 +124,8 @@ moveDataFromSourceToTarget(
     MPI_Comm comm, Kokkos::View<int *, DeviceType> indices,
     Kokkos::View<int *, DeviceType> offset,
     Kokkos::View<int *, DeviceType> ranks,
-    Kokkos::View<Coordinate **, DeviceType> points_coord, unsigned int dim )
+    Kokkos::View<Coordinate **, DeviceType> points_coord,
+    Kokkos::View<int *, DeviceType> point_ids, unsigned int dim )
 {
     using ExecutionSpace = typename DeviceType::execution_space;
 
@@ -133,13 +144,14 @@ moveDataFromSourceToTarget(
         "exported_points", indices_size );
     Kokkos::View<int *, DeviceType> exported_query_ids( "exported_query_ids",
                                                         indices_size );
+    bool const use_point_ids = ( point_ids.extent( 0 ) != 0 );
     Kokkos::parallel_for(
         "duplicate_points",
         Kokkos::RangePolicy<ExecutionSpace>( 0, offset.extent( 0 ) - 1 ),
         KOKKOS_LAMBDA( int const i ) {
             for ( int j = offset( i ); j < offset( i + 1 ); ++j )
             {
-                exported_query_ids( j ) = i;
+                exported_query_ids( j ) = use_point_ids ? point_ids( i ) : i;
                 for ( unsigned int k = 0; k < dim; ++k )
                     exported_points( j )[k] = points_coord( i, k );
             }
@@ -170,14 +182,209 @@ moveDataFromSourceToTarget(
     return std::make_tuple( imported_points, imported_cell_indices,
                             imported_query_ids, imported_ranks );
 }
+
+template <typename DeviceType, typename T>
+Kokkos::View<T *, DeviceType> copyToDevice( std::string const &label,
+                                            std::vector<T> const &values )
+{
+    Kokkos::View<T *, DeviceType> view( label, values.size() );
+    Kokkos::deep_copy( view,
+                       Kokkos::View<T const *, Kokkos::HostSpace,
+                                    Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                           values.data(), values.size() ) );
+
+    return view;
+}
+
+template <typename T, typename DeviceType>
+Kokkos::View<T *, DeviceType> concatenate( Kokkos::View<T *, DeviceType> a,
+                                           Kokkos::View<T *, DeviceType> b )
+{
+    unsigned int const size_a = a.extent( 0 );
+    unsigned int const size_b = b.extent( 0 );
+    Kokkos::View<T *, DeviceType> c( a.label(), size_a + size_b );
+    if ( size_a != 0 )
+        Kokkos::deep_copy(
+            Kokkos::subview( c, Kokkos::make_pair( 0u, size_a ) ), a );
+    if ( size_b != 0 )
+        Kokkos::deep_copy(
+            Kokkos::subview( c, Kokkos::make_pair( size_a, size_a + size_b ) ),
+            b );
+
+    return c;
+}
+
+template <typename T, typename DeviceType>
+Kokkos::View<T **, DeviceType> concatenate( Kokkos::View<T **, DeviceType> a,
+                                            Kokkos::View<T **, DeviceType> b,
+                                            unsigned int const dim )
+{
+    unsigned int const size_a = a.extent( 0 );
+    unsigned int const size_b = b.extent( 0 );
+    Kokkos::View<T **, DeviceType> c( a.label(), size_a + size_b, dim );
+    if ( size_a != 0 )
+        Kokkos::deep_copy( Kokkos::subview( c, Kokkos::make_pair( 0u, size_a ),
+                                            Kokkos::ALL() ),
+                           a );
+    if ( size_b != 0 )
+        Kokkos::deep_copy(
+            Kokkos::subview( c, Kokkos::make_pair( size_a, size_a + size_b ),
+                             Kokkos::ALL() ),
+            b );
+
+    return c;
+}
+
+// Number of vertices of the cells of a given topology. The vertices are the
+// first nodes of the cells.
+inline unsigned int nVertices( DTK_CellTopology const topo )
+{
+    switch ( topo )
+    {
+    case DTK_TRI_3:
+    case DTK_TRI_6:
+        return 3;
+    case DTK_QUAD_4:
+    case DTK_QUAD_9:
+    case DTK_TET_4:
+    case DTK_TET_10:
+    case DTK_TET_11:
+        return 4;
+    case DTK_PYRAMID_5:
+    case DTK_PYRAMID_13:
+        return 5;
+    case DTK_WEDGE_6:
+    case DTK_WEDGE_15:
+    case DTK_WEDGE_18:
+        return 6;
+    default:
+        return 8;
+    }
+}
+
+// Compute the center of the nodes nodes(begin), ..., nodes(end - 1).
+template <typename NodesView, typename CoordinatesView>
+KOKKOS_INLINE_FUNCTION void
+computeCenter( NodesView const &nodes, unsigned int const begin,
+               unsigned int const end, CoordinatesView const &coordinates,
+               unsigned int const dim, double center[3] )
+{
+    for ( unsigned int d = 0; d < 3; ++d )
+        center[d] = 0.;
+    for ( unsigned int k = begin; k < end; ++k )
+        for ( unsigned int d = 0; d < dim; ++d )
+            center[d] += coordinates( nodes( k ), d );
+    for ( unsigned int d = 0; d < dim; ++d )
+        center[d] /= ( end - begin );
+}
+
+// Return true if the Views, of the same size, have different values.
+template <typename DeviceType>
+bool differ( Kokkos::View<Coordinate **, DeviceType> a,
+             Kokkos::View<Coordinate **, DeviceType> b )
+{
+    DTK_REQUIRE( a.extent( 0 ) == b.extent( 0 ) );
+    DTK_REQUIRE( a.extent( 1 ) == b.extent( 1 ) );
+
+    using ExecutionSpace = typename DeviceType::execution_space;
+    unsigned int const dim = a.extent( 1 );
+    int n_differences = 0;
+    Kokkos::parallel_reduce(
+        DTK_MARK_REGION( "count_differences" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, a.extent( 0 ) ),
+        KOKKOS_LAMBDA( int const i, int &partial_sum ) {
+            for ( unsigned int d = 0; d < dim; ++d )
+                if ( a( i, d ) != b( i, d ) )
+                {
+                    partial_sum += 1;
+                    break;
+                }
+        },
+        n_differences );
+
+    return n_differences != 0;
+}
+
+//  Return parameters points, cell_indices, query_ids, ranks
+template <typename DeviceType>
+std::tuple<Kokkos::View<ArborX::Point *, DeviceType>,
+           Kokkos::View<int *, DeviceType>, Kokkos::View<int *, DeviceType>,
+           Kokkos::View<int *, DeviceType>>
+movePointsToCells( MPI_Comm comm, std::vector<int> const &cell_ranks,
+                   std::vector<int> const &cell_indices,
+                   std::vector<int> const &query_ids,
+                   Kokkos::View<Coordinate **, DeviceType> points_coord )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+    ArborX::Details::Distributor<DeviceType> distributor( comm );
+    unsigned int const n_imports = distributor.createFromSends(
+        Kokkos::DefaultHostExecutionSpace{},
+        Kokkos::View<int const *, Kokkos::HostSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+            cell_ranks.data(), cell_ranks.size() ) );
+
+    unsigned int const n_exports = cell_ranks.size();
+    auto exported_cell_indices =
+        copyToDevice<DeviceType>( "exported_cell_indices", cell_indices );
+    auto exported_query_ids =
+        copyToDevice<DeviceType>( "exported_query_ids", query_ids );
+    Kokkos::View<ArborX::Point *, DeviceType> exported_points(
+        "exported_points", n_exports );
+    Kokkos::parallel_for( DTK_MARK_REGION( "fill_exported_points" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_exports ),
+                          KOKKOS_LAMBDA( int const i ) {
+                              for ( unsigned int d = 0; d < 3; ++d )
+                                  exported_points( i )[d] = points_coord(
+                                      exported_query_ids( i ), d );
+                          } );
+    Kokkos::fence();
+    Kokkos::View<int *, DeviceType> exported_ranks( "exported_ranks",
+                                                    n_exports );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    Kokkos::deep_copy( exported_ranks, comm_rank );
+
+    Kokkos::View<ArborX::Point *, DeviceType> imported_points(
+        "imported_points", n_imports );
+    Kokkos::View<int *, DeviceType> imported_cell_indices( "imported_indices",
+                                                           n_imports );
+    Kokkos::View<int *, DeviceType> imported_query_ids( "imported_query_ids",
+                                                        n_imports );
+    Kokkos::View<int *, DeviceType> imported_ranks( "ranks", n_imports );
+
+    sendDataAcrossNetwork(
+        distributor, std::make_pair( exported_points, imported_points ),
+        std::make_pair( exported_cell_indices, imported_cell_indices ),
+        std::make_pair( exported_query_ids, imported_query_ids ),
+        std::make_pair( exported_ranks, imported_ranks ) );
+
+    return std::make_tuple( imported_points, imported_cell_indices,
+                            imported_query_ids, imported_ranks );
+}
 } // namespace internal
 
 template <typename DeviceType>
 PointSearch<DeviceType>::PointSearch(
     MPI_Comm comm, Mesh<DeviceType> const &mesh,
-    Kokkos::View<Coordinate **, DeviceType> points_coordinates )
+    Kokkos::View<Coordinate **, DeviceType> points_coordinates,
+    double imbalance_threshold )
+    : PointSearch( comm, mesh,
+                   Discretization::Helpers::getAllCells( mesh.cell_topologies ),
+                   points_coordinates, imbalance_threshold )
+{
+}
+
+template <typename DeviceType>
+PointSearch<DeviceType>::PointSearch(
+    MPI_Comm comm, Mesh<DeviceType> const &mesh,
+    Kokkos::View<LocalOrdinal *, DeviceType> boundary_cells,
+    Kokkos::View<Coordinate **, DeviceType> points_coordinates,
+    double imbalance_threshold )
     : _comm( comm )
     , _target_to_source_distributor( _comm )
+    , _mesh( mesh )
+    , _imbalance_threshold( imbalance_threshold )
 {
     DTK_REQUIRE( points_coordinates.extent( 1 ) ==
                  mesh.nodes_coordinates.extent( 1 ) );
@@ -191,33 +398,37 @@ PointSearch<DeviceType>::PointSearch(
     // Compute the topology and node offset
     Discretization::Helpers::MeshOffsets<DeviceType> mesh_offsets( mesh );
 
-    // Convert the cells and cell_nodes_coordinates View to block_cells
-    auto n_nodes_per_topo_host =
-        Kokkos::create_mirror_view( mesh_offsets.n_nodes_per_topo );
-    Kokkos::deep_copy( n_nodes_per_topo_host, mesh_offsets.n_nodes_per_topo );
-    std::array<Kokkos::View<Coordinate ***, DeviceType>, DTK_N_TOPO>
-        block_cells;
-    for ( int i = 0; i < DTK_N_TOPO; ++i )
-    {
-        block_cells[i] = Kokkos::View<Coordinate ***, DeviceType>(
-            "block_cells_" + std::to_string( i ), n_cells_per_topo[i],
-            n_nodes_per_topo_host( i ), _dim );
-    }
-    Discretization::Helpers::convertMesh( mesh, mesh_offsets, block_cells );
+    // Group the cells by topology. The nodes are accessed through the
+    // connectivity of the mesh so that their coordinates are not duplicated.
+    _block_cells = Discretization::Helpers::buildBlockCells(
+        mesh, mesh_offsets, n_cells_per_topo );
 
     // Initialize bounding_box_to_cell to an invalid state
-    Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell(
+    _bounding_box_to_cell = Kokkos::View<unsigned int **, DeviceType>(
         "bounding_box_to_cell", mesh.cell_topologies.extent( 0 ), DTK_N_TOPO );
-    Kokkos::deep_copy( bounding_box_to_cell, static_cast<unsigned int>( -1 ) );
+    Kokkos::deep_copy( _bounding_box_to_cell,
+                       static_cast<unsigned int>( -1 ) );
 
-    Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes(
+    _bounding_boxes = Kokkos::View<ArborX::Box *, DeviceType>(
         "bounding_boxes", mesh.cell_topologies.extent( 0 ) );
     Discretization::Helpers::createBoundingBoxes(
-        mesh, mesh_offsets, block_cells, bounding_boxes, bounding_box_to_cell );
+        mesh, mesh_offsets, _bounding_boxes, _bounding_box_to_cell );
+
+    // A cell may have several faces on the boundary
+    auto boundary_cells_host = Kokkos::create_mirror_view( boundary_cells );
+    Kokkos::deep_copy( boundary_cells_host, boundary_cells );
+    std::vector<int> tree_cells( boundary_cells_host.data(),
+                                 boundary_cells_host.data() +
+                                     boundary_cells_host.extent( 0 ) );
+    std::sort( tree_cells.begin(), tree_cells.end() );
+    tree_cells.erase( std::unique( tree_cells.begin(), tree_cells.end() ),
+                      tree_cells.end() );
+    _tree_cells =
+        internal::copyToDevice<DeviceType>( "tree_cells", tree_cells );
+    buildDistributedTree( 0. );
 
     // Perform the distributed search. At the end of the distributed search the
     // points are moved from the "source processors" to the "target processors".
-    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> per_topo_ranks;
     Kokkos::View<ArborX::Point *, DeviceType> imported_points;
     Kokkos::View<int *, DeviceType> imported_query_ids;
     Kokkos::View<int *, DeviceType> imported_cell_indices;
@@ -226,33 +437,12 @@ PointSearch<DeviceType>::PointSearch(
               imported_ranks ) =
         performDistributedSearch(
             ( _dim == 3 ) ? points_coordinates
-                          : internal::convertPointDim( points_coordinates ),
-            bounding_boxes );
+                          : internal::convertPointDim( points_coordinates ) );
 
-    // We need to separate the data for the different topologies because of
-    // Intrepid2. Because a point can be found in multiple cells, we need to
-    // compute the number of cells of each topology.
-    unsigned int const n_imports = imported_points.extent( 0 );
-    Kokkos::View<unsigned int *, DeviceType> topo( "topo", n_imports );
-    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> topo_size( "topo_size" );
-    internal::buildTopo( imported_cell_indices, bounding_box_to_cell, topo,
-                         topo_size );
-    auto topo_size_host = Kokkos::create_mirror_view( topo_size );
-    Kokkos::deep_copy( topo_size_host, topo_size );
-
-    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> filtered_ranks;
     // Check if the points are in the cells
-    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
-        if ( block_cells[topo_id].extent( 0 ) != 0 )
-        {
-            filtered_ranks[topo_id] = performPointInCell(
-                block_cells[topo_id], bounding_box_to_cell,
-                imported_cell_indices, imported_points, imported_query_ids,
-                imported_ranks, topo, topo_id, topo_size_host( topo_id ) );
-        }
-
-    // Build the _source_to_target_distributor
-    build_distributor( filtered_ranks );
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> filtered_ranks =
+        searchCandidates( imported_points, imported_cell_indices,
+                          imported_query_ids, imported_ranks );
 
     // Build a map between the cell_indices sorted by topology and the flat View
     // given to the constructor
@@ -262,6 +452,12 @@ PointSearch<DeviceType>::PointSearch(
     unsigned int const size = cell_topologies_host.extent( 0 );
     for ( unsigned int i = 0; i < size; ++i )
         _cell_indices_map[cell_topologies_host( i )].push_back( i );
+
+    // Remove the points found in multiple cells
+    resolveDuplicates( points_coordinates.extent( 0 ), filtered_ranks );
+
+    // Build the _source_to_target_distributor
+    build_distributor( filtered_ranks );
 }
 
 template <typename DeviceType>
@@ -378,12 +574,11 @@ std::tuple<Kokkos::View<ArborX::Point *, DeviceType>,
            Kokkos::View<int *, DeviceType>> PointSearch<DeviceType>::
     performDistributedSearch(
         Kokkos::View<Coordinate **, DeviceType> points_coord,
-        Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes )
+        Kokkos::View<int *, DeviceType> point_ids )
 {
     DTK_REQUIRE( points_coord.extent( 1 ) == 3 );
-
-    ArborX::DistributedSearchTree<DeviceType> distributed_tree(
-        _comm, bounding_boxes );
+    DTK_REQUIRE( ( point_ids.extent( 0 ) == 0 ) ||
+                 ( point_ids.extent( 0 ) == points_coord.extent( 0 ) ) );
 
     unsigned int const n_points = points_coord.extent( 0 );
 
@@ -407,11 +602,21 @@ std::tuple<Kokkos::View<ArborX::Point *, DeviceType>,
     Kokkos::View<int *, DeviceType> indices( "indices", 0 );
     Kokkos::View<int *, DeviceType> offset( "offset", 0 );
     Kokkos::View<int *, DeviceType> ranks( "ranks", 0 );
-    distributed_tree.query( queries, indices, offset, ranks );
+    _distributed_tree->query( queries, indices, offset, ranks );
+
+    // Convert the positions in the tree to cell indices
+    unsigned int const n_indices = indices.extent( 0 );
+    auto tree_cells = _tree_cells;
+    Kokkos::parallel_for( DTK_MARK_REGION( "convert_tree_indices" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_indices ),
+                          KOKKOS_LAMBDA( int const i ) {
+                              indices( i ) = tree_cells( indices( i ) );
+                          } );
+    Kokkos::fence();
 
     // Move the points from the source processors to the target processors
-    return internal::moveDataFromSourceToTarget( _comm, indices, offset, ranks,
-                                                 points_coord, _dim );
+    return internal::moveDataFromSourceToTarget(
+        _comm, indices, offset, ranks, points_coord, point_ids, _dim );
 }
 
 template <typename DeviceType>
@@ -538,7 +743,7 @@ Kokkos::View<int *, DeviceType> PointSearch<DeviceType>::filterInCell(
 
 template <typename DeviceType>
 Kokkos::View<int *, DeviceType> PointSearch<DeviceType>::performPointInCell(
-    Kokkos::View<Coordinate ***, DeviceType> cells,
+    BlockCells<DeviceType> const &cells,
     Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell,
     Kokkos::View<int *, DeviceType> imported_cell_indices,
     Kokkos::View<ArborX::Point *, DeviceType> imported_points,
@@ -558,6 +763,14 @@ Kokkos::View<int *, DeviceType> PointSearch<DeviceType>::performPointInCell(
                         imported_cell_indices, imported_points,
                         imported_query_ids, imported_ranks );
 
+    // The candidates are ordered by query. Group them by cell so that the
+    // nodes of a cell are loaded by consecutive threads instead of being
+    // reloaded from all over memory.
+    ArborX::Details::DistributedSearchTreeImpl<DeviceType>::sortResults(
+        typename DeviceType::execution_space{}, filtered_per_topo_cell_indices,
+        filtered_per_topo_cell_indices, filtered_per_topo_points,
+        filtered_per_topo_query_ids, filtered_per_topo_ranks );
+
     // Perform the PointInCell search
     Topologies topologies;
     Kokkos::View<Coordinate **, DeviceType> filtered_per_topo_reference_points(
@@ -580,6 +793,1133 @@ Kokkos::View<int *, DeviceType> PointSearch<DeviceType>::performPointInCell(
     return filtered_ranks;
 }
 
+template <typename DeviceType>
+void PointSearch<DeviceType>::resolveDuplicates(
+    unsigned int n_points,
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> &filtered_ranks )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    int comm_rank;
+    MPI_Comm_rank( _comm, &comm_rank );
+
+    // Flatten the hits of all the topologies. This is done on the host because
+    // _cell_indices_map only exists on the host.
+    std::vector<int> hit_ranks;
+    std::vector<int> hit_query_ids;
+    std::vector<unsigned int> hit_cells;
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+    {
+        auto ranks_host = Kokkos::create_mirror_view( filtered_ranks[topo_id] );
+        Kokkos::deep_copy( ranks_host, filtered_ranks[topo_id] );
+        auto query_ids_host = Kokkos::create_mirror_view( _query_ids[topo_id] );
+        Kokkos::deep_copy( query_ids_host, _query_ids[topo_id] );
+        auto cell_indices_host =
+            Kokkos::create_mirror_view( _cell_indices[topo_id] );
+        Kokkos::deep_copy( cell_indices_host, _cell_indices[topo_id] );
+        unsigned int const size = _query_ids[topo_id].extent( 0 );
+        for ( unsigned int i = 0; i < size; ++i )
+        {
+            hit_ranks.push_back( ranks_host( i ) );
+            hit_query_ids.push_back( query_ids_host( i ) );
+            hit_cells.push_back(
+                _cell_indices_map[topo_id][cell_indices_host( i )] );
+        }
+    }
+    unsigned int const n_hits = hit_ranks.size();
+
+    // A point found in several cells of this rank is owned by the cell with
+    // the lowest index.
+    std::vector<unsigned int> permutation( n_hits );
+    std::iota( permutation.begin(), permutation.end(), 0 );
+    std::sort( permutation.begin(), permutation.end(),
+               [&]( unsigned int const a, unsigned int const b ) {
+                   return std::make_tuple( hit_ranks[a], hit_query_ids[a],
+                                           hit_cells[a] ) <
+                          std::make_tuple( hit_ranks[b], hit_query_ids[b],
+                                           hit_cells[b] );
+               } );
+    std::vector<int> export_ranks;
+    std::vector<int> export_query_ids;
+    std::vector<int> export_hit_ids;
+    std::vector<int> export_cells;
+    for ( unsigned int k = 0; k < n_hits; ++k )
+    {
+        unsigned int const i = permutation[k];
+        if ( ( k == 0 ) || ( hit_ranks[i] != hit_ranks[permutation[k - 1]] ) ||
+             ( hit_query_ids[i] != hit_query_ids[permutation[k - 1]] ) )
+        {
+            export_ranks.push_back( hit_ranks[i] );
+            export_query_ids.push_back( hit_query_ids[i] );
+            export_hit_ids.push_back( i );
+            export_cells.push_back( hit_cells[i] );
+        }
+    }
+
+    // Send the remaining candidates to the processors owning the points. These
+    // processors select the candidates on the lowest rank.
+    Kokkos::DefaultHostExecutionSpace host_space;
+    ArborX::Details::Distributor<DeviceType> candidates_distributor( _comm );
+    unsigned int const n_candidates = candidates_distributor.createFromSends(
+        host_space, Kokkos::View<int const *, Kokkos::HostSpace,
+                                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                        export_ranks.data(), export_ranks.size() ) );
+    unsigned int const n_exports = export_ranks.size();
+    auto exported_query_ids =
+        internal::copyToDevice<DeviceType>( "exported_query_ids",
+                                            export_query_ids );
+    auto exported_hit_ids = internal::copyToDevice<DeviceType>(
+        "exported_hit_ids", export_hit_ids );
+    auto exported_cells =
+        internal::copyToDevice<DeviceType>( "exported_cells", export_cells );
+    Kokkos::View<int *, DeviceType> exported_source_ranks(
+        "exported_source_ranks", n_exports );
+    Kokkos::deep_copy( exported_source_ranks, comm_rank );
+
+    Kokkos::View<int *, DeviceType> candidate_query_ids( "candidate_query_ids",
+                                                         n_candidates );
+    Kokkos::View<int *, DeviceType> candidate_hit_ids( "candidate_hit_ids",
+                                                       n_candidates );
+    Kokkos::View<int *, DeviceType> candidate_source_ranks(
+        "candidate_source_ranks", n_candidates );
+    Kokkos::View<int *, DeviceType> candidate_cells( "candidate_cells",
+                                                     n_candidates );
+    internal::sendDataAcrossNetwork(
+        candidates_distributor,
+        std::make_pair( exported_query_ids, candidate_query_ids ),
+        std::make_pair( exported_hit_ids, candidate_hit_ids ),
+        std::make_pair( exported_source_ranks, candidate_source_ranks ),
+        std::make_pair( exported_cells, candidate_cells ) );
+
+    auto candidate_query_ids_host =
+        Kokkos::create_mirror_view( candidate_query_ids );
+    Kokkos::deep_copy( candidate_query_ids_host, candidate_query_ids );
+    auto candidate_source_ranks_host =
+        Kokkos::create_mirror_view( candidate_source_ranks );
+    Kokkos::deep_copy( candidate_source_ranks_host, candidate_source_ranks );
+    auto candidate_cells_host = Kokkos::create_mirror_view( candidate_cells );
+    Kokkos::deep_copy( candidate_cells_host, candidate_cells );
+    _owner_ranks.assign( n_points, std::numeric_limits<int>::max() );
+    _owner_cells.assign( n_points, -1 );
+    for ( unsigned int i = 0; i < n_candidates; ++i )
+    {
+        int &owner_rank = _owner_ranks[candidate_query_ids_host( i )];
+        owner_rank = std::min( owner_rank, candidate_source_ranks_host( i ) );
+    }
+    Kokkos::View<int *, DeviceType> accepted( "accepted", n_candidates );
+    auto accepted_host = Kokkos::create_mirror_view( accepted );
+    for ( unsigned int i = 0; i < n_candidates; ++i )
+    {
+        int const query_id = candidate_query_ids_host( i );
+        accepted_host( i ) =
+            ( candidate_source_ranks_host( i ) == _owner_ranks[query_id] );
+        if ( accepted_host( i ) )
+            _owner_cells[query_id] = candidate_cells_host( i );
+    }
+    Kokkos::deep_copy( accepted, accepted_host );
+
+    // Send the decision back to the processors owning the cells
+    ArborX::Details::Distributor<DeviceType> decisions_distributor( _comm );
+    unsigned int const n_decisions = decisions_distributor.createFromSends(
+        host_space, Kokkos::View<int const *, Kokkos::HostSpace,
+                                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                        candidate_source_ranks_host.data(), n_candidates ) );
+    DTK_CHECK( n_decisions == n_exports );
+    Kokkos::View<int *, DeviceType> decision_hit_ids( "decision_hit_ids",
+                                                      n_decisions );
+    Kokkos::View<int *, DeviceType> decisions( "decisions", n_decisions );
+    internal::sendDataAcrossNetwork(
+        decisions_distributor,
+        std::make_pair( candidate_hit_ids, decision_hit_ids ),
+        std::make_pair( accepted, decisions ) );
+
+    Kokkos::View<int *, DeviceType> keep( "keep", n_hits );
+    Kokkos::parallel_for( DTK_MARK_REGION( "fill_keep" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_decisions ),
+                          KOKKOS_LAMBDA( int const i ) {
+                              keep( decision_hit_ids( i ) ) = decisions( i );
+                          } );
+    Kokkos::fence();
+
+    // Remove the hits that are not owned
+    unsigned int dim = _dim;
+    unsigned int topo_offset = 0;
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+    {
+        unsigned int const size = _query_ids[topo_id].extent( 0 );
+        if ( size == 0 )
+            continue;
+
+        Kokkos::View<int *, DeviceType> topo_keep(
+            keep, Kokkos::make_pair( topo_offset, topo_offset + size ) );
+        Kokkos::View<unsigned int *, DeviceType> offset( "offset", size );
+        Discretization::Helpers::computeOffset( topo_keep, 1, offset );
+        unsigned int const n_kept =
+            ArborX::lastElement( offset ) + ArborX::lastElement( topo_keep );
+
+        Kokkos::View<Coordinate **, DeviceType> ref_points(
+            _reference_points[topo_id].label(), n_kept, _dim );
+        Kokkos::View<int *, DeviceType> query_ids( _query_ids[topo_id].label(),
+                                                   n_kept );
+        Kokkos::View<int *, DeviceType> cell_indices(
+            _cell_indices[topo_id].label(), n_kept );
+        Kokkos::View<int *, DeviceType> ranks( filtered_ranks[topo_id].label(),
+                                               n_kept );
+        auto topo_ref_points = _reference_points[topo_id];
+        auto topo_query_ids = _query_ids[topo_id];
+        auto topo_cell_indices = _cell_indices[topo_id];
+        auto topo_ranks = filtered_ranks[topo_id];
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "remove_duplicates" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, size ),
+            KOKKOS_LAMBDA( int const i ) {
+                if ( topo_keep( i ) == 1 )
+                {
+                    unsigned int const k = offset( i );
+                    for ( unsigned int d = 0; d < dim; ++d )
+                        ref_points( k, d ) = topo_ref_points( i, d );
+                    query_ids( k ) = topo_query_ids( i );
+                    cell_indices( k ) = topo_cell_indices( i );
+                    ranks( k ) = topo_ranks( i );
+                }
+            } );
+        Kokkos::fence();
+
+        _reference_points[topo_id] = ref_points;
+        _query_ids[topo_id] = query_ids;
+        _cell_indices[topo_id] = cell_indices;
+        filtered_ranks[topo_id] = ranks;
+        topo_offset += size;
+    }
+}
+
+template <typename DeviceType>
+void PointSearch<DeviceType>::relocate(
+    Kokkos::View<Coordinate **, DeviceType> points_coordinates,
+    unsigned int max_steps )
+{
+    DTK_REQUIRE( points_coordinates.extent( 0 ) == _owner_ranks.size() );
+    DTK_REQUIRE( points_coordinates.extent( 1 ) == _dim );
+
+    using ExecutionSpace = typename DeviceType::execution_space;
+    unsigned int const n_points = points_coordinates.extent( 0 );
+    Kokkos::View<Coordinate **, DeviceType> points_coord =
+        ( _dim == 3 ) ? points_coordinates
+                      : internal::convertPointDim( points_coordinates );
+
+    if ( _adjacency_offsets.extent( 0 ) == 0 )
+        buildAdjacency();
+
+    // Send the points that have been found to the processors owning the cells
+    // where they were found.
+    std::vector<int> owner_ranks;
+    std::vector<int> owner_cells;
+    std::vector<int> owned_query_ids;
+    std::vector<int> lost_query_ids;
+    for ( unsigned int i = 0; i < n_points; ++i )
+        if ( _owner_ranks[i] != std::numeric_limits<int>::max() )
+        {
+            owner_ranks.push_back( _owner_ranks[i] );
+            owner_cells.push_back( _owner_cells[i] );
+            owned_query_ids.push_back( i );
+        }
+        else
+            lost_query_ids.push_back( i );
+    Kokkos::View<ArborX::Point *, DeviceType> imported_points;
+    Kokkos::View<int *, DeviceType> imported_cell_indices;
+    Kokkos::View<int *, DeviceType> imported_query_ids;
+    Kokkos::View<int *, DeviceType> imported_ranks;
+    std::tie( imported_points, imported_cell_indices, imported_query_ids,
+              imported_ranks ) =
+        internal::movePointsToCells( _comm, owner_ranks, owner_cells,
+                                     owned_query_ids, points_coord );
+
+    // Walk from the cell where each point was previously found. The walkers
+    // are the positions in the imported Views of the points that are still
+    // looked for. The walk does not communicate so the processors may perform
+    // a different number of steps.
+    std::array<Kokkos::View<Coordinate **, DeviceType>, DTK_N_TOPO>
+        reference_points;
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> query_ids;
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> cell_indices;
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> ranks;
+    unsigned int const n_imports = imported_points.extent( 0 );
+    Kokkos::View<int *, DeviceType> walkers( "walkers", n_imports );
+    Kokkos::parallel_for( DTK_MARK_REGION( "fill_walkers" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+                          KOKKOS_LAMBDA( int const i ) { walkers( i ) = i; } );
+    Kokkos::fence();
+    Kokkos::View<int *, DeviceType> walker_cells( "walker_cells", n_imports );
+    Kokkos::deep_copy( walker_cells, imported_cell_indices );
+    // Points that need to be searched by the distributed search
+    Kokkos::View<int *, DeviceType> lost( "lost", n_imports );
+    auto adjacency_offsets = _adjacency_offsets;
+    auto adjacent_cells = _adjacent_cells;
+    auto face_node_offsets = _face_node_offsets;
+    auto face_nodes = _face_nodes;
+    auto cell_node_offsets = _cell_node_offsets;
+    auto mesh_cells = _mesh.cells;
+    auto nodes_coordinates = _mesh.nodes_coordinates;
+    unsigned int const dim = _dim;
+    for ( unsigned int step = 0;
+          ( step < max_steps ) && ( walkers.extent( 0 ) != 0 ); ++step )
+    {
+        // Look for the points in their current cell. The query ids are the
+        // positions in walkers and they are replaced by the ids of the points
+        // once the points are found.
+        unsigned int const n_walkers = walkers.extent( 0 );
+        Kokkos::View<ArborX::Point *, DeviceType> walker_points(
+            "walker_points", n_walkers );
+        Kokkos::View<int *, DeviceType> walker_ids( "walker_ids", n_walkers );
+        Kokkos::View<int *, DeviceType> walker_ranks( "walker_ranks",
+                                                      n_walkers );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "fill_walker_points" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_walkers ),
+            KOKKOS_LAMBDA( int const i ) {
+                walker_points( i ) = imported_points( walkers( i ) );
+                walker_ids( i ) = i;
+                walker_ranks( i ) = imported_ranks( walkers( i ) );
+            } );
+        Kokkos::fence();
+        std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> found_ranks =
+            searchLocalCandidates( walker_points, walker_cells, walker_ids,
+                                   walker_ranks );
+        Kokkos::View<int *, DeviceType> found( "found", n_walkers );
+        for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+        {
+            auto topo_query_ids = _query_ids[topo_id];
+            Kokkos::parallel_for(
+                DTK_MARK_REGION( "mark_found_walkers" ),
+                Kokkos::RangePolicy<ExecutionSpace>(
+                    0, topo_query_ids.extent( 0 ) ),
+                KOKKOS_LAMBDA( int const i ) {
+                    int const k = topo_query_ids( i );
+                    found( k ) = 1;
+                    topo_query_ids( i ) = imported_query_ids( walkers( k ) );
+                } );
+            Kokkos::fence();
+
+            reference_points[topo_id] = internal::concatenate(
+                reference_points[topo_id], _reference_points[topo_id], _dim );
+            query_ids[topo_id] =
+                internal::concatenate( query_ids[topo_id], topo_query_ids );
+            cell_indices[topo_id] = internal::concatenate(
+                cell_indices[topo_id], _cell_indices[topo_id] );
+            ranks[topo_id] =
+                internal::concatenate( ranks[topo_id], found_ranks[topo_id] );
+        }
+
+        // Move the points that were not found to the neighbor across the face
+        // they left through, i.e., the face that the point is the furthest
+        // beyond along the direction joining the centers of the two cells.
+        // The points that are not beyond any face shared with a local cell
+        // left the local part of the mesh.
+        Kokkos::View<int *, DeviceType> next_cells( "next_cells", n_walkers );
+        Kokkos::View<int *, DeviceType> moved( "moved", n_walkers );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "walk_to_neighbors" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_walkers ),
+            KOKKOS_LAMBDA( int const i ) {
+                if ( found( i ) == 1 )
+                    return;
+
+                int const cell = walker_cells( i );
+                ArborX::Point const &point = imported_points( walkers( i ) );
+                double cell_center[3];
+                internal::computeCenter(
+                    mesh_cells, cell_node_offsets( cell ),
+                    cell_node_offsets( cell + 1 ), nodes_coordinates, dim,
+                    cell_center );
+                int next_cell = -1;
+                double max_distance = 0.;
+                for ( unsigned int k = adjacency_offsets( cell );
+                      k < adjacency_offsets( cell + 1 ); ++k )
+                {
+                    int const neighbor = adjacent_cells( k );
+                    double neighbor_center[3];
+                    internal::computeCenter(
+                        mesh_cells, cell_node_offsets( neighbor ),
+                        cell_node_offsets( neighbor + 1 ), nodes_coordinates,
+                        dim, neighbor_center );
+                    double face_center[3];
+                    internal::computeCenter(
+                        face_nodes, face_node_offsets( k ),
+                        face_node_offsets( k + 1 ), nodes_coordinates, dim,
+                        face_center );
+                    double distance = 0.;
+                    double norm = 0.;
+                    for ( unsigned int d = 0; d < dim; ++d )
+                    {
+                        double const direction =
+                            neighbor_center[d] - cell_center[d];
+                        distance += ( point[d] - face_center[d] ) * direction;
+                        norm += direction * direction;
+                    }
+                    if ( norm > 0. )
+                        distance /= std::sqrt( norm );
+                    if ( distance > max_distance )
+                    {
+                        max_distance = distance;
+                        next_cell = neighbor;
+                    }
+                }
+                next_cells( i ) = next_cell;
+                if ( next_cell < 0 )
+                    lost( walkers( i ) ) = 1;
+                else
+                    moved( i ) = 1;
+            } );
+        Kokkos::fence();
+
+        // Keep walking with the points that moved
+        Kokkos::View<unsigned int *, DeviceType> offset( "offset", n_walkers );
+        Discretization::Helpers::computeOffset( moved, 1, offset );
+        unsigned int const n_moved =
+            ArborX::lastElement( offset ) + ArborX::lastElement( moved );
+        Kokkos::View<int *, DeviceType> new_walkers( "walkers", n_moved );
+        Kokkos::View<int *, DeviceType> new_walker_cells( "walker_cells",
+                                                          n_moved );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "compact_walkers" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_walkers ),
+            KOKKOS_LAMBDA( int const i ) {
+                if ( moved( i ) == 1 )
+                {
+                    new_walkers( offset( i ) ) = walkers( i );
+                    new_walker_cells( offset( i ) ) = next_cells( i );
+                }
+            } );
+        Kokkos::fence();
+        walkers = new_walkers;
+        walker_cells = new_walker_cells;
+    }
+
+    // The points still walking after max_steps steps are also searched by the
+    // distributed search.
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "mark_lost_walkers" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, walkers.extent( 0 ) ),
+        KOKKOS_LAMBDA( int const i ) { lost( walkers( i ) ) = 1; } );
+    Kokkos::fence();
+    unsigned int n_lost_walkers = 0;
+    Kokkos::View<unsigned int *, DeviceType> lost_offset( "lost_offset",
+                                                          n_imports );
+    if ( n_imports != 0 )
+    {
+        Discretization::Helpers::computeOffset( lost, 1, lost_offset );
+        n_lost_walkers =
+            ArborX::lastElement( lost_offset ) + ArborX::lastElement( lost );
+    }
+    Kokkos::View<int *, DeviceType> lost_ranks( "lost_ranks", n_lost_walkers );
+    Kokkos::View<int *, DeviceType> lost_walker_query_ids(
+        "lost_walker_query_ids", n_lost_walkers );
+    Kokkos::parallel_for( DTK_MARK_REGION( "fill_lost_walkers" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+                          KOKKOS_LAMBDA( int const i ) {
+                              if ( lost( i ) == 1 )
+                              {
+                                  unsigned int const k = lost_offset( i );
+                                  lost_ranks( k ) = imported_ranks( i );
+                                  lost_walker_query_ids( k ) =
+                                      imported_query_ids( i );
+                              }
+                          } );
+    Kokkos::fence();
+
+    // The distributed search is skipped when the walk found all the points
+    // that were found before and no point was lost.
+    int n_searched = n_lost_walkers + lost_query_ids.size();
+    MPI_Allreduce( MPI_IN_PLACE, &n_searched, 1, MPI_INT, MPI_SUM, _comm );
+    if ( n_searched != 0 )
+    {
+        // Send the points that left the local part of the mesh back to the
+        // processors owning them.
+        ArborX::Details::Distributor<DeviceType> lost_distributor( _comm );
+        unsigned int const n_returned =
+            lost_distributor.createFromSends( ExecutionSpace{}, lost_ranks );
+        Kokkos::View<int *, DeviceType> returned_query_ids(
+            "returned_query_ids", n_returned );
+        internal::sendDataAcrossNetwork(
+            lost_distributor,
+            std::make_pair( lost_walker_query_ids, returned_query_ids ) );
+
+        // Perform the distributed search for the points that left the local
+        // part of the mesh and for the points that were not found before.
+        auto lost_ids = internal::concatenate(
+            internal::copyToDevice<DeviceType>( "lost_query_ids",
+                                                lost_query_ids ),
+            returned_query_ids );
+        unsigned int const n_lost = lost_ids.extent( 0 );
+        Kokkos::View<Coordinate **, DeviceType> lost_points( "lost_points",
+                                                             n_lost, 3 );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "fill_lost_points" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_lost ),
+            KOKKOS_LAMBDA( int const i ) {
+                for ( unsigned int d = 0; d < 3; ++d )
+                    lost_points( i, d ) = points_coord( lost_ids( i ), d );
+            } );
+        Kokkos::fence();
+        std::tie( imported_points, imported_cell_indices, imported_query_ids,
+                  imported_ranks ) =
+            performDistributedSearch( lost_points, lost_ids );
+        std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> found_ranks =
+            searchCandidates( imported_points, imported_cell_indices,
+                              imported_query_ids, imported_ranks );
+        for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+        {
+            reference_points[topo_id] = internal::concatenate(
+                reference_points[topo_id], _reference_points[topo_id], _dim );
+            query_ids[topo_id] = internal::concatenate( query_ids[topo_id],
+                                                        _query_ids[topo_id] );
+            cell_indices[topo_id] = internal::concatenate(
+                cell_indices[topo_id], _cell_indices[topo_id] );
+            ranks[topo_id] =
+                internal::concatenate( ranks[topo_id], found_ranks[topo_id] );
+        }
+    }
+    _reference_points = reference_points;
+    _query_ids = query_ids;
+    _cell_indices = cell_indices;
+
+    // Remove the points found in multiple cells and rebuild the distributor
+    resolveDuplicates( n_points, ranks );
+    build_distributor( ranks );
+
+    // Keep a copy of the points to detect if they moved in refit()
+    if ( _points_coordinates.extent( 1 ) == 0 )
+        _points_coordinates = Kokkos::View<Coordinate **, DeviceType>(
+            "points_coordinates", n_points, _dim );
+    Kokkos::deep_copy( _points_coordinates, points_coordinates );
+}
+
+template <typename DeviceType>
+void PointSearch<DeviceType>::refit(
+    Kokkos::View<Coordinate **, DeviceType> nodes_coordinates,
+    Kokkos::View<Coordinate **, DeviceType> points_coordinates, double margin )
+{
+    DTK_REQUIRE( nodes_coordinates.extent( 0 ) ==
+                 _mesh.nodes_coordinates.extent( 0 ) );
+    DTK_REQUIRE( nodes_coordinates.extent( 1 ) == _dim );
+
+    // Update the coordinates of the nodes. The cells are accessed through the
+    // connectivity which does not change. The coordinates are copied since the
+    // application may update its View in place.
+    int nodes_moved = 1;
+    if ( _nodes_coordinates.extent( 1 ) == 0 )
+        _nodes_coordinates = Kokkos::View<Coordinate **, DeviceType>(
+            "nodes_coordinates", nodes_coordinates.extent( 0 ), _dim );
+    else
+        nodes_moved = internal::differ( _nodes_coordinates, nodes_coordinates );
+    if ( nodes_moved )
+        Kokkos::deep_copy( _nodes_coordinates, nodes_coordinates );
+    _mesh.nodes_coordinates = _nodes_coordinates;
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+        _block_cells[topo_id].nodes_coordinates = _nodes_coordinates;
+
+    // Recompute the bounding boxes in place
+    if ( nodes_moved )
+    {
+        Discretization::Helpers::MeshOffsets<DeviceType> mesh_offsets( _mesh );
+        Discretization::Helpers::createBoundingBoxes(
+            _mesh, mesh_offsets, _bounding_boxes, _bounding_box_to_cell );
+    }
+
+    // Check if the cells are still inside the bounding boxes used to build the
+    // tree. Since the tree is distributed, it is rebuilt on all the processors
+    // as soon as one cell moved out.
+    int rebuild_tree = 1;
+    if ( _tree_margin > 0. )
+    {
+        using ExecutionSpace = typename DeviceType::execution_space;
+        auto bounding_boxes = _bounding_boxes;
+        auto tree_bounding_boxes = _tree_bounding_boxes;
+        auto tree_cells = _tree_cells;
+        int n_moved_out = 0;
+        if ( nodes_moved )
+            Kokkos::parallel_reduce(
+                DTK_MARK_REGION( "check_tree_bounding_boxes" ),
+                Kokkos::RangePolicy<ExecutionSpace>( 0,
+                                                     tree_cells.extent( 0 ) ),
+                KOKKOS_LAMBDA( int const i, int &partial_sum ) {
+                    ArborX::Box const &box = bounding_boxes( tree_cells( i ) );
+                    bool moved_out = false;
+                    for ( unsigned int d = 0; d < 3; ++d )
+                        if ( ( box.minCorner()[d] <
+                               tree_bounding_boxes( i ).minCorner()[d] ) ||
+                             ( box.maxCorner()[d] >
+                               tree_bounding_boxes( i ).maxCorner()[d] ) )
+                            moved_out = true;
+                    if ( moved_out )
+                        partial_sum += 1;
+                },
+                n_moved_out );
+        rebuild_tree = ( n_moved_out != 0 );
+    }
+
+    // The points are relocated only if the nodes or the points moved on any
+    // processor.
+    int const points_moved =
+        ( _points_coordinates.extent( 1 ) == 0 ) ||
+        internal::differ( _points_coordinates, points_coordinates );
+    std::array<int, 2> updates = {{rebuild_tree, nodes_moved || points_moved}};
+    MPI_Allreduce( MPI_IN_PLACE, updates.data(), 2, MPI_INT, MPI_MAX, _comm );
+    if ( updates[0] )
+        buildDistributedTree( margin );
+    if ( updates[1] )
+        relocate( points_coordinates );
+}
+
+template <typename DeviceType>
+void PointSearch<DeviceType>::buildDistributedTree( double margin )
+{
+    // Only the bounding boxes of the cells in _tree_cells are inserted in the
+    // tree.
+    _tree_margin = margin;
+    ++_n_tree_builds;
+    using ExecutionSpace = typename DeviceType::execution_space;
+    unsigned int const n_boxes = _tree_cells.extent( 0 );
+    auto bounding_boxes = _bounding_boxes;
+    auto tree_cells = _tree_cells;
+    _tree_bounding_boxes = Kokkos::View<ArborX::Box *, DeviceType>(
+        "tree_bounding_boxes", n_boxes );
+    auto tree_bounding_boxes = _tree_bounding_boxes;
+    unsigned int const dim = _dim;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "fill_tree_bounding_boxes" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_boxes ),
+        KOKKOS_LAMBDA( int const i ) {
+            ArborX::Box box = bounding_boxes( tree_cells( i ) );
+            if ( margin > 0. )
+            {
+                double extent = 0.;
+                for ( unsigned int d = 0; d < dim; ++d )
+                    extent = std::fmax(
+                        extent, box.maxCorner()[d] - box.minCorner()[d] );
+                for ( unsigned int d = 0; d < dim; ++d )
+                {
+                    box.minCorner()[d] -= margin * extent;
+                    box.maxCorner()[d] += margin * extent;
+                }
+            }
+            tree_bounding_boxes( i ) = box;
+        } );
+    Kokkos::fence();
+
+    _distributed_tree.reset( new ArborX::DistributedSearchTree<DeviceType>(
+        _comm, _tree_bounding_boxes ) );
+}
+
+template <typename DeviceType>
+std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO>
+PointSearch<DeviceType>::searchCandidates(
+    Kokkos::View<ArborX::Point *, DeviceType> imported_points,
+    Kokkos::View<int *, DeviceType> imported_cell_indices,
+    Kokkos::View<int *, DeviceType> imported_query_ids,
+    Kokkos::View<int *, DeviceType> imported_ranks )
+{
+    // When the candidates are unbalanced, the last candidates are evaluated on
+    // other processors.
+    unsigned int const n_candidates = imported_points.extent( 0 );
+    std::vector<int> export_ranks;
+    bool const redistribute = planRedistribution( n_candidates, export_ranks );
+    _n_remote_candidates = 0;
+    unsigned int const n_imports = n_candidates - export_ranks.size();
+    auto const local_range = Kokkos::make_pair( 0u, n_imports );
+    Kokkos::View<ArborX::Point *, DeviceType> local_points( imported_points,
+                                                            local_range );
+    Kokkos::View<int *, DeviceType> local_cell_indices( imported_cell_indices,
+                                                        local_range );
+    Kokkos::View<int *, DeviceType> local_query_ids( imported_query_ids,
+                                                     local_range );
+    Kokkos::View<int *, DeviceType> local_ranks( imported_ranks, local_range );
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> filtered_ranks =
+        searchLocalCandidates( local_points, local_cell_indices,
+                               local_query_ids, local_ranks );
+
+    if ( redistribute )
+    {
+        auto const remote_range = Kokkos::make_pair( n_imports, n_candidates );
+        evaluateRemoteCandidates(
+            Kokkos::View<ArborX::Point *, DeviceType>( imported_points,
+                                                       remote_range ),
+            Kokkos::View<int *, DeviceType>( imported_cell_indices,
+                                             remote_range ),
+            Kokkos::View<int *, DeviceType>( imported_query_ids,
+                                             remote_range ),
+            Kokkos::View<int *, DeviceType>( imported_ranks, remote_range ),
+            export_ranks, filtered_ranks );
+    }
+
+    return filtered_ranks;
+}
+
+template <typename DeviceType>
+std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO>
+PointSearch<DeviceType>::searchLocalCandidates(
+    Kokkos::View<ArborX::Point *, DeviceType> points,
+    Kokkos::View<int *, DeviceType> cell_indices,
+    Kokkos::View<int *, DeviceType> query_ids,
+    Kokkos::View<int *, DeviceType> ranks )
+{
+    // We need to separate the data for the different topologies because of
+    // Intrepid2. Because a point can be found in multiple cells, we need to
+    // compute the number of cells of each topology.
+    unsigned int const n_candidates = points.extent( 0 );
+    Kokkos::View<unsigned int *, DeviceType> topo( "topo", n_candidates );
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> topo_size( "topo_size" );
+    internal::buildTopo( cell_indices, _bounding_box_to_cell, topo,
+                         topo_size );
+    auto topo_size_host = Kokkos::create_mirror_view( topo_size );
+    Kokkos::deep_copy( topo_size_host, topo_size );
+
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> filtered_ranks;
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+    {
+        // Clear the results of a previous search
+        _reference_points[topo_id] = Kokkos::View<Coordinate **, DeviceType>();
+        _query_ids[topo_id] = Kokkos::View<int *, DeviceType>();
+        _cell_indices[topo_id] = Kokkos::View<int *, DeviceType>();
+        if ( _block_cells[topo_id].extent( 0 ) != 0 )
+        {
+            filtered_ranks[topo_id] = performPointInCell(
+                _block_cells[topo_id], _bounding_box_to_cell, cell_indices,
+                points, query_ids, ranks, topo, topo_id,
+                topo_size_host( topo_id ) );
+        }
+    }
+
+    return filtered_ranks;
+}
+
+template <typename DeviceType>
+bool PointSearch<DeviceType>::planRedistribution(
+    unsigned int n_candidates, std::vector<int> &export_ranks )
+{
+    export_ranks.clear();
+    if ( _imbalance_threshold <= 0. )
+        return false;
+
+    int comm_size;
+    MPI_Comm_size( _comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( _comm, &comm_rank );
+    std::vector<unsigned int> n_candidates_per_rank( comm_size );
+    MPI_Allgather( &n_candidates, 1, MPI_UNSIGNED,
+                   n_candidates_per_rank.data(), 1, MPI_UNSIGNED, _comm );
+    unsigned int const n_total =
+        std::accumulate( n_candidates_per_rank.begin(),
+                         n_candidates_per_rank.end(), 0u );
+    unsigned int const n_max = *std::max_element(
+        n_candidates_per_rank.begin(), n_candidates_per_rank.end() );
+    if ( n_max <= _imbalance_threshold * n_total / comm_size )
+        return false;
+
+    // Each processor evaluates at most quota candidates. The candidates above
+    // the quota are assigned, in the order of the ranks, to the processors
+    // below the quota.
+    unsigned int const quota = ( n_total + comm_size - 1 ) / comm_size;
+    unsigned int excess_offset = 0;
+    std::vector<unsigned int> deficit_offsets( comm_size + 1, 0 );
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        unsigned int const n = n_candidates_per_rank[r];
+        if ( ( r < comm_rank ) && ( n > quota ) )
+            excess_offset += n - quota;
+        deficit_offsets[r + 1] =
+            deficit_offsets[r] + ( ( n < quota ) ? quota - n : 0 );
+    }
+    for ( unsigned int i = quota; i < n_candidates; ++i )
+    {
+        auto const it =
+            std::upper_bound( deficit_offsets.begin(), deficit_offsets.end(),
+                              excess_offset + i - quota );
+        export_ranks.push_back(
+            std::distance( deficit_offsets.begin(), it ) - 1 );
+    }
+
+    return true;
+}
+
+template <typename DeviceType>
+void PointSearch<DeviceType>::evaluateRemoteCandidates(
+    Kokkos::View<ArborX::Point *, DeviceType> points,
+    Kokkos::View<int *, DeviceType> cell_indices,
+    Kokkos::View<int *, DeviceType> query_ids,
+    Kokkos::View<int *, DeviceType> ranks,
+    std::vector<int> const &export_ranks,
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> &filtered_ranks )
+{
+    DTK_REQUIRE( points.extent( 0 ) == export_ranks.size() );
+
+    using ExecutionSpace = typename DeviceType::execution_space;
+    int comm_rank;
+    MPI_Comm_rank( _comm, &comm_rank );
+    unsigned int const n_exports = export_ranks.size();
+    unsigned int const dim = _dim;
+
+    // The number of nodes sent with each candidate must be the same on all the
+    // processors.
+    Topologies topologies;
+    unsigned int max_n_nodes = 0;
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+        if ( _block_cells[topo_id].extent( 0 ) != 0 )
+            max_n_nodes = std::max( max_n_nodes, topologies[topo_id].n_nodes );
+    MPI_Allreduce( MPI_IN_PLACE, &max_n_nodes, 1, MPI_UNSIGNED, MPI_MAX,
+                   _comm );
+
+    // Gather the nodes of the cells associated to the candidates
+    Kokkos::View<unsigned int *, DeviceType> topo( "topo", n_exports );
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> topo_size( "topo_size" );
+    internal::buildTopo( cell_indices, _bounding_box_to_cell, topo,
+                         topo_size );
+    Kokkos::View<int *, DeviceType> topo_cell_indices( "topo_cell_indices",
+                                                       n_exports );
+    Kokkos::View<Coordinate **, DeviceType> exported_nodes(
+        "exported_nodes", n_exports, max_n_nodes * dim );
+    auto bounding_box_to_cell = _bounding_box_to_cell;
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+    {
+        if ( _block_cells[topo_id].extent( 0 ) == 0 )
+            continue;
+
+        auto cells = _block_cells[topo_id];
+        unsigned int const n_nodes = topologies[topo_id].n_nodes;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "gather_cell_nodes_" +
+                             std::to_string( topo_id ) ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_exports ),
+            KOKKOS_LAMBDA( int const i ) {
+                if ( topo( i ) == topo_id )
+                {
+                    int const cell =
+                        bounding_box_to_cell( cell_indices( i ), topo_id );
+                    topo_cell_indices( i ) = cell;
+                    for ( unsigned int node = 0; node < n_nodes; ++node )
+                        for ( unsigned int d = 0; d < dim; ++d )
+                            exported_nodes( i, node * dim + d ) =
+                                cells( cell, node, d );
+                }
+            } );
+        Kokkos::fence();
+    }
+
+    // Send the candidates and the geometry of their cell
+    Kokkos::DefaultHostExecutionSpace host_space;
+    ArborX::Details::Distributor<DeviceType> distributor( _comm );
+    unsigned int const n_imports = distributor.createFromSends(
+        host_space, Kokkos::View<int const *, Kokkos::HostSpace,
+                                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                        export_ranks.data(), n_exports ) );
+    _n_remote_candidates = n_imports;
+    Kokkos::View<int *, DeviceType> exported_ids( "exported_ids", n_exports );
+    Kokkos::parallel_for( DTK_MARK_REGION( "fill_exported_ids" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_exports ),
+                          KOKKOS_LAMBDA( int const i ) {
+                              exported_ids( i ) = i;
+                          } );
+    Kokkos::fence();
+    Kokkos::View<int *, DeviceType> exported_ranks( "exported_ranks",
+                                                    n_exports );
+    Kokkos::deep_copy( exported_ranks, comm_rank );
+
+    Kokkos::View<ArborX::Point *, DeviceType> imported_points(
+        "imported_points", n_imports );
+    Kokkos::View<unsigned int *, DeviceType> imported_topo( "imported_topo",
+                                                            n_imports );
+    Kokkos::View<Coordinate **, DeviceType> imported_nodes(
+        "imported_nodes", n_imports, max_n_nodes * dim );
+    Kokkos::View<int *, DeviceType> imported_ids( "imported_ids", n_imports );
+    Kokkos::View<int *, DeviceType> imported_ranks( "imported_ranks",
+                                                    n_imports );
+    internal::sendDataAcrossNetwork(
+        distributor, std::make_pair( points, imported_points ),
+        std::make_pair( topo, imported_topo ),
+        std::make_pair( exported_nodes, imported_nodes ),
+        std::make_pair( exported_ids, imported_ids ),
+        std::make_pair( exported_ranks, imported_ranks ) );
+
+    // Compute the position of the imported points in the reference frame. Each
+    // imported cell is described by its own nodes.
+    Kokkos::View<int *, DeviceType> in_cell( "in_cell", n_imports );
+    Kokkos::View<Coordinate **, DeviceType> imported_ref_points(
+        "imported_ref_points", n_imports, dim );
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+    {
+        if ( n_imports == 0 )
+            break;
+
+        Kokkos::View<unsigned int *, DeviceType> offset( "offset", n_imports );
+        Discretization::Helpers::computeOffset( imported_topo, topo_id,
+                                                offset );
+        unsigned int const size =
+            ArborX::lastElement( offset ) +
+            ( ArborX::lastElement( imported_topo ) == topo_id ? 1 : 0 );
+        if ( size == 0 )
+            continue;
+
+        unsigned int const n_nodes = topologies[topo_id].n_nodes;
+        Kokkos::View<int *, DeviceType> topo_positions( "topo_positions",
+                                                        size );
+        Kokkos::View<Coordinate **, DeviceType> topo_points( "topo_points",
+                                                             size, dim );
+        Kokkos::View<Coordinate **, DeviceType> topo_nodes(
+            "topo_nodes", size * n_nodes, dim );
+        Kokkos::View<unsigned int *, DeviceType> topo_cells( "topo_cells",
+                                                             size * n_nodes );
+        Kokkos::View<unsigned int *, DeviceType> topo_node_offsets(
+            "topo_node_offsets", size );
+        Kokkos::View<int *, DeviceType> topo_cell_ids( "topo_cell_ids",
+                                                       size );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "unpack_cell_nodes_" +
+                             std::to_string( topo_id ) ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+            KOKKOS_LAMBDA( int const k ) {
+                if ( imported_topo( k ) != topo_id )
+                    return;
+
+                unsigned int const i = offset( k );
+                topo_positions( i ) = k;
+                for ( unsigned int d = 0; d < dim; ++d )
+                    topo_points( i, d ) = imported_points( k )[d];
+                for ( unsigned int node = 0; node < n_nodes; ++node )
+                {
+                    unsigned int const n = i * n_nodes + node;
+                    topo_cells( n ) = n;
+                    for ( unsigned int d = 0; d < dim; ++d )
+                        topo_nodes( n, d ) =
+                            imported_nodes( k, node * dim + d );
+                }
+                topo_node_offsets( i ) = i * n_nodes;
+                topo_cell_ids( i ) = i;
+            } );
+        Kokkos::fence();
+
+        Kokkos::View<Coordinate **, DeviceType> topo_reference_points(
+            "topo_reference_points", size, dim );
+        Kokkos::View<bool *, DeviceType> topo_point_in_cell(
+            "topo_point_in_cell", size );
+        PointInCell<DeviceType>::search(
+            topo_points,
+            BlockCells<DeviceType>( topo_cells, topo_node_offsets, n_nodes,
+                                    topo_nodes ),
+            topo_cell_ids, topologies[topo_id].topo, topo_reference_points,
+            topo_point_in_cell );
+
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "scatter_reference_points_" +
+                             std::to_string( topo_id ) ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, size ),
+            KOKKOS_LAMBDA( int const i ) {
+                int const k = topo_positions( i );
+                in_cell( k ) = topo_point_in_cell( i ) ? 1 : 0;
+                for ( unsigned int d = 0; d < dim; ++d )
+                    imported_ref_points( k, d ) = topo_reference_points( i, d );
+            } );
+        Kokkos::fence();
+    }
+
+    // Send back the candidates that are inside their cell
+    unsigned int n_returns = 0;
+    Kokkos::View<unsigned int *, DeviceType> return_offset( "return_offset",
+                                                            n_imports );
+    if ( n_imports != 0 )
+    {
+        Discretization::Helpers::computeOffset( in_cell, 1, return_offset );
+        n_returns = ArborX::lastElement( return_offset ) +
+                    ArborX::lastElement( in_cell );
+    }
+    Kokkos::View<int *, DeviceType> return_ranks( "return_ranks", n_returns );
+    Kokkos::View<int *, DeviceType> return_ids( "return_ids", n_returns );
+    Kokkos::View<Coordinate **, DeviceType> returned_ref_points(
+        "returned_ref_points", n_returns, dim );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "pack_returned_candidates" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+        KOKKOS_LAMBDA( int const k ) {
+            if ( in_cell( k ) == 1 )
+            {
+                unsigned int const i = return_offset( k );
+                return_ranks( i ) = imported_ranks( k );
+                return_ids( i ) = imported_ids( k );
+                for ( unsigned int d = 0; d < dim; ++d )
+                    returned_ref_points( i, d ) = imported_ref_points( k, d );
+            }
+        } );
+    Kokkos::fence();
+    ArborX::Details::Distributor<DeviceType> return_distributor( _comm );
+    unsigned int const n_found =
+        return_distributor.createFromSends( ExecutionSpace{}, return_ranks );
+    Kokkos::View<int *, DeviceType> found_ids( "found_ids", n_found );
+    Kokkos::View<Coordinate **, DeviceType> found_ref_points(
+        "found_ref_points", n_found, dim );
+    internal::sendDataAcrossNetwork(
+        return_distributor, std::make_pair( return_ids, found_ids ),
+        std::make_pair( returned_ref_points, found_ref_points ) );
+
+    // Add the candidates found inside their cell to the results
+    Kokkos::View<unsigned int *, DeviceType> found_topo( "found_topo",
+                                                         n_found );
+    Kokkos::parallel_for( DTK_MARK_REGION( "fill_found_topo" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_found ),
+                          KOKKOS_LAMBDA( int const i ) {
+                              found_topo( i ) = topo( found_ids( i ) );
+                          } );
+    Kokkos::fence();
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+    {
+        if ( n_found == 0 )
+            break;
+
+        Kokkos::View<unsigned int *, DeviceType> offset( "offset", n_found );
+        Discretization::Helpers::computeOffset( found_topo, topo_id, offset );
+        unsigned int const size =
+            ArborX::lastElement( offset ) +
+            ( ArborX::lastElement( found_topo ) == topo_id ? 1 : 0 );
+        if ( size == 0 )
+            continue;
+
+        Kokkos::View<int *, DeviceType> new_query_ids( "query_ids", size );
+        Kokkos::View<int *, DeviceType> new_cell_indices( "cell_indices",
+                                                          size );
+        Kokkos::View<int *, DeviceType> new_ranks( "ranks", size );
+        Kokkos::View<Coordinate **, DeviceType> new_ref_points(
+            "new_ref_points", size, dim );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "unpack_found_candidates_" +
+                             std::to_string( topo_id ) ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_found ),
+            KOKKOS_LAMBDA( int const j ) {
+                if ( found_topo( j ) != topo_id )
+                    return;
+
+                unsigned int const i = offset( j );
+                int const k = found_ids( j );
+                new_query_ids( i ) = query_ids( k );
+                new_cell_indices( i ) = topo_cell_indices( k );
+                new_ranks( i ) = ranks( k );
+                for ( unsigned int d = 0; d < dim; ++d )
+                    new_ref_points( i, d ) = found_ref_points( j, d );
+            } );
+        Kokkos::fence();
+
+        _reference_points[topo_id] = internal::concatenate(
+            _reference_points[topo_id], new_ref_points, _dim );
+        _query_ids[topo_id] =
+            internal::concatenate( _query_ids[topo_id], new_query_ids );
+        _cell_indices[topo_id] =
+            internal::concatenate( _cell_indices[topo_id], new_cell_indices );
+        filtered_ranks[topo_id] =
+            internal::concatenate( filtered_ranks[topo_id], new_ranks );
+    }
+}
+
+template <typename DeviceType>
+void PointSearch<DeviceType>::buildAdjacency()
+{
+    auto cell_topologies_host =
+        Kokkos::create_mirror_view( _mesh.cell_topologies );
+    Kokkos::deep_copy( cell_topologies_host, _mesh.cell_topologies );
+    auto cells_host = Kokkos::create_mirror_view( _mesh.cells );
+    Kokkos::deep_copy( cells_host, _mesh.cells );
+    unsigned int const n_cells = cell_topologies_host.extent( 0 );
+    unsigned int const n_nodes = _mesh.nodes_coordinates.extent( 0 );
+
+    // Position in cells of the first node of each cell
+    Topologies topologies;
+    std::vector<unsigned int> node_offsets( n_cells + 1, 0 );
+    for ( unsigned int i = 0; i < n_cells; ++i )
+        node_offsets[i + 1] =
+            node_offsets[i] + topologies[cell_topologies_host( i )].n_nodes;
+
+    // Only the cells inserted in the tree are searched
+    auto tree_cells_host = Kokkos::create_mirror_view( _tree_cells );
+    Kokkos::deep_copy( tree_cells_host, _tree_cells );
+    std::vector<bool> searched( n_cells, false );
+    for ( unsigned int i = 0; i < tree_cells_host.extent( 0 ); ++i )
+        searched[tree_cells_host( i )] = true;
+
+    // Cells having each node as a vertex
+    std::vector<unsigned int> node_to_cells_offsets( n_nodes + 1, 0 );
+    for ( unsigned int i = 0; i < n_cells; ++i )
+        if ( searched[i] )
+            for ( unsigned int k = node_offsets[i];
+                  k < node_offsets[i] +
+                          internal::nVertices( cell_topologies_host( i ) );
+                  ++k )
+                ++node_to_cells_offsets[cells_host( k ) + 1];
+    std::partial_sum( node_to_cells_offsets.begin(),
+                      node_to_cells_offsets.end(),
+                      node_to_cells_offsets.begin() );
+    std::vector<unsigned int> node_to_cells( node_to_cells_offsets[n_nodes] );
+    std::vector<unsigned int> position( node_to_cells_offsets.begin(),
+                                        node_to_cells_offsets.end() - 1 );
+    for ( unsigned int i = 0; i < n_cells; ++i )
+        if ( searched[i] )
+            for ( unsigned int k = node_offsets[i];
+                  k < node_offsets[i] +
+                          internal::nVertices( cell_topologies_host( i ) );
+                  ++k )
+                node_to_cells[position[cells_host( k )]++] = i;
+
+    // The face neighbors of a cell are the cells sharing at least dim vertices
+    // with it.
+    std::vector<unsigned int> adjacency_offsets( 1, 0 );
+    std::vector<int> adjacent_cells;
+    std::vector<unsigned int> face_node_offsets( 1, 0 );
+    std::vector<unsigned int> face_nodes;
+    std::vector<std::pair<unsigned int, unsigned int>> shared_vertices;
+    for ( unsigned int i = 0; i < n_cells; ++i )
+    {
+        // Pairs (neighbor, vertex shared with the neighbor)
+        shared_vertices.clear();
+        if ( searched[i] )
+            for ( unsigned int k = node_offsets[i];
+                  k < node_offsets[i] +
+                          internal::nVertices( cell_topologies_host( i ) );
+                  ++k )
+            {
+                unsigned int const node = cells_host( k );
+                for ( unsigned int m = node_to_cells_offsets[node];
+                      m < node_to_cells_offsets[node + 1]; ++m )
+                    if ( node_to_cells[m] != i )
+                        shared_vertices.emplace_back( node_to_cells[m], node );
+            }
+        std::sort( shared_vertices.begin(), shared_vertices.end() );
+
+        unsigned int const n_shared = shared_vertices.size();
+        unsigned int first = 0;
+        while ( first < n_shared )
+        {
+            unsigned int last = first + 1;
+            while ( ( last < n_shared ) && ( shared_vertices[last].first ==
+                                             shared_vertices[first].first ) )
+                ++last;
+            if ( last - first >= _dim )
+            {
+                adjacent_cells.push_back( shared_vertices[first].first );
+                for ( unsigned int k = first; k < last; ++k )
+                    face_nodes.push_back( shared_vertices[k].second );
+                face_node_offsets.push_back( face_nodes.size() );
+            }
+            first = last;
+        }
+        adjacency_offsets.push_back( adjacent_cells.size() );
+    }
+
+    _adjacency_offsets = internal::copyToDevice<DeviceType>(
+        "adjacency_offsets", adjacency_offsets );
+    _adjacent_cells =
+        internal::copyToDevice<DeviceType>( "adjacent_cells", adjacent_cells );
+    _face_node_offsets = internal::copyToDevice<DeviceType>(
+        "face_node_offsets", face_node_offsets );
+    _face_nodes =
+        internal::copyToDevice<DeviceType>( "face_nodes", face_nodes );
+    _cell_node_offsets =
+        internal::copyToDevice<DeviceType>( "cell_node_offsets", node_offsets );
+}
+
 template <typename DeviceType>
 void PointSearch<DeviceType>::build_distributor(
     std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> const
@@ -597,6 +1937,8 @@ void PointSearch<DeviceType>::build_distributor(
     }
 
     Kokkos::DefaultHostExecutionSpace space;
+    _target_to_source_distributor =
+        ArborX::Details::Distributor<DeviceType>( _comm );
     _target_to_source_distributor.createFromSends(
         space, Kokkos::View<int const *, Kokkos::HostSpace,
                             Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
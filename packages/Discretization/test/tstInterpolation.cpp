@@ -16,6 +16,8 @@
 
 #include <Teuchos_UnitTestHarness.hpp>
 
+#include <cstdlib>
+
 template <typename DeviceType>
 Kokkos::View<DataTransferKit::Coordinate *[3], DeviceType>
 getPointsCoord3D( MPI_Comm comm ) {
@@ -518,6 +520,76 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( Interpolation,
     }
 }
 
+template <typename DeviceType, typename FEType>
+void checkSumFactorization( bool &success, Teuchos::FancyOStream &out )
+{
+    // Compare the sum-factorized evaluation with the evaluation of every basis
+    // function by Intrepid2.
+    unsigned int constexpr dim = FEType::dim;
+    unsigned int constexpr n_basis = FEType::n_basis;
+    unsigned int const n_points = 10;
+    unsigned int const n_fields = 2;
+    unsigned int const n_dofs = n_points * n_basis;
+
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> ref_points(
+        "ref_points", n_points, dim );
+    Kokkos::View<DataTransferKit::LocalOrdinal **, DeviceType> cell_dofs_ids(
+        "cell_dofs_ids", n_points, n_basis );
+    Kokkos::View<double **, DeviceType> X( "X", n_dofs, n_fields );
+    auto ref_points_host = Kokkos::create_mirror_view( ref_points );
+    auto cell_dofs_ids_host = Kokkos::create_mirror_view( cell_dofs_ids );
+    auto X_host = Kokkos::create_mirror_view( X );
+    std::srand( 17 );
+    for ( unsigned int i = 0; i < n_points; ++i )
+    {
+        for ( unsigned int d = 0; d < dim; ++d )
+            ref_points_host( i, d ) =
+                2. * static_cast<double>( std::rand() ) / RAND_MAX - 1.;
+        for ( unsigned int j = 0; j < n_basis; ++j )
+            cell_dofs_ids_host( i, j ) = i * n_basis + j;
+    }
+    for ( unsigned int i = 0; i < n_dofs; ++i )
+        for ( unsigned int k = 0; k < n_fields; ++k )
+            X_host( i, k ) = static_cast<double>( std::rand() ) / RAND_MAX;
+    Kokkos::deep_copy( ref_points, ref_points_host );
+    Kokkos::deep_copy( cell_dofs_ids, cell_dofs_ids_host );
+    Kokkos::deep_copy( X, X_host );
+
+    using ExecutionSpace = typename DeviceType::execution_space;
+    Kokkos::View<double **, DeviceType> Y_ref( "Y_ref", n_points, n_fields );
+    Kokkos::parallel_for(
+        "hgrad_interpolation",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+        DataTransferKit::Functor::HgradInterpolation<
+            double, typename FEType::feop_type, DeviceType>(
+            ref_points, cell_dofs_ids, X, Y_ref ) );
+    Kokkos::View<double **, DeviceType> Y( "Y", n_points, n_fields );
+    Kokkos::parallel_for(
+        "sum_factorized_hgrad_interpolation",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+        DataTransferKit::Functor::SumFactorizedHgradInterpolation<
+            double, FEType, DeviceType>( ref_points, cell_dofs_ids, X, Y ) );
+    Kokkos::fence();
+
+    auto Y_ref_host = Kokkos::create_mirror_view( Y_ref );
+    Kokkos::deep_copy( Y_ref_host, Y_ref );
+    auto Y_host = Kokkos::create_mirror_view( Y );
+    Kokkos::deep_copy( Y_host, Y );
+    for ( unsigned int i = 0; i < n_points; ++i )
+        for ( unsigned int k = 0; k < n_fields; ++k )
+            TEST_FLOATING_EQUALITY( Y_host( i, k ), Y_ref_host( i, k ),
+                                    1e-12 );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( Interpolation, sum_factorization,
+                                   DeviceType )
+{
+    checkSumFactorization<DeviceType, DataTransferKit::HEX_HGRAD_2>( success,
+                                                                     out );
+    checkSumFactorization<DeviceType, DataTransferKit::QUAD_HGRAD_2>( success,
+                                                                      out );
+}
+
 // Include the test macros.
 #include "DataTransferKit_ETIHelperMacros.h"
 
@@ -532,7 +604,9 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( Interpolation,
         Interpolation, one_topo_one_fe_three_dim_hdiv, DeviceType##NODE )      \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
         Interpolation, one_topo_one_fe_three_dim_point_not_found,              \
-        DeviceType##NODE )
+        DeviceType##NODE )                                                     \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( Interpolation, sum_factorization,    \
+                                          DeviceType##NODE )
 
 // Demangle the types
 DTK_ETI_MANGLING_TYPEDEFS()
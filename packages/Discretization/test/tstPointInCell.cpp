@@ -16,9 +16,10 @@
 
 #include <array>
 
-// We only test DTK_HEX_8 and DTK_QUAD_4. Testing all the topologies would
-// require a lot of code (need to create a bunch of meshes) and the only
-// difference in the search is the template parameters in the Functor.
+// We only test DTK_HEX_8, DTK_QUAD_4, and DTK_TET_4. Testing all the
+// topologies would require a lot of code (need to create a bunch of meshes)
+// and the only difference in the search is the template parameters in the
+// Functor.
 
 TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointInCell, hex_8, DeviceType )
 {
@@ -245,6 +246,169 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointInCell, quad_4, DeviceType )
     }
 }
 
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointInCell, tet_4, DeviceType )
+{
+    unsigned int constexpr dim = 3;
+    DTK_CellTopology cell_topology = DTK_TET_4;
+    unsigned int constexpr n_ref_pts = 3;
+
+    Kokkos::View<DataTransferKit::Coordinate * [dim], DeviceType>
+        reference_points( "ref_pts", n_ref_pts );
+    Kokkos::View<bool *, DeviceType> point_in_cell( "pt_in_cell", n_ref_pts );
+    // Physical points are (0.5, 0.25, 0.25), (2., 1., 1.), and (1.5, 0.5,
+    // 0.5). The reference coordinates are computed in closed form because the
+    // map of a TET_4 is affine.
+    Kokkos::View<DataTransferKit::Coordinate * [dim], DeviceType>
+        physical_points( "phys_pts", n_ref_pts );
+    physical_points( 0, 0 ) = 0.5;
+    physical_points( 0, 1 ) = 0.25;
+    physical_points( 0, 2 ) = 0.25;
+    physical_points( 1, 0 ) = 2.;
+    physical_points( 1, 1 ) = 1.;
+    physical_points( 1, 2 ) = 1.;
+    physical_points( 2, 0 ) = 1.5;
+    physical_points( 2, 1 ) = 0.5;
+    physical_points( 2, 2 ) = 0.5;
+    // Vertices of the cells
+    Kokkos::View<DataTransferKit::Coordinate * * [dim], DeviceType> cells(
+        "cell_nodes", 2, 4 );
+    // First cell
+    cells( 0, 0, 0 ) = 0.;
+    cells( 0, 0, 1 ) = 0.;
+    cells( 0, 0, 2 ) = 0.;
+    cells( 0, 1, 0 ) = 2.;
+    cells( 0, 1, 1 ) = 0.;
+    cells( 0, 1, 2 ) = 0.;
+    cells( 0, 2, 0 ) = 0.;
+    cells( 0, 2, 1 ) = 1.;
+    cells( 0, 2, 2 ) = 0.;
+    cells( 0, 3, 0 ) = 0.;
+    cells( 0, 3, 1 ) = 0.;
+    cells( 0, 3, 2 ) = 1.;
+    // Second cell
+    cells( 1, 0, 0 ) = 1.;
+    cells( 1, 0, 1 ) = 0.;
+    cells( 1, 0, 2 ) = 0.;
+    cells( 1, 1, 0 ) = 2.;
+    cells( 1, 1, 1 ) = 1.;
+    cells( 1, 1, 2 ) = 0.;
+    cells( 1, 2, 0 ) = 1.;
+    cells( 1, 2, 1 ) = 1.;
+    cells( 1, 2, 2 ) = 0.;
+    cells( 1, 3, 0 ) = 1.;
+    cells( 1, 3, 1 ) = 0.;
+    cells( 1, 3, 2 ) = 1.;
+    // Coarse search output: cells
+    Kokkos::View<int *, DeviceType> coarse_srch_cells( "coarse_srch_cells",
+                                                       n_ref_pts );
+    coarse_srch_cells( 0 ) = 0;
+    coarse_srch_cells( 1 ) = 0;
+    coarse_srch_cells( 2 ) = 1;
+
+    DataTransferKit::PointInCell<DeviceType>::search(
+        physical_points, cells, coarse_srch_cells, cell_topology,
+        reference_points, point_in_cell );
+
+    auto reference_points_host = Kokkos::create_mirror_view( reference_points );
+    Kokkos::deep_copy( reference_points_host, reference_points );
+    auto point_in_cell_host = Kokkos::create_mirror_view( point_in_cell );
+    Kokkos::deep_copy( point_in_cell_host, point_in_cell );
+
+    std::vector<std::array<double, dim>> reference_points_ref = {
+        {{0.25, 0.25, 0.25}}, {{1., 1., 1.}}, {{0.5, 0., 0.5}}};
+    std::vector<bool> point_in_cell_ref = {true, false, true};
+
+    double const tol = 1e-14;
+    for ( unsigned int i = 0; i < n_ref_pts; ++i )
+    {
+        for ( unsigned int j = 0; j < dim; ++j )
+            TEST_ASSERT( std::abs( reference_points_host( i, j ) -
+                                   reference_points_ref[i][j] ) < tol );
+        TEST_EQUALITY( point_in_cell_host( i ), point_in_cell_ref[i] );
+    }
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointInCell, skewed_hex_8, DeviceType )
+{
+    unsigned int constexpr dim = 3;
+    DTK_CellTopology cell_topology = DTK_HEX_8;
+    unsigned int constexpr n_ref_pts = 2;
+
+    Kokkos::View<DataTransferKit::Coordinate * [dim], DeviceType>
+        reference_points( "ref_pts", n_ref_pts );
+    Kokkos::View<bool *, DeviceType> point_in_cell( "pt_in_cell", n_ref_pts );
+    // The reference point of a culled point is left untouched, fill the View
+    // with a sentinel value.
+    double const sentinel = 42.;
+    Kokkos::deep_copy( reference_points, sentinel );
+    // Physical points are (1.025, 1.025, 0.5125), the image of the center of
+    // the reference cell, and (0.1, 2., 0.1). The second point is inside the
+    // bounding box of the cell but it is culled by the k-DOP before the Newton
+    // solver.
+    Kokkos::View<DataTransferKit::Coordinate * [dim], DeviceType>
+        physical_points( "phys_pts", n_ref_pts );
+    physical_points( 0, 0 ) = 1.025;
+    physical_points( 0, 1 ) = 1.025;
+    physical_points( 0, 2 ) = 0.5125;
+    physical_points( 1, 0 ) = 0.1;
+    physical_points( 1, 1 ) = 2.;
+    physical_points( 1, 2 ) = 0.1;
+    // Vertices of the cell. The cell is sheared and the seventh node is moved
+    // so that the map is not affine.
+    Kokkos::View<DataTransferKit::Coordinate * * [dim], DeviceType> cells(
+        "cell_nodes", 1, 8 );
+    cells( 0, 0, 0 ) = 0.;
+    cells( 0, 0, 1 ) = 0.;
+    cells( 0, 0, 2 ) = 0.;
+    cells( 0, 1, 0 ) = 1.;
+    cells( 0, 1, 1 ) = 0.;
+    cells( 0, 1, 2 ) = 0.;
+    cells( 0, 2, 0 ) = 1.;
+    cells( 0, 2, 1 ) = 1.;
+    cells( 0, 2, 2 ) = 0.;
+    cells( 0, 3, 0 ) = 0.;
+    cells( 0, 3, 1 ) = 1.;
+    cells( 0, 3, 2 ) = 0.;
+    cells( 0, 4, 0 ) = 1.;
+    cells( 0, 4, 1 ) = 1.;
+    cells( 0, 4, 2 ) = 1.;
+    cells( 0, 5, 0 ) = 2.;
+    cells( 0, 5, 1 ) = 1.;
+    cells( 0, 5, 2 ) = 1.;
+    cells( 0, 6, 0 ) = 2.2;
+    cells( 0, 6, 1 ) = 2.2;
+    cells( 0, 6, 2 ) = 1.1;
+    cells( 0, 7, 0 ) = 1.;
+    cells( 0, 7, 1 ) = 2.;
+    cells( 0, 7, 2 ) = 1.;
+    // Coarse search output: cells
+    Kokkos::View<int *, DeviceType> coarse_srch_cells( "coarse_srch_cells",
+                                                       n_ref_pts );
+    coarse_srch_cells( 0 ) = 0;
+    coarse_srch_cells( 1 ) = 0;
+
+    DataTransferKit::PointInCell<DeviceType>::search(
+        physical_points, cells, coarse_srch_cells, cell_topology,
+        reference_points, point_in_cell );
+
+    auto reference_points_host = Kokkos::create_mirror_view( reference_points );
+    Kokkos::deep_copy( reference_points_host, reference_points );
+    auto point_in_cell_host = Kokkos::create_mirror_view( point_in_cell );
+    Kokkos::deep_copy( point_in_cell_host, point_in_cell );
+
+    // The first point is mapped to the center of the reference cell. The
+    // reference coordinates of the culled point are not computed: the Newton
+    // solver would have overwritten the sentinel value.
+    double const tol = 1e-10;
+    for ( unsigned int j = 0; j < dim; ++j )
+    {
+        TEST_ASSERT( std::abs( reference_points_host( 0, j ) ) < tol );
+        TEST_EQUALITY( reference_points_host( 1, j ), sentinel );
+    }
+    TEST_EQUALITY( point_in_cell_host( 0 ), true );
+    TEST_EQUALITY( point_in_cell_host( 1 ), false );
+}
+
 // Include the test macros.
 #include "DataTransferKit_ETIHelperMacros.h"
 
@@ -255,6 +419,10 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointInCell, quad_4, DeviceType )
                                           DeviceType##NODE )                   \
     using DeviceType##NODE = typename NODE::device_type;                       \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointInCell, quad_4,                 \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointInCell, tet_4,                  \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointInCell, skewed_hex_8,           \
                                           DeviceType##NODE )
 
 // Demangle the types
@@ -15,6 +15,9 @@
 
 #include <Teuchos_UnitTestHarness.hpp>
 
+#include <algorithm>
+#include <array>
+
 template <typename DeviceType>
 Kokkos::View<DataTransferKit::Coordinate *[3], DeviceType>
 getPointsCoord3D( MPI_Comm comm ) {
@@ -129,33 +132,32 @@ void checkReferencePoints(
     Kokkos::deep_copy( reference_points_host, reference_points );
     auto query_ids_host = Kokkos::create_mirror_view( query_ids );
     Kokkos::deep_copy( query_ids_host, query_ids );
+    using Hit =
+        std::tuple<int, int, std::array<DataTransferKit::Coordinate, dim>>;
+    // ref_sol contains all the cells where a query can be found. Only the
+    // owner, i.e., the cell with the lowest index on the lowest rank, is
+    // returned.
+    std::vector<unsigned int> n_hits( ref_sol.size(), 0 );
     for ( unsigned int i = 0; i < query_ids_host.extent( 0 ); ++i )
     {
         int rank = ranks_host( i );
         int cell_index = cell_indices_host( i );
-        bool pt_found = false;
-        for ( unsigned int k = 0; k < ref_sol[query_ids[i]].size(); ++k )
-        {
-            auto const &ref_query = ref_sol[query_ids[i]][k];
-            if ( ( rank == std::get<0>( ref_query ) ) &&
-                 ( cell_index == std::get<1>( ref_query ) ) )
-            {
-                bool same_coord = true;
-                for ( unsigned int d = 0; d < dim; ++d )
-                    if ( std::abs( std::get<2>( ref_query )[d] -
-                                   reference_points_host( i, d ) ) > 1e-14 )
-                    {
-                        same_coord = false;
-                    }
-                if ( same_coord )
-                {
-                    pt_found = true;
-                    break;
-                }
-            }
-        }
-        TEST_EQUALITY( pt_found, true );
+        ++n_hits[query_ids_host( i )];
+        auto const &ref_query = *std::min_element(
+            ref_sol[query_ids_host( i )].begin(),
+            ref_sol[query_ids_host( i )].end(),
+            []( Hit const &a, Hit const &b ) {
+                return std::make_pair( std::get<0>( a ), std::get<1>( a ) ) <
+                       std::make_pair( std::get<0>( b ), std::get<1>( b ) );
+            } );
+        TEST_EQUALITY( rank, std::get<0>( ref_query ) );
+        TEST_EQUALITY( cell_index, std::get<1>( ref_query ) );
+        for ( unsigned int d = 0; d < dim; ++d )
+            TEST_ASSERT( std::abs( std::get<2>( ref_query )[d] -
+                                   reference_points_host( i, d ) ) < 1e-14 );
     }
+    for ( unsigned int q = 0; q < ref_sol.size(); ++q )
+        TEST_EQUALITY( n_hits[q], 1u );
 }
 
 TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, one_topo_three_dim, DeviceType )
@@ -191,11 +193,11 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, one_topo_three_dim, DeviceType )
     // Check the number of points found on each processor
     if ( comm_rank == 0 )
     {
-        TEST_EQUALITY( reference_points.extent( 0 ), 16 );
+        TEST_EQUALITY( reference_points.extent( 0 ), 5 );
     }
     else if ( comm_rank == 1 )
     {
-        TEST_EQUALITY( reference_points.extent( 0 ), 16 );
+        TEST_EQUALITY( reference_points.extent( 0 ), 5 );
     }
     else
     {
@@ -406,7 +408,7 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, two_topo_two_dim, DeviceType )
         pt_search.getSearchResults();
 
     // Check the number of points found on each processor
-    TEST_EQUALITY( reference_points.extent( 0 ), 9 );
+    TEST_EQUALITY( reference_points.extent( 0 ), 4 );
 
     // Reference solution
     using PtCoord = std::array<DataTransferKit::Coordinate, dim>;
@@ -451,6 +453,359 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, two_topo_two_dim, DeviceType )
                                            success, out );
 }
 
+template <typename DeviceType>
+void checkSameResults(
+    DataTransferKit::PointSearch<DeviceType> const &pt_search,
+    DataTransferKit::PointSearch<DeviceType> const &ref_pt_search,
+    unsigned int const n_points, unsigned int const dim, bool &success,
+    Teuchos::FancyOStream &out )
+{
+    Kokkos::View<int *, DeviceType> ranks;
+    Kokkos::View<int *, DeviceType> cell_indices;
+    Kokkos::View<DataTransferKit::Coordinate * [3], DeviceType>
+        reference_points;
+    Kokkos::View<unsigned int *, DeviceType> query_ids;
+    std::tie( ranks, cell_indices, reference_points, query_ids ) =
+        pt_search.getSearchResults();
+    Kokkos::View<int *, DeviceType> ref_ranks;
+    Kokkos::View<int *, DeviceType> ref_cell_indices;
+    Kokkos::View<DataTransferKit::Coordinate * [3], DeviceType>
+        ref_reference_points;
+    Kokkos::View<unsigned int *, DeviceType> ref_query_ids;
+    std::tie( ref_ranks, ref_cell_indices, ref_reference_points,
+              ref_query_ids ) = ref_pt_search.getSearchResults();
+
+    TEST_EQUALITY( query_ids.extent( 0 ), n_points );
+    TEST_EQUALITY( query_ids.extent( 0 ), ref_query_ids.extent( 0 ) );
+    auto ranks_host = Kokkos::create_mirror_view( ranks );
+    Kokkos::deep_copy( ranks_host, ranks );
+    auto ref_ranks_host = Kokkos::create_mirror_view( ref_ranks );
+    Kokkos::deep_copy( ref_ranks_host, ref_ranks );
+    auto cell_indices_host = Kokkos::create_mirror_view( cell_indices );
+    Kokkos::deep_copy( cell_indices_host, cell_indices );
+    auto ref_cell_indices_host = Kokkos::create_mirror_view( ref_cell_indices );
+    Kokkos::deep_copy( ref_cell_indices_host, ref_cell_indices );
+    auto reference_points_host = Kokkos::create_mirror_view( reference_points );
+    Kokkos::deep_copy( reference_points_host, reference_points );
+    auto ref_reference_points_host =
+        Kokkos::create_mirror_view( ref_reference_points );
+    Kokkos::deep_copy( ref_reference_points_host, ref_reference_points );
+    auto query_ids_host = Kokkos::create_mirror_view( query_ids );
+    Kokkos::deep_copy( query_ids_host, query_ids );
+    auto ref_query_ids_host = Kokkos::create_mirror_view( ref_query_ids );
+    Kokkos::deep_copy( ref_query_ids_host, ref_query_ids );
+    for ( unsigned int i = 0; i < ref_query_ids_host.extent( 0 ); ++i )
+    {
+        TEST_EQUALITY( query_ids_host( i ), ref_query_ids_host( i ) );
+        TEST_EQUALITY( ranks_host( i ), ref_ranks_host( i ) );
+        TEST_EQUALITY( cell_indices_host( i ), ref_cell_indices_host( i ) );
+        for ( unsigned int d = 0; d < dim; ++d )
+            TEST_ASSERT( std::abs( reference_points_host( i, d ) -
+                                   ref_reference_points_host( i, d ) ) <
+                         1e-14 );
+    }
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, relocate, DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    unsigned int constexpr dim = 3;
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies_view;
+    Kokkos::View<unsigned int *, DeviceType> cells;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> coordinates;
+    std::vector<unsigned int> n_subdivisions = {{5, 5, 3}};
+    std::tie( cell_topologies_view, cells, coordinates ) =
+        buildStructuredMesh<DeviceType>( comm, n_subdivisions );
+    auto points_coord = getPointsCoord3D<DeviceType>( comm );
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies_view, cells,
+                                            coordinates );
+    DataTransferKit::PointSearch<DeviceType> pt_search( comm, mesh,
+                                                        points_coord );
+
+    // Move the points inside the cells. Some points stay in the same cell,
+    // some move to a neighbor, and the point on the edge moves to the part of
+    // the mesh owned by the next processor.
+    unsigned int const n_points = points_coord.extent( 0 );
+    Kokkos::View<DataTransferKit::Coordinate * [dim], DeviceType>
+        new_points_coord( "new_points_coord", n_points );
+    auto points_coord_host = Kokkos::create_mirror_view( points_coord );
+    Kokkos::deep_copy( points_coord_host, points_coord );
+    auto new_points_coord_host = Kokkos::create_mirror_view( new_points_coord );
+    for ( unsigned int i = 0; i < n_points; ++i )
+        for ( unsigned int d = 0; d < dim; ++d )
+            new_points_coord_host( i, d ) =
+                points_coord_host( i, d ) + 0.1 * ( d + 1 );
+    Kokkos::deep_copy( new_points_coord, new_points_coord_host );
+
+    pt_search.relocate( new_points_coord );
+
+    // The results must be the same as the results of a new search
+    DataTransferKit::PointSearch<DeviceType> ref_pt_search( comm, mesh,
+                                                            new_points_coord );
+    checkSameResults( pt_search, ref_pt_search, n_points, dim, success, out );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, relocate_walk, DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    unsigned int constexpr dim = 3;
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies_view;
+    Kokkos::View<unsigned int *, DeviceType> cells;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> coordinates;
+    std::vector<unsigned int> n_subdivisions = {{5, 5, 3}};
+    std::tie( cell_topologies_view, cells, coordinates ) =
+        buildStructuredMesh<DeviceType>( comm, n_subdivisions );
+    auto points_coord = getPointsCoord3D<DeviceType>( comm );
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies_view, cells,
+                                            coordinates );
+    DataTransferKit::PointSearch<DeviceType> pt_search( comm, mesh,
+                                                        points_coord );
+
+    // Move the points across several cells so that they walk through the
+    // mesh. The points crossing the plane z = 3 leave the part of the mesh
+    // owned by the processor and they are found by the distributed search.
+    unsigned int const n_points = points_coord.extent( 0 );
+    Kokkos::View<DataTransferKit::Coordinate * [dim], DeviceType>
+        new_points_coord( "new_points_coord", n_points );
+    auto points_coord_host = Kokkos::create_mirror_view( points_coord );
+    Kokkos::deep_copy( points_coord_host, points_coord );
+    auto new_points_coord_host = Kokkos::create_mirror_view( new_points_coord );
+    std::array<double, dim> const displacement = {{1.1, 0.8, -0.3}};
+    for ( unsigned int i = 0; i < n_points; ++i )
+        for ( unsigned int d = 0; d < dim; ++d )
+            new_points_coord_host( i, d ) =
+                points_coord_host( i, d ) + displacement[d];
+    Kokkos::deep_copy( new_points_coord, new_points_coord_host );
+
+    pt_search.relocate( new_points_coord );
+    DataTransferKit::PointSearch<DeviceType> ref_pt_search( comm, mesh,
+                                                            new_points_coord );
+    checkSameResults( pt_search, ref_pt_search, n_points, dim, success, out );
+
+    // Move the points back with a single step of the walk. This step is not
+    // enough to reach the original cells so the points that are still walking
+    // are found by the distributed search.
+    unsigned int const max_steps = 1;
+    pt_search.relocate( points_coord, max_steps );
+    DataTransferKit::PointSearch<DeviceType> original_pt_search(
+        comm, mesh, points_coord );
+    checkSameResults( pt_search, original_pt_search, n_points, dim, success,
+                      out );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, refit, DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    unsigned int constexpr dim = 3;
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies_view;
+    Kokkos::View<unsigned int *, DeviceType> cells;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> coordinates;
+    std::vector<unsigned int> n_subdivisions = {{5, 5, 3}};
+    std::tie( cell_topologies_view, cells, coordinates ) =
+        buildStructuredMesh<DeviceType>( comm, n_subdivisions );
+    auto points_coord = getPointsCoord3D<DeviceType>( comm );
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies_view, cells,
+                                            coordinates );
+    DataTransferKit::PointSearch<DeviceType> pt_search( comm, mesh,
+                                                        points_coord );
+    TEST_EQUALITY( pt_search.getNumberOfTreeBuilds(), 1 );
+
+    // Translate the mesh twice. The first refit rebuilds the tree with
+    // enlarged bounding boxes, the second one only updates the bounding boxes
+    // since the cells stay inside the margin: the cells have a unit size and
+    // they move by less than the default margin of 0.1.
+    unsigned int const n_nodes = coordinates.extent( 0 );
+    unsigned int const n_points = points_coord.extent( 0 );
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> new_coordinates(
+        "new_coordinates", n_nodes, dim );
+    auto coordinates_host = Kokkos::create_mirror_view( coordinates );
+    Kokkos::deep_copy( coordinates_host, coordinates );
+    auto new_coordinates_host = Kokkos::create_mirror_view( new_coordinates );
+    for ( unsigned int step = 1; step <= 2; ++step )
+    {
+        for ( unsigned int i = 0; i < n_nodes; ++i )
+            for ( unsigned int d = 0; d < dim; ++d )
+                new_coordinates_host( i, d ) =
+                    coordinates_host( i, d ) + 0.02 * step * ( d + 1 );
+        Kokkos::deep_copy( new_coordinates, new_coordinates_host );
+
+        pt_search.refit( new_coordinates, points_coord );
+
+        // The results must be the same as the results of a new search
+        DataTransferKit::Mesh<DeviceType> new_mesh( cell_topologies_view,
+                                                    cells, new_coordinates );
+        DataTransferKit::PointSearch<DeviceType> ref_pt_search(
+            comm, new_mesh, points_coord );
+        checkSameResults( pt_search, ref_pt_search, n_points, dim, success,
+                          out );
+        TEST_EQUALITY( pt_search.getNumberOfTreeBuilds(), 2 );
+    }
+
+    // Nothing moves: the tree is not rebuilt, the points are not relocated,
+    // and the results do not change. The margin only matters when the tree is
+    // rebuilt.
+    double const margin = 0.05;
+    pt_search.refit( new_coordinates, points_coord, margin );
+    TEST_EQUALITY( pt_search.getNumberOfTreeBuilds(), 2 );
+    {
+        DataTransferKit::Mesh<DeviceType> new_mesh( cell_topologies_view,
+                                                    cells, new_coordinates );
+        DataTransferKit::PointSearch<DeviceType> ref_pt_search(
+            comm, new_mesh, points_coord );
+        checkSameResults( pt_search, ref_pt_search, n_points, dim, success,
+                          out );
+    }
+
+    // Move the mesh past the margin: the tree is rebuilt.
+    for ( unsigned int i = 0; i < n_nodes; ++i )
+        for ( unsigned int d = 0; d < dim; ++d )
+            new_coordinates_host( i, d ) += 0.2;
+    Kokkos::deep_copy( new_coordinates, new_coordinates_host );
+    pt_search.refit( new_coordinates, points_coord, margin );
+    TEST_EQUALITY( pt_search.getNumberOfTreeBuilds(), 3 );
+    DataTransferKit::Mesh<DeviceType> new_mesh( cell_topologies_view, cells,
+                                                new_coordinates );
+    DataTransferKit::PointSearch<DeviceType> ref_pt_search( comm, new_mesh,
+                                                            points_coord );
+    checkSameResults( pt_search, ref_pt_search, n_points, dim, success, out );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, load_balancing, DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    unsigned int constexpr dim = 3;
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies_view;
+    Kokkos::View<unsigned int *, DeviceType> cells;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> coordinates;
+    std::vector<unsigned int> n_subdivisions = {{5, 5, 3}};
+    std::tie( cell_topologies_view, cells, coordinates ) =
+        buildStructuredMesh<DeviceType>( comm, n_subdivisions );
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies_view, cells,
+                                            coordinates );
+
+    // All the points are in the part of the mesh owned by the first processor
+    // so all the candidates are on this processor.
+    unsigned int const n_points = 20;
+    Kokkos::View<DataTransferKit::Coordinate * [dim], DeviceType> points_coord(
+        "points_coord", n_points );
+    auto points_coord_host = Kokkos::create_mirror_view( points_coord );
+    for ( unsigned int i = 0; i < n_points; ++i )
+    {
+        points_coord_host( i, 0 ) = 0.25 + ( i % 5 );
+        points_coord_host( i, 1 ) = 0.75 + ( ( i / 5 ) % 5 );
+        points_coord_host( i, 2 ) = 0.5 + ( ( comm_rank + i ) % 3 );
+    }
+    Kokkos::deep_copy( points_coord, points_coord_host );
+
+    // The results must be the same with and without redistribution
+    DataTransferKit::PointSearch<DeviceType> pt_search( comm, mesh,
+                                                        points_coord, 1.5 );
+    DataTransferKit::PointSearch<DeviceType> ref_pt_search( comm, mesh,
+                                                            points_coord );
+    checkSameResults( pt_search, ref_pt_search, n_points, dim, success, out );
+
+    // The candidates above the average are evaluated by the other processors
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    unsigned int n_remote_candidates = pt_search.getNumberOfRemoteCandidates();
+    TEST_EQUALITY( ref_pt_search.getNumberOfRemoteCandidates(), 0 );
+    if ( comm_rank == 0 )
+    {
+        TEST_EQUALITY( n_remote_candidates, 0 );
+    }
+    MPI_Allreduce( MPI_IN_PLACE, &n_remote_candidates, 1, MPI_UNSIGNED,
+                   MPI_SUM, comm );
+    if ( comm_size > 1 )
+    {
+        TEST_ASSERT( n_remote_candidates > 0 );
+    }
+    else
+    {
+        TEST_EQUALITY( n_remote_candidates, 0 );
+    }
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, boundary_cells, DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    unsigned int constexpr dim = 3;
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies_view;
+    Kokkos::View<unsigned int *, DeviceType> cells;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> coordinates;
+    std::vector<unsigned int> n_subdivisions = {{5, 5, 3}};
+    std::tie( cell_topologies_view, cells, coordinates ) =
+        buildStructuredMesh<DeviceType>( comm, n_subdivisions );
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies_view, cells,
+                                            coordinates );
+
+    // Only search the bottom layer of cells. The cells of the first row are
+    // given twice as if they had two faces on the boundary.
+    unsigned int const n_boundary_cells = 30;
+    Kokkos::View<DataTransferKit::LocalOrdinal *, DeviceType> boundary_cells(
+        "boundary_cells", n_boundary_cells );
+    auto boundary_cells_host = Kokkos::create_mirror_view( boundary_cells );
+    for ( unsigned int i = 0; i < n_boundary_cells; ++i )
+        boundary_cells_host( i ) = i % 25;
+    Kokkos::deep_copy( boundary_cells, boundary_cells_host );
+
+    // The first points are in the bottom layer of cells, the last point is in
+    // the middle layer and it is not found.
+    unsigned int const n_points = 6;
+    Kokkos::View<DataTransferKit::Coordinate * [dim], DeviceType> points_coord(
+        "points_coord", n_points );
+    auto points_coord_host = Kokkos::create_mirror_view( points_coord );
+    for ( unsigned int i = 0; i < n_points; ++i )
+    {
+        points_coord_host( i, 0 ) = 0.25 + ( i % 5 );
+        points_coord_host( i, 1 ) = 0.75 + ( i % 5 );
+        points_coord_host( i, 2 ) = 3 * comm_rank + ( i < 5 ? 0.5 : 1.5 );
+    }
+    Kokkos::deep_copy( points_coord, points_coord_host );
+
+    DataTransferKit::PointSearch<DeviceType> pt_search(
+        comm, mesh, boundary_cells, points_coord );
+    DataTransferKit::PointSearch<DeviceType> ref_pt_search( comm, mesh,
+                                                            points_coord );
+
+    Kokkos::View<int *, DeviceType> ranks;
+    Kokkos::View<int *, DeviceType> cell_indices;
+    Kokkos::View<DataTransferKit::Coordinate * [3], DeviceType>
+        reference_points;
+    Kokkos::View<unsigned int *, DeviceType> query_ids;
+    std::tie( ranks, cell_indices, reference_points, query_ids ) =
+        pt_search.getSearchResults();
+    Kokkos::View<int *, DeviceType> ref_ranks;
+    Kokkos::View<int *, DeviceType> ref_cell_indices;
+    Kokkos::View<DataTransferKit::Coordinate * [3], DeviceType>
+        ref_reference_points;
+    Kokkos::View<unsigned int *, DeviceType> ref_query_ids;
+    std::tie( ref_ranks, ref_cell_indices, ref_reference_points,
+              ref_query_ids ) = ref_pt_search.getSearchResults();
+
+    TEST_EQUALITY( query_ids.extent( 0 ), n_points - 1 );
+    TEST_EQUALITY( ref_query_ids.extent( 0 ), n_points );
+    auto ranks_host = Kokkos::create_mirror_view( ranks );
+    Kokkos::deep_copy( ranks_host, ranks );
+    auto ref_ranks_host = Kokkos::create_mirror_view( ref_ranks );
+    Kokkos::deep_copy( ref_ranks_host, ref_ranks );
+    auto cell_indices_host = Kokkos::create_mirror_view( cell_indices );
+    Kokkos::deep_copy( cell_indices_host, cell_indices );
+    auto ref_cell_indices_host = Kokkos::create_mirror_view( ref_cell_indices );
+    Kokkos::deep_copy( ref_cell_indices_host, ref_cell_indices );
+    auto query_ids_host = Kokkos::create_mirror_view( query_ids );
+    Kokkos::deep_copy( query_ids_host, query_ids );
+    for ( unsigned int i = 0; i < query_ids_host.extent( 0 ); ++i )
+    {
+        TEST_EQUALITY( query_ids_host( i ), i );
+        TEST_EQUALITY( ranks_host( i ), ref_ranks_host( i ) );
+        TEST_EQUALITY( cell_indices_host( i ), ref_cell_indices_host( i ) );
+    }
+}
+
 // Include the test macros.
 #include "DataTransferKit_ETIHelperMacros.h"
 
@@ -462,6 +817,16 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, two_topo_two_dim, DeviceType )
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
         PointSearch, one_topo_three_dim_no_point_found, DeviceType##NODE )     \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, two_topo_two_dim,       \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, relocate,               \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, relocate_walk,          \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, refit,                  \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, load_balancing,         \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, boundary_cells,         \
                                           DeviceType##NODE )
 
 // Demangle the types
@@ -197,6 +197,13 @@ void MixedTopologyDOFMapDataFunctionWrapper( std::shared_ptr<void> user_data,
     discretization_type.assign( c_discretization_type.data() );
 }
 
+void GeometryVersionFunctionWrapper( std::shared_ptr<void> user_data,
+                                     size_t &geometry_version )
+{
+    auto u = get_function<DTK_GeometryVersionFunction>( user_data );
+    u.first( u.second, &geometry_version );
+}
+
 void FieldSizeFunctionWrapper( std::shared_ptr<void> user_data,
                                const std::string &field_name,
                                unsigned &field_dimension,
@@ -432,6 +439,10 @@ void DTK_setUserFunction( DTK_UserApplicationHandle handle,
         case DTK_EVALUATE_FIELD_FUNCTION:
             dtk->_registry->setEvaluateFieldFunction(
                 EvaluateFieldFunctionWrapper<double>, data );
+            break;
+        case DTK_GEOMETRY_VERSION_FUNCTION:
+            dtk->_registry->setGeometryVersionFunction(
+                GeometryVersionFunctionWrapper, data );
         }
     }
     catch ( ... )
@@ -440,6 +451,45 @@ void DTK_setUserFunction( DTK_UserApplicationHandle handle,
     }
 }
 
+void DTK_setFieldBuffer( DTK_UserApplicationHandle handle,
+                         const char *field_name, double *field_dofs,
+                         unsigned field_dimension, size_t local_num_dofs )
+{
+    errno = DTK_SUCCESS;
+
+    if ( !DTK_isValidUserApplication( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    try
+    {
+        auto dtk = reinterpret_cast<DataTransferKit::DTK_Registry *>( handle );
+        dtk->_registry->setFieldBuffer( field_name, field_dofs,
+                                        field_dimension, local_num_dofs );
+    }
+    catch ( ... )
+    {
+        errno = DTK_UNKNOWN;
+    }
+}
+
+void DTK_removeFieldBuffer( DTK_UserApplicationHandle handle,
+                            const char *field_name )
+{
+    errno = DTK_SUCCESS;
+
+    if ( !DTK_isValidUserApplication( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    auto dtk = reinterpret_cast<DataTransferKit::DTK_Registry *>( handle );
+    dtk->_registry->removeFieldBuffer( field_name );
+}
+
 const char *DTK_error( int err )
 {
     errno = DTK_SUCCESS;
@@ -292,6 +292,27 @@ typedef struct _DTK_MapHandle *DTK_MapHandle;
  *                        "\"OptionBarDouble\": 1.32 }";
  *  \endcode
  *
+ *  With the "Delegated Evaluation" map type, DTK only routes each target node
+ *  to the rank owning the source object whose bounding volume contains it,
+ *  or is the closest to it. The source application then evaluates the field
+ *  at all the nodes routed to it with a single call to its
+ *  DTK_EvaluateFieldFunction() and the values are sent back. The object ids
+ *  passed to this function are the indices of the objects in the bounding
+ *  volume list of the source application. The source application must
+ *  register DTK_BOUNDING_VOLUME_LIST_SIZE_FUNCTION,
+ *  DTK_BOUNDING_VOLUME_LIST_DATA_FUNCTION, DTK_FIELD_SIZE_FUNCTION and
+ *  DTK_EVALUATE_FIELD_FUNCTION instead of its node list and field data
+ *  functions.
+ *
+ *  With the "Finite Element" map type, each target node is located once in a
+ *  cell of the source mesh and its value is then obtained by evaluating the
+ *  basis functions of that cell. The source application must register its
+ *  cell list and degree-of-freedom map functions instead of its node list
+ *  functions. The source fields give the values of the degrees of freedom.
+ *  The discretization type of the degree-of-freedom map selects the element:
+ *  "HGRAD" (the default if it is empty), "HDIV" or "HCURL". The target nodes
+ *  which are not in any cell get zero.
+ *
  *  \param[in] space Execution space where the map will execute. Operations on
  *  user data for transfer operations will occur in this execution space. If
  *  the source or target applications reside in memory spaces that are not
@@ -307,28 +328,30 @@ typedef struct _DTK_MapHandle *DTK_MapHandle;
  *  communicator should be the one passed to this function assuming that data
  *  for solution transfer will be accessed on all MPI ranks. If the source and
  *  target applications live on different MPI communicators composed of
- *  entirely different sets of MPI ranks then a new communicator that consists
- *  of all of the MPI ranks in both source and target communicators should be
- *  created and passed to this function. Cases will also arise in which the
- *  source or target application may not exist on some ranks of this
- *  communicator (e.g. the previously mentioned case of disjoint source and
- *  target communicators). In that case, user implementations of callback
- *  functions should just return sizes of zero during calls to allocation
- *  functions to indicate to DTK that there is no data from the user
- *  application on a given MPI rank.
- *
- *  \param[in] source Handle to the source application. This handle must be
- *  valid on all ranks in the communicator. Function callback implementations
- *  for the source should return zero sizes in allocation functions if the
- *  user's source application does not exist on the calling MPI rank.
- *
- *  \param[in,out] target Handle to the target application. Data will be
- *  transferred from the source and pushed to this application. This handle
- *  must be valid on all ranks in the communicator. Data will be pulled from
- *  this application and transferred to the target. Function callback
- *  implementations for the target should return zero sizes in allocation
- *  functions if the user's target application does not exist on the calling
- *  MPI rank.
+ *  entirely different sets of MPI ranks then an intercommunicator between the
+ *  source and target communicators (see MPI_Intercomm_create()) may be passed
+ *  to this function. The ranks of the source group then pass a NULL target
+ *  handle and the ranks of the target group pass a NULL source handle. Only
+ *  the ranks of these two groups take part in the communication.
+ *  Alternatively, a communicator that consists of all of the MPI ranks in
+ *  both source and target communicators may be created and passed to this
+ *  function with a NULL handle for the application which does not exist on
+ *  a given MPI rank. The map keeps its own duplicate of the communicator, so
+ *  \p comm may be freed once the map is created.
+ *
+ *  \param[in] source Handle to the source application or NULL if the source
+ *  application does not exist on the calling MPI rank. Function callback
+ *  implementations for the source may also return zero sizes in allocation
+ *  functions to indicate that there is no source data on the calling MPI
+ *  rank.
+ *
+ *  \param[in,out] target Handle to the target application or NULL if the
+ *  target application does not exist on the calling MPI rank. Data will be
+ *  transferred from the source and pushed to this application. Function
+ *  callback implementations for the target may also return zero sizes in
+ *  allocation functions to indicate that there is no target data on the
+ *  calling MPI rank. At least one of \p source and \p target must not be
+ *  NULL.
  *
  *  \param[in] options Options string for building the map. The contents of
  *  this string specify what type of map to create as well as other parameters
@@ -386,6 +409,87 @@ extern bool DTK_isValidMap( DTK_MapHandle handle );
 extern void DTK_applyMap( DTK_MapHandle handle, const char *source_field,
                           const char *target_field );
 
+/** \brief Apply the map to several fields at once.
+ *
+ *  This function is equivalent to calling DTK_applyMap() on each pair of
+ *  source and target fields but all the fields are pulled from the source
+ *  first, all their components are transferred together in the same
+ *  messages, and then all the fields are pushed to the target.
+ *
+ *  \note This function call is a collective over the map's communicator.
+ *
+ *  \param[in] handle Map handle. This handle must be valid on all calling MPI
+ *  ranks.
+ *
+ *  \param[in] num_fields Number of fields to transfer.
+ *
+ *  \param[in] source_fields Names of the fields in the source user
+ *  application. The length of this array is num_fields.
+ *
+ *  \param[in] target_fields Names of the fields in the target user
+ *  application. The length of this array is num_fields. Target field i
+ *  receives the data of source field i and must have the same dimension.
+ */
+extern void DTK_applyMapMulti( DTK_MapHandle handle, int num_fields,
+                               const char **source_fields,
+                               const char **target_fields );
+
+/** \brief DTK handle to an application of a map in progress.
+ *
+ *  A request is returned by DTK_applyMapBegin() and is completed by
+ *  DTK_applyMapWait().
+ */
+typedef struct _DTK_Request *DTK_Request;
+
+/** \brief Start applying the map.
+ *
+ *  The source field is pulled and the communication is started before this
+ *  function returns. The source application may then modify the source field
+ *  and do its own work while the data is exchanged. The target field is only
+ *  pushed by DTK_applyMapWait().
+ *
+ *  \note This function call is a collective over the map's communicator.
+ *
+ *  \note The map handle as well as the source and target user application
+ *  handles must remain valid until the request is completed.
+ *
+ *  \param[in] handle Map handle. This handle must be valid on all calling MPI
+ *  ranks.
+ *
+ *  \param[in] source_field Name of the field in the source user
+ *  application.
+ *
+ *  \param[in] target_field Name of the field in the target user
+ *  application.
+ *
+ *  \return A request to complete with DTK_applyMapWait().
+ */
+extern DTK_Request DTK_applyMapBegin( DTK_MapHandle handle,
+                                      const char *source_field,
+                                      const char *target_field );
+
+/** \brief Check if the application of a map has progressed far enough to be
+ *  completed without waiting.
+ *
+ *  This function does not block. It may be called repeatedly to progress
+ *  the communication.
+ *
+ *  \param[in] request Request returned by DTK_applyMapBegin().
+ *
+ *  \return true if DTK_applyMapWait() will not wait for any communication.
+ */
+extern bool DTK_applyMapTest( DTK_Request request );
+
+/** \brief Complete the application of a map.
+ *
+ *  This function waits for the communication to complete, computes the
+ *  target field and pushes it to the target user application. The request
+ *  is destroyed.
+ *
+ *  \param[in,out] request Request returned by DTK_applyMapBegin().
+ */
+extern void DTK_applyMapWait( DTK_Request request );
+
 /** \brief Destroy a DTK handle to a map.
  *
  *  \param[in,out] handle map handle. If this handle has already been
@@ -394,6 +498,93 @@ extern void DTK_applyMap( DTK_MapHandle handle, const char *source_field,
  */
 extern void DTK_destroyMap( DTK_MapHandle handle );
 
+/** \brief DTK handle to a group of maps applied together.
+ *
+ *  The maps of a group are applied with a single exchange of data: each pair
+ *  of MPI ranks exchanges one message containing the data of all the maps.
+ *  This is cheaper than applying the maps one after the other when several
+ *  maps are applied at each coupling step.
+ */
+typedef struct _DTK_MapGroupHandle *DTK_MapGroupHandle;
+
+/** \brief Create an empty group of maps.
+ *
+ *  \return DTK_createMapGroup returns a handle for the group. This handle
+ *  must be destroyed with DTK_destroyMapGroup() when the lifetime of the
+ *  group has ended in the program.
+ */
+extern DTK_MapGroupHandle DTK_createMapGroup();
+
+/** \brief Indicates whether a DTK handle to a group of maps is valid.
+ *
+ *  \param[in] handle The DTK map group handle to check.
+ *
+ *  \return true if the given map group handle is valid; false otherwise.
+ */
+extern bool DTK_isValidMapGroup( DTK_MapGroupHandle handle );
+
+/** \brief Add the application of a map to a group.
+ *
+ *  A map may be added several times to transfer different fields.
+ *
+ *  \note All the maps of a group must have been created over the same group
+ *  of MPI ranks and must be added in the same order on all the ranks. The
+ *  map handles must remain valid as long as the group is applied. A map
+ *  created over a different group of MPI ranks than the maps already in the
+ *  group is not added and \c errno is set to DTK_UNKNOWN.
+ *
+ *  \param[in] group Map group handle.
+ *
+ *  \param[in] map Map handle.
+ *
+ *  \param[in] source_field Name of the field in the source user
+ *  application of the map.
+ *
+ *  \param[in] target_field Name of the field in the target user
+ *  application of the map.
+ */
+extern void DTK_addToMapGroup( DTK_MapGroupHandle group, DTK_MapHandle map,
+                               const char *source_field,
+                               const char *target_field );
+
+/** \brief Apply all the maps of a group.
+ *
+ *  This function is equivalent to calling DTK_applyMap() for each map added
+ *  to the group but the data of all the maps is exchanged in the same
+ *  messages.
+ *
+ *  \note This function call is a collective over the maps' communicator.
+ *
+ *  \param[in] group Map group handle. This handle must be valid on all
+ *  calling MPI ranks.
+ */
+extern void DTK_applyMapGroup( DTK_MapGroupHandle group );
+
+/** \brief Start applying all the maps of a group.
+ *
+ *  This function is the split-phase version of DTK_applyMapGroup(). The
+ *  request returned is completed with DTK_applyMapTest() and
+ *  DTK_applyMapWait() like the request of a single map.
+ *
+ *  \note This function call is a collective over the maps' communicator.
+ *
+ *  \param[in] group Map group handle. This handle must be valid on all
+ *  calling MPI ranks.
+ *
+ *  \return A request to complete with DTK_applyMapWait().
+ */
+extern DTK_Request DTK_applyMapGroupBegin( DTK_MapGroupHandle group );
+
+/** \brief Destroy a DTK handle to a group of maps.
+ *
+ *  The maps of the group are not destroyed.
+ *
+ *  \param[in,out] group Map group handle. If this handle has already been
+ *  destroyed or was not created with a call to DTK_createMapGroup() then
+ *  this function does nothing.
+ */
+extern void DTK_destroyMapGroup( DTK_MapGroupHandle group );
+
 /**@}*/
 
 /**
@@ -436,6 +627,7 @@ typedef enum {
     DTK_PULL_FIELD_DATA_FUNCTION /** See DTK_PullFieldDataFunction() */,
     DTK_PUSH_FIELD_DATA_FUNCTION /** See DTK_PushFieldDataFunction() */,
     DTK_EVALUATE_FIELD_FUNCTION /** See DTK_EvaluateFieldFunction() */,
+    DTK_GEOMETRY_VERSION_FUNCTION /** See DTK_GeometryVersionFunction() */,
 } DTK_FunctionType;
 // clang-format on
 
@@ -476,6 +668,49 @@ extern void DTK_setUserFunction( DTK_UserApplicationHandle handle,
                                  DTK_FunctionType type, void ( *f )(),
                                  void *user_data );
 
+/** \brief Register an application array as the storage of a field.
+ *
+ *  DTK reads and writes the degrees of freedom of the field directly in this
+ *  array. No field is allocated by DTK and the DTK_FieldSizeFunction(),
+ *  DTK_PullFieldDataFunction() and DTK_PushFieldDataFunction() callbacks are
+ *  not called for this field.
+ *
+ *  \note The application keeps ownership of the array. It must remain valid
+ *  until it is removed with DTK_removeFieldBuffer() or the handle is
+ *  destroyed.
+ *
+ *  \param[in,out] handle User application handle.
+ *
+ *  \param[in] field_name Name of the field.
+ *
+ *  \param[in] field_dofs Degrees-of-freedom for the field, allocated in the
+ *  memory space of the user application. The length of this array is
+ *  local_num_dofs * field_dimension. Values are blocked by field dimension as
+ *  in DTK_PullFieldDataFunction(). A Fortran array dimensioned
+ *  (local_num_dofs, field_dimension) has this layout and may be passed with
+ *  c_loc().
+ *
+ *  \param[in] field_dimension Dimension of the field.
+ *
+ *  \param[in] local_num_dofs Number of degrees of freedom owned by this
+ *  process.
+ */
+extern void DTK_setFieldBuffer( DTK_UserApplicationHandle handle,
+                                const char *field_name, double *field_dofs,
+                                unsigned field_dimension,
+                                size_t local_num_dofs );
+
+/** \brief Remove the array registered as the storage of a field.
+ *
+ *  DTK uses the field callbacks again for this field.
+ *
+ *  \param[in,out] handle User application handle.
+ *
+ *  \param[in] field_name Name of the field.
+ */
+extern void DTK_removeFieldBuffer( DTK_UserApplicationHandle handle,
+                                   const char *field_name );
+
 /**@}*/
 
 /**
@@ -1101,6 +1336,28 @@ typedef void ( *DTK_EvaluateFieldFunction )(
     const Coordinate *evaluation_points, const LocalOrdinal *object_ids,
     double *values );
 
+/** \brief Prototype function to get the version of the geometry of the
+ *         application.
+ *
+ *  Implementing this function is optional. When it is registered, DTK
+ *  caches the node list, polyhedron list, cell list, and degree-of-freedom
+ *  map it extracts from the application and only calls the corresponding
+ *  size and data functions again when the version changes. Applications
+ *  which check for remeshing periodically can then recreate their maps
+ *  cheaply when the mesh did not change.
+ *
+ *  \note Register with a user application using DTK_setUserFunction() by
+ *  passing DTK_GEOMETRY_VERSION_FUNCTION as the \p type argument.
+ *
+ *  \param[in] user_data Custom user data.
+ *
+ *  \param[out] geometry_version Version of the geometry. It must change
+ *              whenever the data returned by the geometry or
+ *              degree-of-freedom map functions changes.
+ */
+typedef void ( *DTK_GeometryVersionFunction )( void *user_data,
+                                               size_t *geometry_version );
+
 /**@}*/
 
 /**@}*/
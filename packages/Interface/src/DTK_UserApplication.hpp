@@ -32,6 +32,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace DataTransferKit
@@ -67,7 +68,15 @@ class UserApplication
     UserApplication(
         const std::shared_ptr<UserFunctionRegistry<Scalar>> &user_functions );
 
-    //! Get a node list from the application.
+    //! Get the version of the geometry of the application. Return false if
+    //! the application did not register a geometry version function.
+    bool getGeometryVersion( size_t &geometry_version );
+
+    //! Get a node list from the application. If the application provides a
+    //! geometry version, the node list, polyhedron list, cell list and dof
+    //! map are only extracted again when the version changes. The lists
+    //! returned for the same version share their data, including across the
+    //! user applications built from the same registry.
     NodeList<Kokkos::LayoutLeft, MemorySpace> getNodeList();
 
     //! Get a bounding volume list from the application.
@@ -91,7 +100,18 @@ class UserApplication
     DOFMap<Kokkos::LayoutLeft, MemorySpace>
     getDOFMap( std::string &discretization_type );
 
-    //! Get a field with a given name from the application.
+    //! Get the dimension and the local number of degrees of freedom of a
+    //! field with a given name from the application without allocating it.
+    void getFieldSize( const std::string &field_name, unsigned &field_dim,
+                       size_t &local_num_dofs );
+
+    //! Return true if the application registered a buffer for a field with a
+    //! given name.
+    bool hasFieldBuffer( const std::string &field_name ) const;
+
+    //! Get a field with a given name from the application. If the
+    //! application registered a buffer for this field, the field views the
+    //! buffer and no memory is allocated.
     Field<Scalar, Kokkos::LayoutLeft, MemorySpace>
     getField( const std::string &field_name );
 
@@ -110,9 +130,54 @@ class UserApplication
         const EvaluationSet<Kokkos::LayoutLeft, MemorySpace> eval_set,
         Field<Scalar, Kokkos::LayoutLeft, MemorySpace> field );
 
+  private:
+    // List extracted from the application and the geometry version at which
+    // it was extracted.
+    template <class List>
+    struct CachedList
+    {
+        bool valid = false;
+        size_t geometry_version = 0;
+        List list;
+    };
+
+    // Lists cached by geometry version.
+    struct ListCache
+    {
+        CachedList<NodeList<Kokkos::LayoutLeft, MemorySpace>> node_list;
+        CachedList<PolyhedronList<Kokkos::LayoutLeft, MemorySpace>> poly_list;
+        CachedList<CellList<Kokkos::LayoutLeft, MemorySpace>> cell_list;
+        CachedList<
+            std::pair<DOFMap<Kokkos::LayoutLeft, MemorySpace>, std::string>>
+            dof_map;
+    };
+
+    // Get a list from the cache if the geometry did not change since it was
+    // extracted, otherwise extract it from the application.
+    template <class List, class ExtractFunction>
+    List getCachedList( CachedList<List> &cache, ExtractFunction &&extract );
+
+    // Extract the lists from the application through the user functions.
+    NodeList<Kokkos::LayoutLeft, MemorySpace> extractNodeList();
+    PolyhedronList<Kokkos::LayoutLeft, MemorySpace> extractPolyhedronList();
+    CellList<Kokkos::LayoutLeft, MemorySpace> extractCellList();
+    DOFMap<Kokkos::LayoutLeft, MemorySpace>
+    extractDOFMap( std::string &discretization_type );
+
+    // Get the buffer registered by the application for a field. Return false
+    // if there is none.
+    bool getFieldBuffer(
+        const std::string &field_name,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, MemorySpace> &dofs ) const;
+
   private:
     // User function registry for this application.
     std::shared_ptr<UserFunctionRegistry<Scalar>> _user_functions;
+
+    // Lists cached by geometry version. The cache is stored in the registry
+    // so that it is shared with the other user applications of the same
+    // parallel model built from it.
+    std::shared_ptr<ListCache> _list_cache;
 };
 
 //---------------------------------------------------------------------------//
@@ -28,7 +28,27 @@ template <class Scalar, class ParallelModel>
 UserApplication<Scalar, ParallelModel>::UserApplication(
     const std::shared_ptr<UserFunctionRegistry<Scalar>> &user_functions )
     : _user_functions( user_functions )
-{ /* ... */
+{
+    auto &list_cache = _user_functions->_list_caches[std::type_index(
+        typeid( ListCache ) )];
+    if ( !list_cache )
+        list_cache = std::make_shared<ListCache>();
+    _list_cache = std::static_pointer_cast<ListCache>( list_cache );
+}
+
+//---------------------------------------------------------------------------//
+// Get the version of the geometry of the application.
+template <class Scalar, class ParallelModel>
+bool UserApplication<Scalar, ParallelModel>::getGeometryVersion(
+    size_t &geometry_version )
+{
+    // The geometry version function is optional.
+    if ( !_user_functions->_geometry_version_func.first )
+        return false;
+
+    callUserFunction( _user_functions->_geometry_version_func,
+                      geometry_version );
+    return true;
 }
 
 //---------------------------------------------------------------------------//
@@ -36,6 +56,16 @@ UserApplication<Scalar, ParallelModel>::UserApplication(
 template <class Scalar, class ParallelModel>
 auto UserApplication<Scalar, ParallelModel>::getNodeList()
     -> NodeList<Kokkos::LayoutLeft, MemorySpace>
+{
+    return getCachedList( _list_cache->node_list,
+                          [this]() { return extractNodeList(); } );
+}
+
+//---------------------------------------------------------------------------//
+// Extract a node list from the application.
+template <class Scalar, class ParallelModel>
+auto UserApplication<Scalar, ParallelModel>::extractNodeList()
+    -> NodeList<Kokkos::LayoutLeft, MemorySpace>
 {
     // Get the size of the node list.
     unsigned space_dim;
@@ -83,6 +113,16 @@ auto UserApplication<Scalar, ParallelModel>::getBoundingVolumeList()
 template <class Scalar, class ParallelModel>
 auto UserApplication<Scalar, ParallelModel>::getPolyhedronList()
     -> PolyhedronList<Kokkos::LayoutLeft, MemorySpace>
+{
+    return getCachedList( _list_cache->poly_list,
+                          [this]() { return extractPolyhedronList(); } );
+}
+
+//---------------------------------------------------------------------------//
+// Extract a polyhedron list from the application.
+template <class Scalar, class ParallelModel>
+auto UserApplication<Scalar, ParallelModel>::extractPolyhedronList()
+    -> PolyhedronList<Kokkos::LayoutLeft, MemorySpace>
 {
     // Get the size of the polyhedron list.
     unsigned space_dim;
@@ -119,6 +159,16 @@ auto UserApplication<Scalar, ParallelModel>::getPolyhedronList()
 template <class Scalar, class ParallelModel>
 auto UserApplication<Scalar, ParallelModel>::getCellList()
     -> CellList<Kokkos::LayoutLeft, MemorySpace>
+{
+    return getCachedList( _list_cache->cell_list,
+                          [this]() { return extractCellList(); } );
+}
+
+//---------------------------------------------------------------------------//
+// Extract a cell list from the application.
+template <class Scalar, class ParallelModel>
+auto UserApplication<Scalar, ParallelModel>::extractCellList()
+    -> CellList<Kokkos::LayoutLeft, MemorySpace>
 {
     // Get the size of the cell list.
     unsigned space_dim;
@@ -194,6 +244,23 @@ template <class Scalar, class ParallelModel>
 auto UserApplication<Scalar, ParallelModel>::getDOFMap(
     std::string &discretization_type )
     -> DOFMap<Kokkos::LayoutLeft, MemorySpace>
+{
+    // The discretization type is cached with the map.
+    auto dof_map = getCachedList( _list_cache->dof_map, [this]() {
+        std::pair<DOFMap<Kokkos::LayoutLeft, MemorySpace>, std::string> map;
+        map.first = extractDOFMap( map.second );
+        return map;
+    } );
+    discretization_type = dof_map.second;
+    return dof_map.first;
+}
+
+//---------------------------------------------------------------------------//
+// Extract a dof map from the application.
+template <class Scalar, class ParallelModel>
+auto UserApplication<Scalar, ParallelModel>::extractDOFMap(
+    std::string &discretization_type )
+    -> DOFMap<Kokkos::LayoutLeft, MemorySpace>
 {
     // Both types of dof id maps should not be defined.
     DTK_INSIST( !( _user_functions->_dof_map_size_func.first ) !=
@@ -251,6 +318,35 @@ auto UserApplication<Scalar, ParallelModel>::getDOFMap(
     return dof_map;
 }
 
+//---------------------------------------------------------------------------//
+// Get the size of a field with a given name from the application.
+template <class Scalar, class ParallelModel>
+void UserApplication<Scalar, ParallelModel>::getFieldSize(
+    const std::string &field_name, unsigned &field_dim,
+    size_t &local_num_dofs )
+{
+    // The size of a buffer is known without asking the application.
+    auto buffer = _user_functions->_field_buffers.find( field_name );
+    if ( buffer != _user_functions->_field_buffers.end() )
+    {
+        field_dim = buffer->second.field_dimension;
+        local_num_dofs = buffer->second.local_num_dofs;
+        return;
+    }
+
+    callUserFunction( _user_functions->_field_size_func, field_name, field_dim,
+                      local_num_dofs );
+}
+
+//---------------------------------------------------------------------------//
+// Check if the application registered a buffer for a field.
+template <class Scalar, class ParallelModel>
+bool UserApplication<Scalar, ParallelModel>::hasFieldBuffer(
+    const std::string &field_name ) const
+{
+    return _user_functions->_field_buffers.count( field_name ) > 0;
+}
+
 //---------------------------------------------------------------------------//
 // Get a field with a given name from the application.
 template <class Scalar, class ParallelModel>
@@ -258,12 +354,15 @@ auto UserApplication<Scalar, ParallelModel>::getField(
     const std::string &field_name )
     -> Field<Scalar, Kokkos::LayoutLeft, MemorySpace>
 {
+    // Use the buffer of the application in place if there is one.
+    Field<Scalar, Kokkos::LayoutLeft, MemorySpace> buffer_field;
+    if ( getFieldBuffer( field_name, buffer_field.dofs ) )
+        return buffer_field;
+
     // Get the size of the field.
     unsigned field_dim;
     size_t local_num_dofs;
-
-    callUserFunction( _user_functions->_field_size_func, field_name, field_dim,
-                      local_num_dofs );
+    getFieldSize( field_name, field_dim, local_num_dofs );
 
     // Allocate the field.
     auto field = InputAllocators<Kokkos::LayoutLeft, MemorySpace>::
@@ -279,6 +378,16 @@ void UserApplication<Scalar, ParallelModel>::pullField(
     const std::string &field_name,
     Field<Scalar, Kokkos::LayoutLeft, MemorySpace> field )
 {
+    // If the application registered a buffer for this field there is nothing
+    // to do unless the field does not view that buffer.
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, MemorySpace> buffer_dofs;
+    if ( getFieldBuffer( field_name, buffer_dofs ) )
+    {
+        if ( field.dofs.data() != buffer_dofs.data() )
+            Kokkos::deep_copy( field.dofs, buffer_dofs );
+        return;
+    }
+
     // Get the field from the user.
     View<Scalar> field_dofs( field.dofs );
     callUserFunction( _user_functions->_pull_field_func, field_name,
@@ -292,6 +401,16 @@ void UserApplication<Scalar, ParallelModel>::pushField(
     const std::string &field_name,
     const Field<Scalar, Kokkos::LayoutLeft, MemorySpace> field )
 {
+    // If the application registered a buffer for this field there is nothing
+    // to do unless the field does not view that buffer.
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, MemorySpace> buffer_dofs;
+    if ( getFieldBuffer( field_name, buffer_dofs ) )
+    {
+        if ( field.dofs.data() != buffer_dofs.data() )
+            Kokkos::deep_copy( buffer_dofs, field.dofs );
+        return;
+    }
+
     // Give the field to the user.
     View<Scalar> field_dofs( field.dofs );
     callUserFunction( _user_functions->_push_field_func, field_name,
@@ -314,6 +433,45 @@ void UserApplication<Scalar, ParallelModel>::evaluateField(
                       evaluation_points, object_ids, values );
 }
 
+//---------------------------------------------------------------------------//
+// Get a list from the cache or extract it from the application.
+template <class Scalar, class ParallelModel>
+template <class List, class ExtractFunction>
+List UserApplication<Scalar, ParallelModel>::getCachedList(
+    CachedList<List> &cache, ExtractFunction &&extract )
+{
+    // Without a geometry version the list is extracted every time.
+    size_t geometry_version;
+    if ( !getGeometryVersion( geometry_version ) )
+        return extract();
+
+    if ( !cache.valid || cache.geometry_version != geometry_version )
+    {
+        cache.list = extract();
+        cache.geometry_version = geometry_version;
+        cache.valid = true;
+    }
+    return cache.list;
+}
+
+//---------------------------------------------------------------------------//
+// Get the buffer registered by the application for a field.
+template <class Scalar, class ParallelModel>
+bool UserApplication<Scalar, ParallelModel>::getFieldBuffer(
+    const std::string &field_name,
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, MemorySpace> &dofs ) const
+{
+    auto buffer = _user_functions->_field_buffers.find( field_name );
+    if ( buffer == _user_functions->_field_buffers.end() )
+        return false;
+
+    // The view does not own the data.
+    dofs = Kokkos::View<Scalar **, Kokkos::LayoutLeft, MemorySpace>(
+        buffer->second.field_dofs, buffer->second.local_num_dofs,
+        buffer->second.field_dimension );
+    return true;
+}
+
 //---------------------------------------------------------------------------//
 
 } // namespace DataTransferKit
@@ -70,6 +70,16 @@ using NodeListSizeFunction =
 using NodeListDataFunction = std::function<void(
     std::shared_ptr<void> user_data, View<Coordinate> coordinates )>;
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Get the version of the geometry of the application. The version
+ * must change whenever the data returned by the node list, polyhedron list,
+ * cell list, or dof map functions changes. Lists extracted at the same
+ * version are reused.
+ */
+using GeometryVersionFunction = std::function<void(
+    std::shared_ptr<void> user_data, size_t &geometry_version )>;
+
 //---------------------------------------------------------------------------//
 /*!
  * \brief Get the size parameters for building a bounding volume list.
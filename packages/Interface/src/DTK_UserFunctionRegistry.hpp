@@ -24,6 +24,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <typeindex>
 #include <unordered_map>
 
 namespace DataTransferKit
@@ -72,6 +73,13 @@ class UserFunctionRegistry
     //! @name Set Geometry
     //@{
 
+    //! Geometry version function. This function is optional. If it is set,
+    //! the lists extracted from the application are cached until the version
+    //! changes.
+    void
+    setGeometryVersionFunction( GeometryVersionFunction &&func,
+                                std::shared_ptr<void> user_data = nullptr );
+
     //! Node list size function.
     void setNodeListSizeFunction( NodeListSizeFunction &&func,
                                   std::shared_ptr<void> user_data = nullptr );
@@ -167,12 +175,24 @@ class UserFunctionRegistry
     //! Evaluate field.
     void setEvaluateFieldFunction( EvaluateFieldFunction<Scalar> &&func,
                                    std::shared_ptr<void> user_data = nullptr );
+
+    //! Field buffer. The application keeps ownership of the buffer which must
+    //! remain valid until it is removed.
+    void setFieldBuffer( const std::string &field_name, Scalar *field_dofs,
+                         const unsigned field_dimension,
+                         const size_t local_num_dofs );
+
+    //! Remove a field buffer.
+    void removeFieldBuffer( const std::string &field_name );
     //@}
 
   private:
     //@{
     //! User Geometry functions.
 
+    //! Geometry version function.
+    UserImpl<GeometryVersionFunction> _geometry_version_func;
+
     //! Node list size function.
     UserImpl<NodeListSizeFunction> _node_list_size_func;
 
@@ -241,6 +261,27 @@ class UserFunctionRegistry
     //! Field evaluate data function.
     UserImpl<EvaluateFieldFunction<Scalar>> _eval_field_func;
     //@}
+
+    //@{
+    //! User Field buffers.
+
+    //! Field buffer owned by the application. The data is blocked by field
+    //! dimension with local_num_dofs values per dimension.
+    struct FieldBuffer
+    {
+        Scalar *field_dofs;
+        unsigned field_dimension;
+        size_t local_num_dofs;
+    };
+
+    //! Field buffers indexed by field name.
+    std::unordered_map<std::string, FieldBuffer> _field_buffers;
+    //@}
+
+    //! Lists extracted from the application by the user applications of each
+    //! parallel model. They are shared by all the user applications built
+    //! from this registry.
+    std::unordered_map<std::type_index, std::shared_ptr<void>> _list_caches;
 };
 
 //---------------------------------------------------------------------------//
@@ -19,6 +19,15 @@
 
 namespace DataTransferKit
 {
+//---------------------------------------------------------------------------//
+// Geometry version function.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::setGeometryVersionFunction(
+    GeometryVersionFunction &&func, std::shared_ptr<void> user_data )
+{
+    _geometry_version_func = std::make_pair( func, user_data );
+}
+
 //---------------------------------------------------------------------------//
 // Node list size function.
 template <class Scalar>
@@ -199,6 +208,26 @@ void UserFunctionRegistry<Scalar>::setEvaluateFieldFunction(
     _eval_field_func = std::make_pair( func, user_data );
 }
 
+//---------------------------------------------------------------------------//
+// Field buffer.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::setFieldBuffer(
+    const std::string &field_name, Scalar *field_dofs,
+    const unsigned field_dimension, const size_t local_num_dofs )
+{
+    _field_buffers[field_name] =
+        FieldBuffer{field_dofs, field_dimension, local_num_dofs};
+}
+
+//---------------------------------------------------------------------------//
+// Remove a field buffer.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::removeFieldBuffer(
+    const std::string &field_name )
+{
+    _field_buffers.erase( field_name );
+}
+
 //---------------------------------------------------------------------------//
 
 } // namespace DataTransferKit
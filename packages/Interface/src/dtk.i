@@ -31,9 +31,22 @@
 %rename DTK_createMap DTK_create_map;
 %rename DTK_isValidMap DTK_is_valid_map;
 %rename DTK_applyMap DTK_apply_map;
+%rename DTK_applyMapMulti DTK_apply_map_multi;
+%rename DTK_applyMapBegin DTK_apply_map_begin;
+%rename DTK_applyMapTest DTK_apply_map_test;
+%rename DTK_applyMapWait DTK_apply_map_wait;
 %rename DTK_destroyMap DTK_destroy_map;
 
+%rename DTK_createMapGroup DTK_create_map_group;
+%rename DTK_isValidMapGroup DTK_is_valid_map_group;
+%rename DTK_addToMapGroup DTK_add_to_map_group;
+%rename DTK_applyMapGroup DTK_apply_map_group;
+%rename DTK_applyMapGroupBegin DTK_apply_map_group_begin;
+%rename DTK_destroyMapGroup DTK_destroy_map_group;
+
 %rename DTK_setUserFunction DTK_set_user_function;
+%rename DTK_setFieldBuffer DTK_set_field_buffer;
+%rename DTK_removeFieldBuffer DTK_remove_field_buffer;
 
 %include <std_string.i>
 
@@ -53,10 +53,23 @@ struct UserTestClass
     const unsigned _offset = OFFSET;
     const std::string _field_name = FIELD_NAME;
     Kokkos::View<Scalar **> _data;
+    size_t _geometry_version = 0;
 };
 
 //---------------------------------------------------------------------------//
 // User functions.
+//---------------------------------------------------------------------------//
+// Get the version of the geometry.
+template <class Scalar, class ExecutionSpace>
+void geometryVersion( std::shared_ptr<void> user_data,
+                      size_t &geometry_version )
+{
+    auto u = std::static_pointer_cast<UserTestClass<Scalar, ExecutionSpace>>(
+        user_data );
+
+    geometry_version = u->_geometry_version;
+}
+
 //---------------------------------------------------------------------------//
 // Get the size parameters for building a node list.
 template <class Scalar, class ExecutionSpace>
@@ -553,6 +566,52 @@ TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, node_list, SC, DeviceType )
     test_node_list( user_app, out, success );
 }
 
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, geometry_version, SC,
+                                   DeviceType )
+{
+    // Test types.
+    using ExecutionSpace = typename DeviceType::execution_space;
+    using Scalar = SC;
+
+    // Create the test class.
+    auto u =
+        std::make_shared<UserAppTest::UserTestClass<Scalar, ExecutionSpace>>();
+
+    // Set the user functions.
+    auto registry =
+        std::make_shared<DataTransferKit::UserFunctionRegistry<Scalar>>();
+    registry->setNodeListSizeFunction(
+        UserAppTest::nodeListSize<Scalar, ExecutionSpace>, u );
+    registry->setNodeListDataFunction(
+        UserAppTest::nodeListData<Scalar, ExecutionSpace>, u );
+
+    // Create the user application.
+    DataTransferKit::UserApplication<Scalar, ExecutionSpace> user_app(
+        registry );
+
+    // Without a geometry version the list is extracted every time.
+    size_t geometry_version;
+    TEST_ASSERT( !user_app.getGeometryVersion( geometry_version ) );
+    TEST_INEQUALITY( user_app.getNodeList().coordinates.data(),
+                     user_app.getNodeList().coordinates.data() );
+
+    // With a geometry version the list is reused until the version changes.
+    registry->setGeometryVersionFunction(
+        UserAppTest::geometryVersion<Scalar, ExecutionSpace>, u );
+    TEST_ASSERT( user_app.getGeometryVersion( geometry_version ) );
+    TEST_EQUALITY( geometry_version, 0u );
+    auto node_list = user_app.getNodeList();
+    TEST_EQUALITY( user_app.getNodeList().coordinates.data(),
+                   node_list.coordinates.data() );
+    test_node_list( user_app, out, success );
+
+    u->_geometry_version = 1;
+    TEST_INEQUALITY( user_app.getNodeList().coordinates.data(),
+                     node_list.coordinates.data() );
+    test_node_list( user_app, out, success );
+}
+
 //---------------------------------------------------------------------------//
 TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, bounding_volume_list, SC,
                                    DeviceType )
@@ -786,6 +845,80 @@ TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, field_push_pull, SC,
     test_field_push_pull( user_app, out, success );
 }
 
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, field_buffer, SC,
+                                   DeviceType )
+{
+    // Test types.
+    using ExecutionSpace = typename DeviceType::execution_space;
+    using MemorySpace = typename ExecutionSpace::memory_space;
+    using Scalar = SC;
+
+    // Create the test class.
+    auto u =
+        std::make_shared<UserAppTest::UserTestClass<Scalar, ExecutionSpace>>();
+
+    // Set the user functions. They are only used once the buffer is removed.
+    auto registry =
+        std::make_shared<DataTransferKit::UserFunctionRegistry<Scalar>>();
+    registry->setFieldSizeFunction(
+        UserAppTest::fieldSize<Scalar, ExecutionSpace>, u );
+    registry->setPullFieldDataFunction(
+        UserAppTest::pullFieldData<Scalar, ExecutionSpace>, u );
+    registry->setPushFieldDataFunction(
+        UserAppTest::pushFieldData<Scalar, ExecutionSpace>, u );
+
+    // Register a buffer owned by the application.
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, MemorySpace> buffer(
+        "buffer", SIZE_1, SPACE_DIM );
+    registry->setFieldBuffer( FIELD_NAME, buffer.data(), SPACE_DIM, SIZE_1 );
+
+    // Create the user application.
+    DataTransferKit::UserApplication<Scalar, ExecutionSpace> user_app(
+        registry );
+
+    // The field views the buffer.
+    auto field = user_app.getField( FIELD_NAME );
+    TEST_EQUALITY( field.dofs.data(), buffer.data() );
+    TEST_EQUALITY( field.dofs.extent( 0 ), SIZE_1 );
+    TEST_EQUALITY( field.dofs.extent( 1 ), SPACE_DIM );
+    TEST_ASSERT( user_app.hasFieldBuffer( FIELD_NAME ) );
+    unsigned field_dim;
+    size_t local_num_dofs;
+    user_app.getFieldSize( FIELD_NAME, field_dim, local_num_dofs );
+    TEST_EQUALITY( field_dim, SPACE_DIM );
+    TEST_EQUALITY( local_num_dofs, SIZE_1 );
+
+    // Push and pull through the buffer.
+    test_field_push_pull( user_app, out, success );
+
+    // Fields which do not view the buffer are copied into it.
+    DataTransferKit::Field<Scalar, Kokkos::LayoutLeft, MemorySpace> copy;
+    copy.dofs = Kokkos::View<Scalar **, Kokkos::LayoutLeft, MemorySpace>(
+        "copy", SIZE_1, SPACE_DIM );
+    Kokkos::deep_copy( copy.dofs, 2.0 );
+    user_app.pushField( FIELD_NAME, copy );
+    auto host_buffer = Kokkos::create_mirror_view( buffer );
+    Kokkos::deep_copy( host_buffer, buffer );
+    for ( unsigned i = 0; i < SIZE_1; ++i )
+        for ( unsigned d = 0; d < SPACE_DIM; ++d )
+            TEST_EQUALITY( host_buffer( i, d ), 2.0 );
+
+    // The application data was never touched.
+    auto host_data = Kokkos::create_mirror_view( u->_data );
+    Kokkos::deep_copy( host_data, u->_data );
+    for ( unsigned i = 0; i < SIZE_1; ++i )
+        for ( unsigned d = 0; d < SPACE_DIM; ++d )
+            TEST_EQUALITY( host_data( i, d ), 0.0 );
+
+    // Once the buffer is removed the user functions are called again.
+    registry->removeFieldBuffer( FIELD_NAME );
+    TEST_ASSERT( !user_app.hasFieldBuffer( FIELD_NAME ) );
+    TEST_INEQUALITY( user_app.getField( FIELD_NAME ).dofs.data(),
+                     buffer.data() );
+    test_field_push_pull( user_app, out, success );
+}
+
 //---------------------------------------------------------------------------//
 TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, field_eval, SC, DeviceType )
 {
@@ -882,6 +1015,8 @@ TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, too_many_functions, SC,
     using DeviceType##NODE = typename NODE::device_type;                       \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, node_list, SCALAR,  \
                                           DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, geometry_version,   \
+                                          SCALAR, DeviceType##NODE )           \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT(                                      \
         UserApplication, bounding_volume_list, SCALAR, DeviceType##NODE )      \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, polyhedron_list,    \
@@ -898,6 +1033,8 @@ TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, too_many_functions, SC,
         UserApplication, multiple_topology_dof, SCALAR, DeviceType##NODE )     \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, field_push_pull,    \
                                           SCALAR, DeviceType##NODE )           \
+    TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, field_buffer,       \
+                                          SCALAR, DeviceType##NODE )           \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, field_eval, SCALAR, \
                                           DeviceType##NODE )                   \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, missing_function,   \
@@ -14,6 +14,8 @@
 
 #include <cerrno>
 #include <set>
+#include <string>
+#include <vector>
 
 //---------------------------------------------------------------------------//
 namespace DataTransferKit
@@ -21,6 +23,8 @@ namespace DataTransferKit
 
 // We store the reinterpret_cast versions of pointers
 static std::set<void *> valid_map_handles;
+static std::set<void *> valid_request_handles;
+static std::set<void *> valid_map_group_handles;
 
 //---------------------------------------------------------------------------//
 
@@ -75,6 +79,84 @@ void DTK_applyMap( DTK_MapHandle handle, const char *source_field,
     errno = DTK_SUCCESS;
 }
 
+//---------------------------------------------------------------------------//
+void DTK_applyMapMulti( DTK_MapHandle handle, int num_fields,
+                        const char **source_fields, const char **target_fields )
+{
+    if ( !DTK_isValidMap( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    std::vector<std::string> source_field_names( num_fields );
+    std::vector<std::string> target_field_names( num_fields );
+    for ( int f = 0; f < num_fields; ++f )
+    {
+        source_field_names[f] = source_fields[f];
+        target_field_names[f] = target_fields[f];
+    }
+
+    reinterpret_cast<DataTransferKit::DTK_Map *>( handle )->applyMulti(
+        source_field_names, target_field_names );
+
+    errno = DTK_SUCCESS;
+}
+
+//---------------------------------------------------------------------------//
+DTK_Request DTK_applyMapBegin( DTK_MapHandle handle, const char *source_field,
+                               const char *target_field )
+{
+    if ( !DTK_isValidMap( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return nullptr;
+    }
+
+    auto request = reinterpret_cast<DTK_Request>(
+        reinterpret_cast<DataTransferKit::DTK_Map *>( handle )
+            ->applyBegin( {std::string( source_field )},
+                          {std::string( target_field )} )
+            .release() );
+    DataTransferKit::valid_request_handles.insert( request );
+
+    errno = DTK_SUCCESS;
+
+    return request;
+}
+
+//---------------------------------------------------------------------------//
+bool DTK_applyMapTest( DTK_Request request )
+{
+    if ( !DataTransferKit::valid_request_handles.count( request ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return false;
+    }
+
+    errno = DTK_SUCCESS;
+    return reinterpret_cast<DataTransferKit::DTK_MapRequest *>( request )
+        ->test();
+}
+
+//---------------------------------------------------------------------------//
+void DTK_applyMapWait( DTK_Request request )
+{
+    if ( !DataTransferKit::valid_request_handles.count( request ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    auto map_request =
+        reinterpret_cast<DataTransferKit::DTK_MapRequest *>( request );
+    DataTransferKit::valid_request_handles.erase( request );
+    map_request->wait();
+    delete map_request;
+
+    errno = DTK_SUCCESS;
+}
+
 //---------------------------------------------------------------------------//
 void DTK_destroyMap( DTK_MapHandle handle )
 {
@@ -91,6 +173,111 @@ void DTK_destroyMap( DTK_MapHandle handle )
     }
 }
 
+//---------------------------------------------------------------------------//
+DTK_MapGroupHandle DTK_createMapGroup()
+{
+    if ( !DTK_isInitialized() )
+    {
+        errno = DTK_UNINITIALIZED;
+        return nullptr;
+    }
+
+    auto handle = reinterpret_cast<DTK_MapGroupHandle>(
+        new DataTransferKit::DTK_MapGroup );
+    DataTransferKit::valid_map_group_handles.insert( handle );
+
+    errno = DTK_SUCCESS;
+
+    return handle;
+}
+
+//---------------------------------------------------------------------------//
+bool DTK_isValidMapGroup( DTK_MapGroupHandle handle )
+{
+    errno = DTK_SUCCESS;
+    return DataTransferKit::valid_map_group_handles.count( handle );
+}
+
+//---------------------------------------------------------------------------//
+void DTK_addToMapGroup( DTK_MapGroupHandle group, DTK_MapHandle map,
+                        const char *source_field, const char *target_field )
+{
+    if ( !DTK_isValidMapGroup( group ) || !DTK_isValidMap( map ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    errno = DTK_SUCCESS;
+
+    // The map is rejected if it was created over another group of processes.
+    // The exception must not leave the C interface.
+    try
+    {
+        auto map_group =
+            reinterpret_cast<DataTransferKit::DTK_MapGroup *>( group );
+        map_group->add( reinterpret_cast<DataTransferKit::DTK_Map *>( map ),
+                        std::string( source_field ),
+                        std::string( target_field ) );
+    }
+    catch ( ... )
+    {
+        errno = DTK_UNKNOWN;
+    }
+}
+
+//---------------------------------------------------------------------------//
+DTK_Request DTK_applyMapGroupBegin( DTK_MapGroupHandle group )
+{
+    if ( !DTK_isValidMapGroup( group ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return nullptr;
+    }
+
+    // The maps may have been destroyed since they were added.
+    auto map_group = reinterpret_cast<DataTransferKit::DTK_MapGroup *>( group );
+    for ( auto const &entry : map_group->_entries )
+        if ( !DataTransferKit::valid_map_handles.count( entry.map ) )
+        {
+            errno = DTK_INVALID_HANDLE;
+            return nullptr;
+        }
+
+    auto request =
+        reinterpret_cast<DTK_Request>( map_group->applyBegin().release() );
+    DataTransferKit::valid_request_handles.insert( request );
+
+    errno = DTK_SUCCESS;
+
+    return request;
+}
+
+//---------------------------------------------------------------------------//
+void DTK_applyMapGroup( DTK_MapGroupHandle group )
+{
+    auto request = DTK_applyMapGroupBegin( group );
+    if ( errno != DTK_SUCCESS )
+        return;
+
+    DTK_applyMapWait( request );
+}
+
+//---------------------------------------------------------------------------//
+void DTK_destroyMapGroup( DTK_MapGroupHandle group )
+{
+    if ( DataTransferKit::valid_map_group_handles.count( group ) )
+    {
+        delete reinterpret_cast<DataTransferKit::DTK_MapGroup *>( group );
+        DataTransferKit::valid_map_group_handles.erase( group );
+        errno = DTK_SUCCESS;
+    }
+    else
+    {
+        errno = DTK_INVALID_HANDLE;
+    }
+}
+
 //---------------------------------------------------------------------------//
 
 } // end extern "C"
@@ -17,7 +17,15 @@
 
 #include <DTK_C_API.h>
 #include <DTK_C_API.hpp>
+#include <DTK_ConfigDefs.hpp>
 #include <DTK_DBC.hpp>
+#include <DTK_DelegatedEvaluationOperator.hpp>
+#include <DTK_DetailsFetchPlan.hpp>
+#include <DTK_EvaluationSet.hpp>
+#include <DTK_FETypes.h>
+#include <DTK_Field.hpp>
+#include <DTK_FiniteElementOperator.hpp>
+#include <DTK_Mesh.hpp>
 #include <DTK_MovingLeastSquaresOperator.hpp>
 #include <DTK_NearestNeighborOperator.hpp>
 #include <DTK_ParallelTraits.hpp>
@@ -29,12 +37,128 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 
 namespace DataTransferKit
 {
+//---------------------------------------------------------------------------//
+// Number of maps which reused the operator of an identical map built earlier
+// instead of building their own.
+inline std::atomic<std::size_t> &numReusedOperators()
+{
+    static std::atomic<std::size_t> count( 0 );
+    return count;
+}
+
+//---------------------------------------------------------------------------//
+// Get the group of processes of a communicator. The group is freed with the
+// last copy of the pointer.
+inline std::shared_ptr<MPI_Group> commGroup( MPI_Comm comm )
+{
+    std::shared_ptr<MPI_Group> group(
+        new MPI_Group( MPI_GROUP_NULL ), []( MPI_Group *g ) {
+            int finalized;
+            MPI_Finalized( &finalized );
+            if ( !finalized && *g != MPI_GROUP_NULL )
+                MPI_Group_free( g );
+            delete g;
+        } );
+    MPI_Comm_group( comm, group.get() );
+    return group;
+}
+
+//---------------------------------------------------------------------------//
+// Handle on an application of a map in progress. The source fields have been
+// pulled when the request is created and the target fields are pushed by
+// wait().
+struct DTK_MapRequest
+{
+    virtual ~DTK_MapRequest() = default;
+
+    // Return true if wait() does not need to wait for any communication.
+    virtual bool test() = 0;
+
+    // Complete the application of the map and push the target fields.
+    virtual void wait() = 0;
+};
+
+//---------------------------------------------------------------------------//
+// Applications of several maps started together. The maps executing on the
+// same device exchange the source values of all their fields in the same
+// messages so that each pair of processes exchanges a single message.
+class DTK_MapGroupRequest : public DTK_MapRequest
+{
+  public:
+    // Add the application of a map described by steps. The request of the map
+    // completes its application once the steps are done.
+    template <class DeviceType>
+    void add( std::unique_ptr<DTK_MapRequest> map_request,
+              std::vector<Details::FetchApplyStep<DeviceType>> const &steps )
+    {
+        _map_requests.push_back( std::move( map_request ) );
+        if ( steps.empty() )
+            return;
+
+        // The steps are gathered by device. The order in which the devices
+        // are first seen is the same on all the processes.
+        using Steps = std::vector<Details::FetchApplyStep<DeviceType>>;
+        auto &device_steps = _steps[std::type_index( typeid( DeviceType ) )];
+        if ( !device_steps )
+        {
+            auto new_steps = std::make_shared<Steps>();
+            device_steps = new_steps;
+            _starts.push_back( [new_steps]() {
+                return std::unique_ptr<PointCloudOperatorRequest>(
+                    new Details::FetchApplyRequest<DeviceType>( *new_steps ) );
+            } );
+        }
+        auto typed_steps = std::static_pointer_cast<Steps>( device_steps );
+        typed_steps->insert( typed_steps->end(), steps.begin(), steps.end() );
+    }
+
+    // Start the communication of all the maps added.
+    void start()
+    {
+        for ( auto const &start : _starts )
+            _requests.push_back( start() );
+    }
+
+    bool test() override
+    {
+        for ( auto &request : _requests )
+            if ( !request->test() )
+                return false;
+        return true;
+    }
+
+    void wait() override
+    {
+        for ( auto &request : _requests )
+            request->wait();
+        for ( auto &map_request : _map_requests )
+            map_request->wait();
+    }
+
+  private:
+    std::unordered_map<std::type_index, std::shared_ptr<void>> _steps;
+    std::vector<std::function<std::unique_ptr<PointCloudOperatorRequest>()>>
+        _starts;
+    std::vector<std::unique_ptr<PointCloudOperatorRequest>> _requests;
+    std::vector<std::unique_ptr<DTK_MapRequest>> _map_requests;
+};
+
 //---------------------------------------------------------------------------//
 // Map interface base class. This allows us to hide the device template
 // parameter in MapImpl when we do the casting in the C interface
@@ -48,6 +172,68 @@ struct DTK_Map
 
     virtual void apply( const std::string &source_field_name,
                         const std::string &target_field_name ) = 0;
+
+    virtual void
+    applyMulti( const std::vector<std::string> &source_field_names,
+                const std::vector<std::string> &target_field_names ) = 0;
+
+    virtual std::unique_ptr<DTK_MapRequest>
+    applyBegin( const std::vector<std::string> &source_field_names,
+                const std::vector<std::string> &target_field_names ) = 0;
+
+    // Pull the source fields and add the application of the map to a group
+    // of maps applied together.
+    virtual void
+    addToGroup( DTK_MapGroupRequest &group,
+                const std::vector<std::string> &source_field_names,
+                const std::vector<std::string> &target_field_names ) = 0;
+
+    // Get the group of processes over which the map was built.
+    virtual std::shared_ptr<MPI_Group> processGroup() const = 0;
+};
+
+//---------------------------------------------------------------------------//
+// Maps applied together. The maps must be built over the same group of
+// processes and must outlive the group.
+struct DTK_MapGroup
+{
+    struct Entry
+    {
+        DTK_Map *map;
+        std::string source_field_name;
+        std::string target_field_name;
+    };
+
+    // Add the application of a map. The data of all the maps is exchanged
+    // over the communicator of the first one so the maps built over a
+    // different group of processes are rejected.
+    void add( DTK_Map *map, std::string const &source_field_name,
+              std::string const &target_field_name )
+    {
+        auto const group = map->processGroup();
+        if ( !_group )
+            _group = group;
+        int result;
+        MPI_Group_compare( *_group, *group, &result );
+        if ( result != MPI_IDENT )
+            throw DataTransferKitException(
+                "The maps of a group must be built over the same group of "
+                "processes" );
+        _entries.push_back( {map, source_field_name, target_field_name} );
+    }
+
+    std::unique_ptr<DTK_MapRequest> applyBegin()
+    {
+        std::unique_ptr<DTK_MapGroupRequest> request( new DTK_MapGroupRequest );
+        for ( auto const &entry : _entries )
+            entry.map->addToGroup( *request, {entry.source_field_name},
+                                   {entry.target_field_name} );
+        request->start();
+        return std::move( request );
+    }
+
+    std::vector<Entry> _entries;
+    std::shared_ptr<MPI_Group> _group;
 };
 
 //---------------------------------------------------------------------------//
@@ -55,40 +241,429 @@ template <class MapExecSpace, class SourceMemSpace, class TargetMemSpace>
 struct DTK_MapImpl : public DTK_Map
 {
     using map_device_type = typename MapExecSpace::device_type;
+    using source_field_type =
+        Field<double, Kokkos::LayoutLeft,
+              typename SourceMemSpace::memory_space>;
+    using target_field_type =
+        Field<double, Kokkos::LayoutLeft,
+              typename TargetMemSpace::memory_space>;
 
     DTK_MapImpl( MPI_Comm comm, DTK_UserApplicationHandle source,
                  DTK_UserApplicationHandle target,
-                 boost::property_tree::ptree const &ptree )
-        : _source( reinterpret_cast<DTK_Registry *>( source )->_registry )
-        , _target( reinterpret_cast<DTK_Registry *>( target )->_registry )
+                 boost::property_tree::ptree const &ptree,
+                 std::string const &options )
+        : _source( registry( source ) )
+        , _target( registry( target ) )
+        , _has_source( source != nullptr )
+        , _has_target( target != nullptr )
     {
+        DTK_INSIST( _has_source || _has_target );
+
+        // The map builds its operator over its own copy of the communicator
+        // so that the caller may free its communicator. The source and target
+        // may live on disjoint groups of processes connected by an
+        // intercommunicator. The map is then built over the union of the two
+        // groups with the source processes first.
+        _comm = std::shared_ptr<MPI_Comm>(
+            new MPI_Comm( MPI_COMM_NULL ), []( MPI_Comm *c ) {
+                int finalized;
+                MPI_Finalized( &finalized );
+                if ( !finalized && *c != MPI_COMM_NULL )
+                    MPI_Comm_free( c );
+                delete c;
+            } );
+        int is_intercomm;
+        MPI_Comm_test_inter( comm, &is_intercomm );
+        if ( is_intercomm )
+        {
+            DTK_INSIST( _has_source != _has_target );
+            MPI_Intercomm_merge( comm, _has_target, _comm.get() );
+        }
+        else
+            MPI_Comm_dup( comm, _comm.get() );
+        comm = *_comm;
+        _group = commGroup( comm );
+
         // FOR NOW JUST CREATE A NEAREST NEIGHBOR OPERATOR FOR DEMONSTRATION
         // PURPOSES. THIS WILL BE REPLACED BY A PROPER FACTORY.
 
-        // Get coordinates from the source and target.
-        auto source_nodes = _source.getNodeList().coordinates;
-        auto target_nodes = _target.getNodeList().coordinates;
-
-        // For now things are layout left in the interface so copy to a
-        // matching layout that is compatible with the operator.
-        Kokkos::View<Coordinate **, map_device_type> source_nodes_copy(
-            "src_nodes_copy", source_nodes.extent( 0 ),
-            source_nodes.extent( 1 ) );
-        Kokkos::deep_copy( source_nodes_copy, source_nodes );
-        Kokkos::View<Coordinate **, map_device_type> target_nodes_copy(
-            "tgt_nodes_copy", target_nodes.extent( 0 ),
-            target_nodes.extent( 1 ) );
-        Kokkos::deep_copy( target_nodes_copy, target_nodes );
-
+        // Get coordinates from the source and target. With delegated
+        // evaluation, the source application evaluates the fields itself and
+        // only the bounding volumes of its objects are needed. They are
+        // hashed as rows of 6 coordinates. Finite element maps use the nodes
+        // of the cells of the source mesh.
         auto const which_map =
             ptree.get<std::string>( "Map Type", "Undefined" );
+        _delegated = ( which_map == "Delegated Evaluation" ||
+                       which_map == "Evaluate" );
+        bool const finite_element =
+            ( which_map == "Finite Element" || which_map == "FE" );
+        Kokkos::View<Coordinate * * [2], map_device_type> source_volumes_copy;
+        Kokkos::View<Coordinate **, map_device_type> source_nodes_copy;
+        SourceCells source_cells;
+        if ( _delegated )
+        {
+            source_volumes_copy = boundingVolumes( _source, _has_source,
+                                                   "src_volumes_copy" );
+            source_nodes_copy = Kokkos::View<Coordinate **, map_device_type>(
+                source_volumes_copy.data(), source_volumes_copy.extent( 0 ),
+                6 );
+        }
+        else if ( finite_element )
+        {
+            source_cells = sourceCells( _source, _has_source );
+            source_nodes_copy = source_cells.nodes;
+        }
+        else
+            source_nodes_copy =
+                nodeCoordinates( _source, _has_source, "src_nodes_copy" );
+        auto target_nodes_copy =
+            nodeCoordinates( _target, _has_target, "tgt_nodes_copy" );
+
+        // Reuse the operator of an identical map built earlier if all the
+        // processes still have it. When the applications provide the
+        // versions of their geometry, the map is identified without hashing
+        // the nodes. A reused operator comes with the communicator of the map
+        // which built it.
+        auto const geometry = geometryKey( source, target );
+        _map = findOperator( comm, options,
+                             [&geometry]( CachedOperator const &cached ) {
+                                 return sameGeometry( cached.geometry,
+                                                      geometry );
+                             },
+                             _map_comm );
+        if ( !_map )
+        {
+            auto const hash = hashNodes( comm, source_nodes_copy,
+                                         target_nodes_copy, source_cells );
+            _map = findOperator( comm, options,
+                                 [&hash]( CachedOperator const &cached ) {
+                                     return cached.hash == hash;
+                                 },
+                                 _map_comm );
+            if ( !_map )
+            {
+                _map = createOperator( comm, ptree, which_map,
+                                       source_nodes_copy, source_volumes_copy,
+                                       source_cells, target_nodes_copy );
+                _map_comm = _comm;
+            }
+            else
+                ++numReusedOperators();
+            storeOperator( options, geometry, hash, _map, _map_comm );
+        }
+        else
+            ++numReusedOperators();
+
+        // The source application evaluates the fields at the points routed
+        // to it.
+        if ( _delegated )
+        {
+            auto const op = std::dynamic_pointer_cast<
+                DelegatedEvaluationOperator<map_device_type>>( _map );
+            DTK_CHECK( op != nullptr );
+            auto const evaluation_points = op->evaluationPoints();
+            auto const object_ids = op->objectIds();
+            _evaluation_set.evaluation_points =
+                decltype( _evaluation_set.evaluation_points )(
+                    "evaluation_points", evaluation_points.extent( 0 ),
+                    evaluation_points.extent( 1 ) );
+            Kokkos::deep_copy( _evaluation_set.evaluation_points,
+                               evaluation_points );
+            _evaluation_set.object_ids = decltype( _evaluation_set.object_ids )(
+                "object_ids", object_ids.extent( 0 ) );
+            Kokkos::deep_copy( _evaluation_set.object_ids, object_ids );
+        }
+    }
+
+    void apply( const std::string &source_field_name,
+                const std::string &target_field_name ) override
+    {
+        // Get the fields. They are only allocated the first time they are
+        // transferred or when their size changes.
+        source_field_type source_field;
+        target_field_type target_field;
+        getFields( source_field_name, target_field_name, source_field,
+                   target_field );
+
+        // Pull the data from the source.
+        pullSourceField( source_field_name, source_field );
+
+        // Fields with more than one dimension are transferred with all their
+        // components together.
+        if ( source_field.dofs.extent( 1 ) != 1 )
+        {
+            transferBegin( {source_field_name}, {source_field},
+                           {target_field_name}, {target_field} )
+                ->wait();
+            return;
+        }
+
+        // Scalar fields are used in place if they live in the memory space of
+        // the map, otherwise they are copied to a staging buffer.
+        DTK_REQUIRE( target_field.dofs.extent( 1 ) == 1 );
+        auto source_dofs =
+            inMapSpace( source_field.dofs, "source " + source_field_name );
+        if ( source_dofs.data() != source_field.dofs.data() )
+            Kokkos::deep_copy( source_dofs, source_field.dofs );
+        auto target_dofs =
+            inMapSpace( target_field.dofs, "target " + target_field_name );
+
+        // Apply the map.
+        _map->apply( firstColumn( source_dofs ), firstColumn( target_dofs ) );
+
+        // Copy the transferred field back to the original target memory space.
+        if ( target_dofs.data() != target_field.dofs.data() )
+            Kokkos::deep_copy( target_field.dofs, target_dofs );
+
+        // Push the data to the target.
+        if ( _has_target )
+            _target.pushField( target_field_name, target_field );
+    }
+
+    void
+    applyMulti( const std::vector<std::string> &source_field_names,
+                const std::vector<std::string> &target_field_names ) override
+    {
+        applyBegin( source_field_names, target_field_names )->wait();
+    }
+
+    std::unique_ptr<DTK_MapRequest>
+    applyBegin( const std::vector<std::string> &source_field_names,
+                const std::vector<std::string> &target_field_names ) override
+    {
+        std::vector<source_field_type> source_fields;
+        std::vector<target_field_type> target_fields;
+        pullFields( source_field_names, target_field_names, source_fields,
+                    target_fields );
+
+        // Transfer all the fields at once.
+        return transferBegin( source_field_names, source_fields,
+                              target_field_names, target_fields );
+    }
+
+    void
+    addToGroup( DTK_MapGroupRequest &group,
+                const std::vector<std::string> &source_field_names,
+                const std::vector<std::string> &target_field_names ) override
+    {
+        std::vector<source_field_type> source_fields;
+        std::vector<target_field_type> target_fields;
+        pullFields( source_field_names, target_field_names, source_fields,
+                    target_fields );
+
+        // The group starts the application of the map.
+        std::vector<Details::FetchApplyStep<map_device_type>> steps;
+        auto request =
+            transferPrepare( source_field_names, source_fields,
+                             target_field_names, target_fields, steps );
+        group.add( std::move( request ), steps );
+    }
+
+    std::shared_ptr<MPI_Group> processGroup() const override { return _group; }
+
+    // Get the fields and pull the data of all the source fields.
+    void pullFields( std::vector<std::string> const &source_field_names,
+                     std::vector<std::string> const &target_field_names,
+                     std::vector<source_field_type> &source_fields,
+                     std::vector<target_field_type> &target_fields )
+    {
+        DTK_REQUIRE( source_field_names.size() == target_field_names.size() );
+        int const n_fields = source_field_names.size();
+        source_fields.resize( n_fields );
+        target_fields.resize( n_fields );
+        for ( int f = 0; f < n_fields; ++f )
+        {
+            getFields( source_field_names[f], target_field_names[f],
+                       source_fields[f], target_fields[f] );
+            pullSourceField( source_field_names[f], source_fields[f] );
+        }
+    }
+
+    // Pull the data of a source field. With delegated evaluation, the source
+    // application evaluates the field at the points routed to it instead.
+    void pullSourceField( std::string const &source_field_name,
+                          source_field_type &source_field )
+    {
+        if ( !_has_source )
+            return;
+        if ( _delegated )
+            _source.evaluateField( source_field_name, _evaluation_set,
+                                   source_field );
+        else
+            _source.pullField( source_field_name, source_field );
+    }
+
+    // Application of the map to several fields in progress.
+    struct Request : public DTK_MapRequest
+    {
+        bool test() override { return !_request || _request->test(); }
+
+        void wait() override
+        {
+            // The operator is applied by the group when the map is part of
+            // one.
+            if ( _request )
+            {
+                _request->wait();
+                _request.reset();
+            }
+
+            // Unpack and push the data of all the target fields.
+            for ( unsigned int f = 0; f < _target_fields.size(); ++f )
+                _map_impl->unpackColumns( _target_values, _column_offset[f],
+                                          _target_field_names[f],
+                                          _target_fields[f].dofs );
+            if ( _map_impl->_has_target )
+                for ( unsigned int f = 0; f < _target_fields.size(); ++f )
+                    _map_impl->_target.pushField( _target_field_names[f],
+                                                  _target_fields[f] );
+
+            // Give the staging values back to the map for the next
+            // application.
+            if ( !_target_fields.empty() )
+            {
+                _map_impl->releaseValues( _source_values_label,
+                                          _source_values );
+                _map_impl->releaseValues( _target_values_label,
+                                          _target_values );
+            }
+            _target_fields.clear();
+        }
+
+        DTK_MapImpl *_map_impl;
+        std::vector<std::string> _target_field_names;
+        std::vector<target_field_type> _target_fields;
+        std::vector<int> _column_offset;
+        std::string _source_values_label;
+        std::string _target_values_label;
+        Kokkos::View<double **, map_device_type> _source_values;
+        Kokkos::View<double **, map_device_type> _target_values;
+        std::unique_ptr<PointCloudOperatorRequest> _request;
+    };
+
+    // Start transferring all the components of the fields with a single
+    // application of the map.
+    std::unique_ptr<DTK_MapRequest>
+    transferBegin( std::vector<std::string> const &source_field_names,
+                   std::vector<source_field_type> const &source_fields,
+                   std::vector<std::string> const &target_field_names,
+                   std::vector<target_field_type> const &target_fields )
+    {
+        std::vector<Details::FetchApplyStep<map_device_type>> steps;
+        auto request =
+            transferPrepare( source_field_names, source_fields,
+                             target_field_names, target_fields, steps );
+        if ( !steps.empty() )
+            request->_request = std::unique_ptr<PointCloudOperatorRequest>(
+                new Details::FetchApplyRequest<map_device_type>( steps ) );
+        return std::move( request );
+    }
+
+    // Pack the source fields to transfer all their components with a single
+    // application of the map. The components are packed in the columns of a
+    // rank-2 view so that the values of all the fields are exchanged in the
+    // same messages. The application is added to \p steps, unless there are
+    // no fields, and is not started.
+    std::unique_ptr<Request> transferPrepare(
+        std::vector<std::string> const &source_field_names,
+        std::vector<source_field_type> const &source_fields,
+        std::vector<std::string> const &target_field_names,
+        std::vector<target_field_type> const &target_fields,
+        std::vector<Details::FetchApplyStep<map_device_type>> &steps )
+    {
+        DTK_REQUIRE( source_fields.size() == target_fields.size() );
+        DTK_REQUIRE( source_fields.size() == source_field_names.size() );
+        DTK_REQUIRE( target_fields.size() == target_field_names.size() );
+        int const n_fields = source_fields.size();
+
+        std::unique_ptr<Request> request( new Request );
+        request->_map_impl = this;
+        request->_target_field_names = target_field_names;
+        request->_target_fields = target_fields;
+        if ( n_fields == 0 )
+            return request;
+
+        // Compute the first column of each field.
+        auto &column_offset = request->_column_offset;
+        column_offset.assign( n_fields + 1, 0 );
+        for ( int f = 0; f < n_fields; ++f )
+        {
+            DTK_REQUIRE( source_fields[f].dofs.extent( 1 ) ==
+                         target_fields[f].dofs.extent( 1 ) );
+            DTK_REQUIRE( source_fields[f].dofs.extent( 0 ) ==
+                         source_fields[0].dofs.extent( 0 ) );
+            DTK_REQUIRE( target_fields[f].dofs.extent( 0 ) ==
+                         target_fields[0].dofs.extent( 0 ) );
+            column_offset[f + 1] =
+                column_offset[f] + source_fields[f].dofs.extent( 1 );
+        }
+
+        // Pack the source fields. The staging buffers are identified by the
+        // names of all the fields transferred together.
+        std::string fields_label;
+        for ( int f = 0; f < n_fields; ++f )
+            fields_label +=
+                " " + source_field_names[f] + ":" + target_field_names[f];
+        request->_source_values_label = "source values" + fields_label;
+        request->_source_values = acquireValues(
+            request->_source_values_label, source_fields[0].dofs.extent( 0 ),
+            column_offset.back() );
+        for ( int f = 0; f < n_fields; ++f )
+            packColumns( source_fields[f].dofs, source_field_names[f],
+                         request->_source_values, column_offset[f] );
+
+        // Prepare the application of the map.
+        request->_target_values_label = "target values" + fields_label;
+        request->_target_values = acquireValues(
+            request->_target_values_label, target_fields[0].dofs.extent( 0 ),
+            column_offset.back() );
+        steps.push_back( _map->prepareApply( request->_source_values,
+                                             request->_target_values ) );
+
+        return request;
+    }
+
+    // Cells of the source mesh of a finite element map and degrees of
+    // freedom of each cell in the order of its basis functions.
+    struct SourceCells
+    {
+        Kokkos::View<Coordinate **, map_device_type> nodes;
+        Kokkos::View<DTK_CellTopology *, map_device_type> topologies;
+        Kokkos::View<unsigned int *, map_device_type> cells;
+        Kokkos::View<LocalOrdinal *, map_device_type> dof_ids;
+        DTK_FEType fe_type = DTK_HGRAD;
+    };
+
+    // Create the operator selected by the options.
+    std::shared_ptr<PointCloudOperator<map_device_type>> createOperator(
+        MPI_Comm comm, boost::property_tree::ptree const &ptree,
+        std::string const &which_map,
+        Kokkos::View<Coordinate **, map_device_type> source_nodes,
+        Kokkos::View<Coordinate * * [2], map_device_type> source_volumes,
+        SourceCells const &source_cells,
+        Kokkos::View<Coordinate **, map_device_type> target_nodes ) const
+    {
         if ( which_map == "Undefined" )
             throw DataTransferKitException(
                 R"(Field "Map Type" is not defined in options string argument for map creation)" );
+        else if ( _delegated )
+            return std::unique_ptr<
+                DelegatedEvaluationOperator<map_device_type>>(
+                new DelegatedEvaluationOperator<map_device_type>(
+                    comm, source_volumes, target_nodes ) );
+        else if ( which_map == "Finite Element" || which_map == "FE" )
+            return std::unique_ptr<FiniteElementOperator<map_device_type>>(
+                new FiniteElementOperator<map_device_type>(
+                    comm,
+                    Mesh<map_device_type>( source_cells.topologies,
+                                           source_cells.cells, source_nodes ),
+                    source_cells.dof_ids, source_cells.fe_type,
+                    target_nodes ) );
         else if ( which_map == "Nearest Neighbor" || which_map == "NN" )
-            _map = std::unique_ptr<NearestNeighborOperator<map_device_type>>(
+            return std::unique_ptr<NearestNeighborOperator<map_device_type>>(
                 new NearestNeighborOperator<map_device_type>(
-                    comm, source_nodes_copy, target_nodes_copy ) );
+                    comm, source_nodes, target_nodes ) );
         else if ( which_map == "Moving Least Squares" || which_map == "MLS" )
         {
             // NOTE if field "Order" is misspelled (for instance first letter
@@ -96,21 +671,21 @@ struct DTK_MapImpl : public DTK_Map
             // picked up without a warning or an error being raised.
             auto const order = ptree.get<std::string>( "Order", "Linear" );
             if ( order == "Linear" || order == "1" )
-                _map = std::unique_ptr<MovingLeastSquaresOperator<
+                return std::unique_ptr<MovingLeastSquaresOperator<
                     map_device_type, Wendland<0>,
                     MultivariatePolynomialBasis<Linear, 3>>>(
                     new MovingLeastSquaresOperator<
                         map_device_type, Wendland<0>,
                         MultivariatePolynomialBasis<Linear, 3>>(
-                        comm, source_nodes_copy, target_nodes_copy ) );
+                        comm, source_nodes, target_nodes ) );
             else if ( order == "Quadratic" || order == "2" )
-                _map = std::unique_ptr<MovingLeastSquaresOperator<
+                return std::unique_ptr<MovingLeastSquaresOperator<
                     map_device_type, Wendland<0>,
                     MultivariatePolynomialBasis<Quadratic, 3>>>(
                     new MovingLeastSquaresOperator<
                         map_device_type, Wendland<0>,
                         MultivariatePolynomialBasis<Quadratic, 3>>(
-                        comm, source_nodes_copy, target_nodes_copy ) );
+                        comm, source_nodes, target_nodes ) );
             else
                 throw DataTransferKitException(
                     "Invalid order \"" + order +
@@ -121,42 +696,549 @@ struct DTK_MapImpl : public DTK_Map
                                             "\"" );
     }
 
-    void apply( const std::string &source_field_name,
-                const std::string &target_field_name ) override
+    // Registries and geometry versions of the source and target applications
+    // of a map. The key is only valid if all the applications taking part on
+    // this process provide a geometry version.
+    struct GeometryKey
     {
-        // Create fields.
-        auto source_field = _source.getField( source_field_name );
-        auto target_field = _target.getField( target_field_name );
+        bool valid = false;
+        std::array<std::weak_ptr<UserFunctionRegistry<double>>, 2> registries;
+        std::array<size_t, 2> versions = {{0, 0}};
+    };
 
-        // Pull the data from the source.
-        _source.pullField( source_field_name, source_field );
-
-        // Copy to a compatible layout. Nearest neighbor operator needs a
-        // compatible layout and only 1 dimension
-        int num_src = source_field.dofs.extent( 0 );
-        Kokkos::View<double *, map_device_type> source_field_copy(
-            "source_field_copy", num_src );
-        Kokkos::deep_copy(
-            source_field_copy,
-            Kokkos::subview( source_field.dofs, Kokkos::ALL, 0 ) );
-        int num_tgt = target_field.dofs.extent( 0 );
-        Kokkos::View<double *, map_device_type> target_field_copy(
-            "target_field_copy", num_tgt );
+    GeometryKey geometryKey( DTK_UserApplicationHandle source,
+                             DTK_UserApplicationHandle target )
+    {
+        GeometryKey geometry;
+        geometry.valid = true;
+        if ( _has_source )
+        {
+            geometry.registries[0] = registry( source );
+            geometry.valid = _source.getGeometryVersion( geometry.versions[0] );
+        }
+        if ( _has_target )
+        {
+            geometry.registries[1] = registry( target );
+            geometry.valid =
+                _target.getGeometryVersion( geometry.versions[1] ) &&
+                geometry.valid;
+        }
+        return geometry;
+    }
 
-        // Apply the map.
-        _map->apply( source_field_copy, target_field_copy );
+    // Whether two keys identify the same geometry. The registries are
+    // compared by ownership so that a registry destroyed since cannot match a
+    // new one.
+    static bool sameGeometry( GeometryKey const &a, GeometryKey const &b )
+    {
+        if ( !a.valid || !b.valid || a.versions != b.versions )
+            return false;
+        for ( int i = 0; i < 2; ++i )
+            if ( a.registries[i].owner_before( b.registries[i] ) ||
+                 b.registries[i].owner_before( a.registries[i] ) )
+                return false;
+        return true;
+    }
 
-        // Copy the transferred field back to the original target layout.
-        Kokkos::deep_copy( Kokkos::subview( target_field.dofs, Kokkos::ALL, 0 ),
-                           target_field_copy );
+    // Operator shared by the maps of this type built for the same options
+    // over the same group of processes and with the same geometry or the same
+    // hash of the coordinates of the nodes. The operator may keep using the
+    // communicator it was built on so every map sharing the operator also
+    // shares this communicator.
+    struct CachedOperator
+    {
+        std::string options;
+        GeometryKey geometry;
+        std::array<std::uint64_t, 2> hash;
+        std::shared_ptr<MPI_Group> group;
+        std::weak_ptr<PointCloudOperator<map_device_type>> op;
+        std::weak_ptr<MPI_Comm> comm;
+    };
 
-        // Push the data to the target.
-        _target.pushField( target_field_name, target_field );
+    // Get the operators shared by the maps of this type. An operator is
+    // destroyed with the last map using it. The maps may be created from
+    // several threads so the cache is only accessed with its mutex locked.
+    static std::vector<CachedOperator> &operatorCache()
+    {
+        static std::vector<CachedOperator> cache;
+        return cache;
+    }
+
+    static std::mutex &operatorCacheMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // Hash the coordinates of the source and target nodes of all the
+    // processes. Each process hashes its rank and its nodes with two
+    // independent functions, FNV-1a and the hash_combine of Boost applied to
+    // each byte, and the hashes are combined over the communicator so that
+    // all the processes get the same result. The cells of the source mesh
+    // are hashed too for the finite element maps.
+    static std::array<std::uint64_t, 2>
+    hashNodes( MPI_Comm comm,
+               Kokkos::View<Coordinate **, map_device_type> source_nodes,
+               Kokkos::View<Coordinate **, map_device_type> target_nodes,
+               SourceCells const &source_cells )
+    {
+        std::array<std::uint64_t, 2> hash = {{14695981039346656037ull, 0}};
+        auto hash_bytes = [&hash]( void const *data, size_t const size ) {
+            auto const bytes = static_cast<unsigned char const *>( data );
+            for ( size_t i = 0; i < size; ++i )
+            {
+                hash[0] = ( hash[0] ^ bytes[i] ) * 1099511628211ull;
+                hash[1] ^= bytes[i] + 0x9e3779b97f4a7c15ull + ( hash[1] << 6 ) +
+                           ( hash[1] >> 2 );
+            }
+        };
+
+        int comm_rank;
+        MPI_Comm_rank( comm, &comm_rank );
+        hash_bytes( &comm_rank, sizeof( comm_rank ) );
+        for ( auto const &nodes : {source_nodes, target_nodes} )
+        {
+            auto nodes_host = Kokkos::create_mirror_view( nodes );
+            Kokkos::deep_copy( nodes_host, nodes );
+            std::array<size_t, 2> const extents = {nodes.extent( 0 ),
+                                                   nodes.extent( 1 )};
+            hash_bytes( extents.data(), sizeof( extents ) );
+            hash_bytes( nodes_host.data(),
+                        nodes_host.span() * sizeof( Coordinate ) );
+        }
+        auto topologies_host =
+            Kokkos::create_mirror_view( source_cells.topologies );
+        Kokkos::deep_copy( topologies_host, source_cells.topologies );
+        auto cells_host = Kokkos::create_mirror_view( source_cells.cells );
+        Kokkos::deep_copy( cells_host, source_cells.cells );
+        auto dof_ids_host = Kokkos::create_mirror_view( source_cells.dof_ids );
+        Kokkos::deep_copy( dof_ids_host, source_cells.dof_ids );
+        std::array<size_t, 3> const sizes = {
+            topologies_host.size(), cells_host.size(), dof_ids_host.size()};
+        hash_bytes( sizes.data(), sizeof( sizes ) );
+        hash_bytes( topologies_host.data(),
+                    topologies_host.span() * sizeof( DTK_CellTopology ) );
+        hash_bytes( cells_host.data(),
+                    cells_host.span() * sizeof( unsigned int ) );
+        hash_bytes( dof_ids_host.data(),
+                    dof_ids_host.span() * sizeof( LocalOrdinal ) );
+        hash_bytes( &source_cells.fe_type, sizeof( source_cells.fe_type ) );
+
+        std::array<std::uint64_t, 2> global_hash;
+        MPI_Allreduce( hash.data(), global_hash.data(), 2, MPI_UINT64_T,
+                       MPI_BXOR, comm );
+        return global_hash;
+    }
+
+    // Find the operator of an identical map, i.e., built with the same
+    // options over the same group of processes and for which \p match
+    // returns true, and the communicator it was built on. The lookup is
+    // collective and the operator is only reused if all the processes found
+    // it.
+    template <class Match>
+    static std::shared_ptr<PointCloudOperator<map_device_type>>
+    findOperator( MPI_Comm comm, std::string const &options, Match &&match,
+                  std::shared_ptr<MPI_Comm> &op_comm )
+    {
+        MPI_Group group;
+        MPI_Comm_group( comm, &group );
+        std::shared_ptr<PointCloudOperator<map_device_type>> op;
+        op_comm.reset();
+        {
+            std::lock_guard<std::mutex> lock( operatorCacheMutex() );
+
+            // Forget about the operators that are not used anymore.
+            auto &cache = operatorCache();
+            cache.erase( std::remove_if( cache.begin(), cache.end(),
+                                         []( CachedOperator const &cached ) {
+                                             return cached.op.expired();
+                                         } ),
+                         cache.end() );
+
+            for ( auto const &cached : cache )
+            {
+                int result;
+                MPI_Group_compare( *cached.group, group, &result );
+                if ( cached.options == options && match( cached ) &&
+                     result == MPI_IDENT )
+                {
+                    op = cached.op.lock();
+                    op_comm = cached.comm.lock();
+                    break;
+                }
+            }
+        }
+        MPI_Group_free( &group );
+
+        int const found = ( op != nullptr && op_comm != nullptr );
+        int found_everywhere;
+        MPI_Allreduce( &found, &found_everywhere, 1, MPI_INT, MPI_MIN, comm );
+        if ( !found_everywhere )
+        {
+            op.reset();
+            op_comm.reset();
+        }
+        return op;
+    }
+
+    // Share an operator and the communicator it was built on with the
+    // identical maps created later.
+    static void
+    storeOperator( std::string const &options, GeometryKey const &geometry,
+                   std::array<std::uint64_t, 2> const &hash,
+                   std::shared_ptr<PointCloudOperator<map_device_type>> op,
+                   std::shared_ptr<MPI_Comm> op_comm )
+    {
+        CachedOperator cached;
+        cached.options = options;
+        cached.geometry = geometry;
+        cached.hash = hash;
+        cached.group = commGroup( *op_comm );
+        cached.op = op;
+        cached.comm = op_comm;
+        std::lock_guard<std::mutex> lock( operatorCacheMutex() );
+        operatorCache().push_back( cached );
+    }
+
+    // Get the registry of an application. Processes which do not take part in
+    // the application get an empty registry.
+    static std::shared_ptr<UserFunctionRegistry<double>>
+    registry( DTK_UserApplicationHandle handle )
+    {
+        if ( handle == nullptr )
+            return std::make_shared<UserFunctionRegistry<double>>();
+        return reinterpret_cast<DTK_Registry *>( handle )->_registry;
+    }
+
+    // Get the coordinates of the nodes of an application. For now things are
+    // layout left in the interface so copy to a matching layout that is
+    // compatible with the operator. Processes which do not take part in the
+    // application contribute no nodes.
+    template <class ParallelModel>
+    static Kokkos::View<Coordinate **, map_device_type>
+    nodeCoordinates( UserApplication<double, ParallelModel> &application,
+                     bool const has_application, std::string const &label )
+    {
+        if ( !has_application )
+            return Kokkos::View<Coordinate **, map_device_type>( label, 0, 3 );
+
+        auto nodes = application.getNodeList().coordinates;
+        Kokkos::View<Coordinate **, map_device_type> nodes_copy(
+            label, nodes.extent( 0 ), nodes.extent( 1 ) );
+        Kokkos::deep_copy( nodes_copy, nodes );
+        return nodes_copy;
+    }
+
+    // Get the bounding volumes of the objects of an application. Processes
+    // which do not take part in the application contribute no volumes.
+    template <class ParallelModel>
+    static Kokkos::View<Coordinate * * [2], map_device_type>
+    boundingVolumes( UserApplication<double, ParallelModel> &application,
+                     bool const has_application, std::string const &label )
+    {
+        if ( !has_application )
+            return Kokkos::View<Coordinate * * [2], map_device_type>( label, 0,
+                                                                     3 );
+
+        auto volumes = application.getBoundingVolumeList().bounding_volumes;
+        Kokkos::View<Coordinate * * [2], map_device_type> volumes_copy(
+            label, volumes.extent( 0 ), volumes.extent( 1 ) );
+        Kokkos::deep_copy( volumes_copy, volumes );
+        return volumes_copy;
+    }
+
+    // Get the cells of the source mesh of a finite element map from the cell
+    // list and the degree-of-freedom map of an application. The
+    // discretization type of the map selects the finite element. Processes
+    // which do not take part in the application contribute no cells.
+    template <class ParallelModel>
+    static SourceCells
+    sourceCells( UserApplication<double, ParallelModel> &application,
+                 bool const has_application )
+    {
+        SourceCells source_cells;
+        if ( !has_application )
+        {
+            source_cells.nodes =
+                Kokkos::View<Coordinate **, map_device_type>( "src_nodes_copy",
+                                                              0, 3 );
+            return source_cells;
+        }
+
+        auto const cell_list = application.getCellList();
+        source_cells.nodes = Kokkos::View<Coordinate **, map_device_type>(
+            "src_nodes_copy", cell_list.coordinates.extent( 0 ),
+            cell_list.coordinates.extent( 1 ) );
+        Kokkos::deep_copy( source_cells.nodes, cell_list.coordinates );
+        source_cells.topologies =
+            Kokkos::View<DTK_CellTopology *, map_device_type>(
+                "src_cell_topologies", cell_list.cell_topologies.extent( 0 ) );
+        Kokkos::deep_copy( source_cells.topologies, cell_list.cell_topologies );
+
+        // The mesh uses unsigned node indices.
+        auto cells = Kokkos::create_mirror_view( cell_list.cells );
+        Kokkos::deep_copy( cells, cell_list.cells );
+        source_cells.cells = Kokkos::View<unsigned int *, map_device_type>(
+            "src_cells", cells.extent( 0 ) );
+        auto cells_host = Kokkos::create_mirror_view( source_cells.cells );
+        for ( unsigned int i = 0; i < cells.extent( 0 ); ++i )
+            cells_host( i ) = cells( i );
+        Kokkos::deep_copy( source_cells.cells, cells_host );
+
+        // Flatten the degrees of freedom of the cells. They are given per
+        // cell either in a rank-2 view, when all the cells have the same
+        // number of degrees of freedom, or in a rank-1 view.
+        std::string discretization_type;
+        auto const dof_map = application.getDOFMap( discretization_type );
+        source_cells.fe_type = feType( discretization_type );
+        auto object_dof_ids =
+            Kokkos::create_mirror_view( dof_map.object_dof_ids );
+        Kokkos::deep_copy( object_dof_ids, dof_map.object_dof_ids );
+        source_cells.dof_ids = Kokkos::View<LocalOrdinal *, map_device_type>(
+            "src_cell_dof_ids", object_dof_ids.size() );
+        auto dof_ids_host = Kokkos::create_mirror_view( source_cells.dof_ids );
+        if ( object_dof_ids.rank() == 1 )
+            for ( unsigned int i = 0; i < object_dof_ids.extent( 0 ); ++i )
+                dof_ids_host( i ) = object_dof_ids( i );
+        else
+        {
+            unsigned int const dofs_per_cell = object_dof_ids.extent( 1 );
+            for ( unsigned int c = 0; c < object_dof_ids.extent( 0 ); ++c )
+                for ( unsigned int j = 0; j < dofs_per_cell; ++j )
+                    dof_ids_host( c * dofs_per_cell + j ) =
+                        object_dof_ids( c, j );
+        }
+        Kokkos::deep_copy( source_cells.dof_ids, dof_ids_host );
+
+        return source_cells;
+    }
+
+    // Get the finite element corresponding to the discretization type of a
+    // degree-of-freedom map. The default is the H(grad) element.
+    static DTK_FEType feType( std::string const &discretization_type )
+    {
+        if ( discretization_type.empty() || discretization_type == "HGRAD" )
+            return DTK_HGRAD;
+        else if ( discretization_type == "HDIV" )
+            return DTK_HDIV;
+        else if ( discretization_type == "HCURL" )
+            return DTK_HCURL;
+        else
+            throw DataTransferKitException(
+                "Invalid discretization type \"" + discretization_type +
+                "\" for creating a finite element map" );
+    }
+
+    // Get the source and target fields. Processes which do not take part in
+    // one of the applications get an empty field with the dimension of the
+    // field of the other one.
+    void getFields( std::string const &source_field_name,
+                    std::string const &target_field_name,
+                    source_field_type &source_field,
+                    target_field_type &target_field )
+    {
+        if ( _has_source )
+            source_field =
+                _delegated
+                    ? evaluationField( source_field_name )
+                    : getField( _source, source_field_name,
+                                _source_field_cache );
+        if ( _has_target )
+            target_field =
+                getField( _target, target_field_name, _target_field_cache );
+        if ( !_has_source )
+            source_field.dofs = decltype( source_field.dofs )(
+                "source_dofs", 0, target_field.dofs.extent( 1 ) );
+        if ( !_has_target )
+            target_field.dofs = decltype( target_field.dofs )(
+                "target_dofs", 0, source_field.dofs.extent( 1 ) );
+    }
+
+    // Get a field from an application. The field is cached and is only
+    // allocated again when the size reported by the application changes.
+    // Fields for which the application registered a buffer view that buffer
+    // and are not cached.
+    template <class ParallelModel, class FieldType>
+    static FieldType
+    getField( UserApplication<double, ParallelModel> &application,
+              std::string const &field_name,
+              std::unordered_map<std::string, FieldType> &cache )
+    {
+        if ( application.hasFieldBuffer( field_name ) )
+            return application.getField( field_name );
+
+        unsigned field_dim;
+        size_t local_num_dofs;
+        application.getFieldSize( field_name, field_dim, local_num_dofs );
+        auto &field = cache[field_name];
+        if ( field.dofs.extent( 0 ) != local_num_dofs ||
+             field.dofs.extent( 1 ) != field_dim )
+            field = application.getField( field_name );
+        return field;
+    }
+
+    // Get the field holding the values of a source field at the evaluation
+    // points. It is only allocated again when the number of points or the
+    // dimension of the field changes.
+    source_field_type evaluationField( std::string const &field_name )
+    {
+        unsigned field_dim;
+        size_t local_num_dofs;
+        _source.getFieldSize( field_name, field_dim, local_num_dofs );
+        size_t const n_points = _evaluation_set.object_ids.extent( 0 );
+        auto &field = _source_field_cache[field_name];
+        if ( field.dofs.extent( 0 ) != n_points ||
+             field.dofs.extent( 1 ) != field_dim )
+            field.dofs = decltype( field.dofs )( "evaluated_" + field_name,
+                                                 n_points, field_dim );
+        return field;
+    }
+
+    // Get a staging buffer with a given label. The buffer is only allocated
+    // again when its size changes.
+    template <class ViewType>
+    static ViewType
+    stagingBuffer( std::unordered_map<std::string, ViewType> &buffers,
+                   std::string const &label, size_t const n0,
+                   size_t const n1 )
+    {
+        auto &buffer = buffers[label];
+        if ( buffer.extent( 0 ) != n0 || buffer.extent( 1 ) != n1 )
+            buffer = ViewType( label, n0, n1 );
+        return buffer;
+    }
+
+    // Take the staging values with the given label out of the map. A request
+    // owns its values until it completes so that requests in progress on the
+    // same fields do not overwrite each other. The values are allocated when
+    // another request holds them.
+    Kokkos::View<double **, map_device_type>
+    acquireValues( std::string const &label, size_t const n0, size_t const n1 )
+    {
+        Kokkos::View<double **, map_device_type> values;
+        auto const it = _staging_values.find( label );
+        if ( it != _staging_values.end() )
+        {
+            values = it->second;
+            _staging_values.erase( it );
+        }
+        if ( values.extent( 0 ) != n0 || values.extent( 1 ) != n1 )
+            values = Kokkos::View<double **, map_device_type>( label, n0, n1 );
+        return values;
+    }
+
+    // Give the staging values of a completed request back to the map.
+    void releaseValues( std::string const &label,
+                        Kokkos::View<double **, map_device_type> const &values )
+    {
+        _staging_values[label] = values;
+    }
+
+    // View the first column of field degrees of freedom in the memory space
+    // of the map. The first column of a LayoutLeft view is contiguous.
+    static Kokkos::View<double *, map_device_type> firstColumn(
+        Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type> const
+            &dofs )
+    {
+        return Kokkos::View<double *, map_device_type>( dofs.data(),
+                                                        dofs.extent( 0 ) );
+    }
+
+    // Get the field degrees of freedom in the memory space of the map. The
+    // data is viewed in place when it is in that memory space. Otherwise, the
+    // staging buffer with the given label is used.
+    template <class MemorySpace>
+    Kokkos::View<double **, Kokkos::LayoutLeft, map_device_type> inMapSpace(
+        Kokkos::View<double **, Kokkos::LayoutLeft, MemorySpace> const &dofs,
+        std::string const &label )
+    {
+        if ( std::is_same<MemorySpace,
+                          typename map_device_type::memory_space>::value )
+            return Kokkos::View<double **, Kokkos::LayoutLeft,
+                                map_device_type>(
+                dofs.data(), dofs.extent( 0 ), dofs.extent( 1 ) );
+        return stagingBuffer( _staging_dofs, label, dofs.extent( 0 ),
+                              dofs.extent( 1 ) );
+    }
+
+    // Copy the degrees of freedom of a source field into the columns of the
+    // values starting at column offset.
+    template <class MemorySpace>
+    void packColumns(
+        Kokkos::View<double **, Kokkos::LayoutLeft, MemorySpace> const &dofs,
+        std::string const &field_name,
+        Kokkos::View<double **, map_device_type> const &values,
+        int const offset )
+    {
+        auto map_dofs = inMapSpace( dofs, "source " + field_name );
+        if ( map_dofs.data() != dofs.data() )
+            Kokkos::deep_copy( map_dofs, dofs );
+        int const n_columns = map_dofs.extent( 1 );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "pack_columns" ),
+            Kokkos::RangePolicy<MapExecSpace>( 0, map_dofs.extent( 0 ) ),
+            KOKKOS_LAMBDA( int const i ) {
+                for ( int d = 0; d < n_columns; ++d )
+                    values( i, offset + d ) = map_dofs( i, d );
+            } );
+        Kokkos::fence();
+    }
+
+    // Copy the columns of the values starting at column offset into the
+    // degrees of freedom of a target field.
+    template <class MemorySpace>
+    void unpackColumns(
+        Kokkos::View<double **, map_device_type> const &values,
+        int const offset, std::string const &field_name,
+        Kokkos::View<double **, Kokkos::LayoutLeft, MemorySpace> const &dofs )
+    {
+        auto map_dofs = inMapSpace( dofs, "target " + field_name );
+        int const n_columns = map_dofs.extent( 1 );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "unpack_columns" ),
+            Kokkos::RangePolicy<MapExecSpace>( 0, map_dofs.extent( 0 ) ),
+            KOKKOS_LAMBDA( int const i ) {
+                for ( int d = 0; d < n_columns; ++d )
+                    map_dofs( i, d ) = values( i, offset + d );
+            } );
+        Kokkos::fence();
+        if ( map_dofs.data() != dofs.data() )
+            Kokkos::deep_copy( dofs, map_dofs );
     }
 
     UserApplication<double, SourceMemSpace> _source;
     UserApplication<double, TargetMemSpace> _target;
-    std::unique_ptr<PointCloudOperator<map_device_type>> _map;
+    bool _has_source;
+    bool _has_target;
+    // Whether the source application evaluates the fields at the points
+    // routed to it rather than providing their degrees of freedom.
+    bool _delegated;
+    EvaluationSet<Kokkos::LayoutLeft, typename SourceMemSpace::memory_space>
+        _evaluation_set;
+    // Copy of the communicator given to the map, or union of the source and
+    // target groups when the map is created over an intercommunicator.
+    std::shared_ptr<MPI_Comm> _comm;
+    // Group of processes over which the map is built.
+    std::shared_ptr<MPI_Group> _group;
+    // The operator may be shared with other maps. It is kept with the
+    // communicator it was built on, which belongs to the map which built it.
+    // The communicator is declared first so that it outlives the operator.
+    std::shared_ptr<MPI_Comm> _map_comm;
+    std::shared_ptr<PointCloudOperator<map_device_type>> _map;
+
+    // Fields and staging buffers kept between applications of the map so
+    // that repeated applications to the same fields do not allocate memory.
+    // The fields and the staging degrees of freedom are only used while a
+    // request is started or completed. The staging values are used while the
+    // request is in progress and each request takes its own (see
+    // acquireValues()).
+    std::unordered_map<std::string, source_field_type> _source_field_cache;
+    std::unordered_map<std::string, target_field_type> _target_field_cache;
+    std::unordered_map<std::string, Kokkos::View<double **, Kokkos::LayoutLeft,
+                                                 map_device_type>>
+        _staging_dofs;
+    std::unordered_map<std::string, Kokkos::View<double **, map_device_type>>
+        _staging_values;
 };
 
 //---------------------------------------------------------------------------//
@@ -256,11 +1338,18 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
     //          "for map creation" );
     //  }
 
-    // Get the user source and target memory spaces.
+    // Get the user source and target memory spaces. Processes which do not
+    // take part in one of the applications use the memory space of the other
+    // one.
+    DTK_INSIST( source != nullptr || target != nullptr );
     DTK_MemorySpace src_space =
-        reinterpret_cast<DataTransferKit::DTK_Registry *>( source )->_space;
+        reinterpret_cast<DataTransferKit::DTK_Registry *>(
+            source != nullptr ? source : target )
+            ->_space;
     DTK_MemorySpace tgt_space =
-        reinterpret_cast<DataTransferKit::DTK_Registry *>( target )->_space;
+        reinterpret_cast<DataTransferKit::DTK_Registry *>(
+            target != nullptr ? target : source )
+            ->_space;
 
     // Check up front that we have been asked for execution and memory spaces
     // that are available in the kokkos build. This lets use a little cleaner
@@ -280,13 +1369,13 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             {
             case DTK_HOST_SPACE:
                 map = new DTK_MapImpl<Serial, HostSpace, HostSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
                 break;
 
             case DTK_CUDAUVM_SPACE:
 #if defined( KOKKOS_ENABLE_CUDA )
                 map = new DTK_MapImpl<Serial, HostSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
 #endif
                 break;
             }
@@ -298,12 +1387,12 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             {
             case DTK_HOST_SPACE:
                 map = new DTK_MapImpl<Serial, CudaUVMSpace, HostSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
                 break;
 
             case DTK_CUDAUVM_SPACE:
                 map = new DTK_MapImpl<Serial, CudaUVMSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
                 break;
             }
 #endif
@@ -321,13 +1410,13 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             {
             case DTK_HOST_SPACE:
                 map = new DTK_MapImpl<OpenMP, HostSpace, HostSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
                 break;
 
             case DTK_CUDAUVM_SPACE:
 #if defined( KOKKOS_ENABLE_CUDA )
                 map = new DTK_MapImpl<OpenMP, HostSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
 #endif
                 break;
             }
@@ -339,12 +1428,12 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             {
             case DTK_HOST_SPACE:
                 map = new DTK_MapImpl<OpenMP, CudaUVMSpace, HostSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
                 break;
 
             case DTK_CUDAUVM_SPACE:
                 map = new DTK_MapImpl<OpenMP, CudaUVMSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
                 break;
             }
 #endif
@@ -363,12 +1452,12 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             {
             case DTK_HOST_SPACE:
                 map = new DTK_MapImpl<Cuda, HostSpace, HostSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
                 break;
 
             case DTK_CUDAUVM_SPACE:
                 map = new DTK_MapImpl<Cuda, HostSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
                 break;
             }
 #endif
@@ -380,12 +1469,12 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             case DTK_HOST_SPACE:
 #if defined( KOKKOS_ENABLE_SERIAL ) || defined( KOKKOS_ENABLE_OPENMP )
                 map = new DTK_MapImpl<Cuda, CudaUVMSpace, HostSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
 #endif
                 break;
             case DTK_CUDAUVM_SPACE:
                 map = new DTK_MapImpl<Cuda, CudaUVMSpace, CudaUVMSpace>(
-                    comm, source, target, ptree );
+                    comm, source, target, ptree, options );
                 break;
             }
             break;
@@ -0,0 +1,169 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file
+ * \brief Finite element interpolation used by the maps.
+ */
+#ifndef DTK_FINITE_ELEMENT_OPERATOR_HPP
+#define DTK_FINITE_ELEMENT_OPERATOR_HPP
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_DetailsFetchPlan.hpp>
+#include <DTK_FETypes.h>
+#include <DTK_Interpolation.hpp>
+#include <DTK_Mesh.hpp>
+#include <DTK_PointCloudOperator.hpp>
+#include <DTK_Types.h>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <memory>
+
+namespace DataTransferKit
+{
+/**
+ * This class evaluates the finite element representation of the source
+ * fields at the target points. Each target point is located in a cell of the
+ * source mesh once when the operator is built and its value is then a
+ * cell-local evaluation of the basis functions. The source values are the
+ * values of the degrees of freedom and the target points which are not in
+ * any cell get zero.
+ *
+ * The interpolation communicates with blocking calls so the target values
+ * are computed when the application is started and the request returned by
+ * applyBegin() only copies them.
+ */
+template <typename DeviceType>
+class FiniteElementOperator : public PointCloudOperator<DeviceType>
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    /**
+     * Constructor. The degrees of freedom of the cells are given by
+     * \p cell_dof_ids (see Interpolation).
+     */
+    FiniteElementOperator(
+        MPI_Comm comm, Mesh<DeviceType> const &mesh,
+        Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids,
+        DTK_FEType fe_type,
+        Kokkos::View<Coordinate **, DeviceType> target_points )
+        : _comm( duplicate( comm ) )
+        , _interpolation( *_comm, mesh, target_points, cell_dof_ids, fe_type )
+        , _n_targets( target_points.extent_int( 0 ) )
+    {
+    }
+
+    void
+    apply( Kokkos::View<double const *, DeviceType> source_values,
+           Kokkos::View<double *, DeviceType> target_values ) const override
+    {
+        // Transfer the values as a single column.
+        Kokkos::View<double const **, DeviceType> source_column(
+            source_values.data(), source_values.extent( 0 ), 1 );
+        Kokkos::View<double **, DeviceType> target_column(
+            target_values.data(), target_values.extent( 0 ), 1 );
+        apply( source_column, target_column );
+    }
+
+    void
+    apply( Kokkos::View<double const **, DeviceType> source_values,
+           Kokkos::View<double **, DeviceType> target_values ) const override
+    {
+        applyBegin( source_values, target_values )->wait();
+    }
+
+    std::unique_ptr<PointCloudOperatorRequest> applyBegin(
+        Kokkos::View<double const **, DeviceType> source_values,
+        Kokkos::View<double **, DeviceType> target_values ) const override
+    {
+        return std::unique_ptr<PointCloudOperatorRequest>(
+            new Details::FetchApplyRequest<DeviceType>(
+                {prepareApply( source_values, target_values )} ) );
+    }
+
+    Details::FetchApplyStep<DeviceType> prepareApply(
+        Kokkos::View<double const **, DeviceType> source_values,
+        Kokkos::View<double **, DeviceType> target_values ) const override
+    {
+        DTK_REQUIRE( _n_targets == target_values.extent_int( 0 ) );
+        DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+        // Nothing is fetched so the step has no plan.
+        auto const values = interpolate( source_values );
+        return {nullptr, source_values,
+                [target_values, values]( Kokkos::View<double **, DeviceType> ) {
+                    Kokkos::deep_copy( target_values, values );
+                }};
+    }
+
+  private:
+    // Duplicate the communicator. The interpolation keeps using it after the
+    // operator is built, possibly after the communicator given to the
+    // constructor was freed since the operator may be shared by several maps.
+    static std::shared_ptr<MPI_Comm> duplicate( MPI_Comm comm )
+    {
+        std::shared_ptr<MPI_Comm> copy(
+            new MPI_Comm( MPI_COMM_NULL ), []( MPI_Comm *c ) {
+                int finalized;
+                MPI_Finalized( &finalized );
+                if ( !finalized && *c != MPI_COMM_NULL )
+                    MPI_Comm_free( c );
+                delete c;
+            } );
+        MPI_Comm_dup( comm, copy.get() );
+        return copy;
+    }
+
+    // Interpolate the fields in the columns of source_values at the target
+    // points. This is a collective operation.
+    Kokkos::View<double **, DeviceType>
+    interpolate( Kokkos::View<double const **, DeviceType> source_values ) const
+    {
+        int const n_fields = source_values.extent( 1 );
+        Kokkos::View<double **, DeviceType> dof_values(
+            "dof_values", source_values.extent( 0 ), n_fields );
+        Kokkos::deep_copy( dof_values, source_values );
+        Kokkos::View<double **, DeviceType> found_values(
+            "found_values", _n_targets, n_fields );
+        auto const found_ids = _interpolation.apply( dof_values, found_values );
+
+        // The values of the points found come first, sorted by point, so put
+        // them back in place.
+        Kokkos::View<double **, DeviceType> values( "values", _n_targets,
+                                                    n_fields );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "scatter_found_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, _n_targets ),
+            KOKKOS_LAMBDA( int const i ) {
+                int const point = found_ids( i );
+                if ( point >= 0 )
+                    for ( int j = 0; j < n_fields; ++j )
+                        values( point, j ) = found_values( i, j );
+            } );
+        Kokkos::fence();
+        return values;
+    }
+
+    // Communicator owned by the operator. It is declared first so that it
+    // outlives the interpolation.
+    std::shared_ptr<MPI_Comm> _comm;
+    // Interpolation::apply() is not const.
+    mutable Interpolation<DeviceType> _interpolation;
+    int _n_targets;
+};
+
+} // namespace DataTransferKit
+
+#endif
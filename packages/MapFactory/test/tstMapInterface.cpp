@@ -16,6 +16,7 @@
 //---------------------------------------------------------------------------//
 
 #include <DTK_C_API.h>
+#include <DTK_C_API_Map.hpp> // numReusedOperators
 #include <DTK_DBC.hpp>
 #include <DTK_ParallelTraits.hpp>
 
@@ -25,6 +26,9 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <mpi.h>
+
+#include <cstring>
 #include <memory>
 
 //---------------------------------------------------------------------------//
@@ -34,10 +38,14 @@ struct TestUserData
 {
     Kokkos::View<double * [3], Space> coords;
     Kokkos::View<double *, Space> field;
+    Kokkos::View<double *, Space> other_field;
+    size_t geometry_version = 0;
+    int num_node_list_calls = 0;
 
     TestUserData( const int size )
         : coords( "coords", size )
         , field( "field", size )
+        , other_field( "other_field", size )
     {
     }
 };
@@ -55,35 +63,172 @@ template <class Space>
 void nodeListData( void *user_data, Coordinate *coords )
 {
     TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
+    ++data->num_node_list_calls;
     int num_node = data->coords.extent( 0 );
     for ( unsigned n = 0; n < data->coords.extent( 0 ); ++n )
         for ( unsigned d = 0; d < data->coords.extent( 1 ); ++d )
             coords[num_node * d + n] = data->coords( n, d );
 }
 
+template <class Space>
+void geometryVersion( void *user_data, size_t *geometry_version )
+{
+    TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
+    *geometry_version = data->geometry_version;
+}
+
+// Each node is bounded by a box of half-width 0.25.
+template <class Space>
+void boundingVolumeListSize( void *user_data, unsigned *space_dim,
+                             size_t *local_num_volumes )
+{
+    TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
+    *space_dim = data->coords.extent( 1 );
+    *local_num_volumes = data->coords.extent( 0 );
+}
+
+template <class Space>
+void boundingVolumeListData( void *user_data, Coordinate *bounding_volumes )
+{
+    TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
+    int num_volume = data->coords.extent( 0 );
+    int space_dim = data->coords.extent( 1 );
+    for ( int v = 0; v < num_volume; ++v )
+        for ( int d = 0; d < space_dim; ++d )
+        {
+            bounding_volumes[d * num_volume + v] = data->coords( v, d ) - 0.25;
+            bounding_volumes[( space_dim + d ) * num_volume + v] =
+                data->coords( v, d ) + 0.25;
+        }
+}
+
+// Offsets of the vertices of the reference hexahedron.
+int const hex_vertex_offsets[8][3] = {{-1, -1, -1}, {1, -1, -1}, {1, 1, -1},
+                                      {-1, 1, -1},  {-1, -1, 1}, {1, -1, 1},
+                                      {1, 1, 1},    {-1, 1, 1}};
+
+// Trilinear field interpolated exactly by the finite element maps.
+double trilinearField( double const x, double const y, double const z )
+{
+    return x + 2. * y + 3. * z + 1e-6 * x * y * z;
+}
+
+// Each node is the center of a hexahedron of half-width 0.25 with its own
+// vertices.
+template <class Space>
+void cellListSize( void *user_data, unsigned *space_dim,
+                   size_t *local_num_nodes, size_t *local_num_cells,
+                   size_t *total_cell_nodes )
+{
+    TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
+    *space_dim = data->coords.extent( 1 );
+    *local_num_nodes = 8 * data->coords.extent( 0 );
+    *local_num_cells = data->coords.extent( 0 );
+    *total_cell_nodes = 8 * data->coords.extent( 0 );
+}
+
+template <class Space>
+void cellListData( void *user_data, Coordinate *coordinates,
+                   LocalOrdinal *cells, DTK_CellTopology *cell_topologies )
+{
+    TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
+    int num_cell = data->coords.extent( 0 );
+    int num_node = 8 * num_cell;
+    for ( int c = 0; c < num_cell; ++c )
+    {
+        for ( int v = 0; v < 8; ++v )
+        {
+            for ( int d = 0; d < 3; ++d )
+                coordinates[d * num_node + 8 * c + v] =
+                    data->coords( c, d ) + 0.25 * hex_vertex_offsets[v][d];
+            cells[8 * c + v] = 8 * c + v;
+        }
+        cell_topologies[c] = DTK_HEX_8;
+    }
+}
+
+// Each vertex of the hexahedra has its own degree of freedom.
+template <class Space>
+void dofMapSize( void *user_data, size_t *local_num_dofs,
+                 size_t *local_num_objects, unsigned *dofs_per_object )
+{
+    TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
+    *local_num_dofs = 8 * data->coords.extent( 0 );
+    *local_num_objects = data->coords.extent( 0 );
+    *dofs_per_object = 8;
+}
+
+template <class Space>
+void dofMapData( void *user_data, GlobalOrdinal *global_dof_ids,
+                 LocalOrdinal *object_dof_ids, char *discretization_type )
+{
+    TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
+    int num_cell = data->coords.extent( 0 );
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    for ( int c = 0; c < num_cell; ++c )
+        for ( int v = 0; v < 8; ++v )
+        {
+            global_dof_ids[8 * c + v] = 8 * ( comm_rank * num_cell + c ) + v;
+            object_dof_ids[v * num_cell + c] = 8 * c + v;
+        }
+    std::strcpy( discretization_type, "HGRAD" );
+}
+
+// The field named "vertex" has the values of the trilinear field at the
+// vertices of the hexahedra.
 template <class Space>
 void fieldSize( void *user_data, const char *field_name,
                 unsigned *field_dimension, size_t *local_num_dofs )
 {
     TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
-    field_name = "dummy_field";
     *field_dimension = 1;
-    *local_num_dofs = data->field.extent( 0 );
+    *local_num_dofs = std::strcmp( field_name, "vertex" ) == 0
+                          ? 8 * data->coords.extent( 0 )
+                          : data->field.extent( 0 );
 }
 
 template <class Space>
-void pullField( void *user_data, const char *, double *field_dofs )
+void pullField( void *user_data, const char *field_name, double *field_dofs )
 {
     TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
+    if ( std::strcmp( field_name, "vertex" ) == 0 )
+    {
+        for ( unsigned c = 0; c < data->coords.extent( 0 ); ++c )
+            for ( int v = 0; v < 8; ++v )
+            {
+                double x[3];
+                for ( int d = 0; d < 3; ++d )
+                    x[d] = data->coords( c, d ) +
+                           0.25 * hex_vertex_offsets[v][d];
+                field_dofs[8 * c + v] = trilinearField( x[0], x[1], x[2] );
+            }
+        return;
+    }
     for ( unsigned i = 0; i < data->field.extent( 0 ); ++i )
         field_dofs[i] = data->field( i );
 }
+// The field is constant in the volume of each node.
 template <class Space>
-void pushField( void *user_data, const char *, const double *field_dofs )
+void evaluateField( void *user_data, const char *, const size_t num_points,
+                    const Coordinate *, const LocalOrdinal *object_ids,
+                    double *values )
 {
     TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
-    for ( unsigned i = 0; i < data->field.extent( 0 ); ++i )
-        data->field( i ) = field_dofs[i];
+    for ( unsigned i = 0; i < num_points; ++i )
+        values[i] = data->field( object_ids[i] );
+}
+
+// The field named "other" is stored apart from the other fields.
+template <class Space>
+void pushField( void *user_data, const char *field_name,
+                const double *field_dofs )
+{
+    TestUserData<Space> *data = static_cast<TestUserData<Space> *>( user_data );
+    auto field = std::strcmp( field_name, "other" ) == 0 ? data->other_field
+                                                         : data->field;
+    for ( unsigned i = 0; i < field.extent( 0 ); ++i )
+        field( i ) = field_dofs[i];
 }
 
 //---------------------------------------------------------------------------//
@@ -142,8 +287,18 @@ void test( bool &success, Teuchos::FancyOStream &out )
     DTK_MapHandle bad_handle = nullptr;
     DTK_applyMap( bad_handle, "bad", "bad" );
     TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
+    const char *bad_fields[] = {"bad"};
+    DTK_applyMapMulti( bad_handle, 1, bad_fields, bad_fields );
+    TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
+    DTK_applyMapBegin( bad_handle, "bad", "bad" );
+    TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
     DTK_destroyMap( bad_handle );
     TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
+    DTK_MapGroupHandle bad_group_handle = nullptr;
+    DTK_applyMapGroup( bad_group_handle );
+    TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
+    DTK_destroyMapGroup( bad_group_handle );
+    TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
 
     // Get the communicator
     auto teuchos_comm = Teuchos::DefaultComm<int>::getComm();
@@ -190,6 +345,34 @@ void test( bool &success, Teuchos::FancyOStream &out )
                          ( void ( * )() ) & pullField<SourceSpace>,
                          src_data.get() );
     TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( src_handle, DTK_BOUNDING_VOLUME_LIST_SIZE_FUNCTION,
+                         ( void ( * )() ) & boundingVolumeListSize<SourceSpace>,
+                         src_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( src_handle, DTK_BOUNDING_VOLUME_LIST_DATA_FUNCTION,
+                         ( void ( * )() ) & boundingVolumeListData<SourceSpace>,
+                         src_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( src_handle, DTK_EVALUATE_FIELD_FUNCTION,
+                         ( void ( * )() ) & evaluateField<SourceSpace>,
+                         src_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( src_handle, DTK_CELL_LIST_SIZE_FUNCTION,
+                         ( void ( * )() ) & cellListSize<SourceSpace>,
+                         src_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( src_handle, DTK_CELL_LIST_DATA_FUNCTION,
+                         ( void ( * )() ) & cellListData<SourceSpace>,
+                         src_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( src_handle, DTK_DOF_MAP_SIZE_FUNCTION,
+                         ( void ( * )() ) & dofMapSize<SourceSpace>,
+                         src_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( src_handle, DTK_DOF_MAP_DATA_FUNCTION,
+                         ( void ( * )() ) & dofMapData<SourceSpace>,
+                         src_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
 
     // Create the target user application instance.
     auto tgt_handle =
@@ -226,6 +409,10 @@ void test( bool &success, Teuchos::FancyOStream &out )
                                                       // double quoted
               R"({ "Map Type": "MLS", "Order": "Quadratic" })",
               R"({ "Map Type": "MLS", "Order": "2" })",
+              R"({ "Map Type": "Delegated Evaluation" })",
+              R"({ "Map Type": "Evaluate" })",
+              R"({ "Map Type": "Finite Element" })",
+              R"({ "Map Type": "FE" })",
           } )
     {
         auto map_handle =
@@ -270,12 +457,30 @@ void test( bool &success, Teuchos::FancyOStream &out )
     for ( std::string const options : {
               R"({ "Map Type": "Nearest Neighbor" })",
               R"({ "Map Type": "Moving Least Squares" })",
+              R"({ "Map Type": "Delegated Evaluation" })",
           } )
     {
+        // Maps created for the same nodes and options share their operator.
+        // It outlives the map which built it and the communicator given to
+        // this map.
+        auto const num_reused = DataTransferKit::numReusedOperators().load();
+        MPI_Comm first_comm;
+        MPI_Comm_dup( comm, &first_comm );
+        auto first_map_handle =
+            DTK_createMap( SpaceSelector<MapSpace>::value(), first_comm,
+                           src_handle, tgt_handle, options.c_str() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        MPI_Comm_free( &first_comm );
+        TEST_EQUALITY( DataTransferKit::numReusedOperators().load(),
+                       num_reused );
         auto map_handle =
             DTK_createMap( SpaceSelector<MapSpace>::value(), comm, src_handle,
                            tgt_handle, options.c_str() );
         TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_EQUALITY( DataTransferKit::numReusedOperators().load(),
+                       num_reused + 1 );
+        DTK_destroyMap( first_map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
 
         DTK_applyMap( map_handle, "dummy", "dummy" );
         TEST_EQUALITY( errno, DTK_SUCCESS );
@@ -292,10 +497,375 @@ void test( bool &success, Teuchos::FancyOStream &out )
                                     relative_tolerance );
         }
 
+        // Transfer the field twice in the same apply.
+        for ( int p = 0; p < num_point; ++p )
+            tgt_data->field( p ) = 0.0;
+        const char *fields[] = {"dummy", "dummy"};
+        DTK_applyMapMulti( map_handle, 2, fields, fields );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+        {
+            TEST_FLOATING_EQUALITY( tgt_data->field( p ) + shift_from_zero,
+                                    1.0 * p + inverse_rank * num_point +
+                                        shift_from_zero,
+                                    relative_tolerance );
+        }
+
+        // Transfer the field asynchronously. The target field is only pushed
+        // when the request is completed.
+        for ( int p = 0; p < num_point; ++p )
+            tgt_data->field( p ) = 0.0;
+        auto request = DTK_applyMapBegin( map_handle, "dummy", "dummy" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_applyMapTest( request );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_EQUALITY( tgt_data->field( num_point - 1 ), 0.0 );
+        DTK_applyMapWait( request );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+        {
+            TEST_FLOATING_EQUALITY( tgt_data->field( p ) + shift_from_zero,
+                                    1.0 * p + inverse_rank * num_point +
+                                        shift_from_zero,
+                                    relative_tolerance );
+        }
+
+        // The request is destroyed once completed.
+        DTK_applyMapWait( request );
+        TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
+
+        // Requests on the same fields in progress at the same time do not
+        // share their buffers. The source field is scaled before the second
+        // request is started.
+        auto first_request = DTK_applyMapBegin( map_handle, "dummy", "dummy" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+            src_data->field( p ) *= 2.0;
+        auto second_request =
+            DTK_applyMapBegin( map_handle, "dummy", "dummy" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+            src_data->field( p ) /= 2.0;
+        DTK_applyMapWait( second_request );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+        {
+            TEST_FLOATING_EQUALITY(
+                tgt_data->field( p ) + shift_from_zero,
+                2.0 * ( 1.0 * p + inverse_rank * num_point ) + shift_from_zero,
+                relative_tolerance );
+        }
+        DTK_applyMapWait( first_request );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+        {
+            TEST_FLOATING_EQUALITY( tgt_data->field( p ) + shift_from_zero,
+                                    1.0 * p + inverse_rank * num_point +
+                                        shift_from_zero,
+                                    relative_tolerance );
+        }
+
         DTK_destroyMap( map_handle );
         TEST_EQUALITY( errno, DTK_SUCCESS );
     }
 
+    // Check the application of a group of maps. The data of both maps is
+    // exchanged in the same messages.
+    {
+        auto nn_map_handle = DTK_createMap(
+            SpaceSelector<MapSpace>::value(), comm, src_handle, tgt_handle,
+            R"({ "Map Type": "Nearest Neighbor" })" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        auto mls_map_handle = DTK_createMap(
+            SpaceSelector<MapSpace>::value(), comm, src_handle, tgt_handle,
+            R"({ "Map Type": "Moving Least Squares" })" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        auto group_handle = DTK_createMapGroup();
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_addToMapGroup( group_handle, bad_handle, "dummy", "dummy" );
+        TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
+        DTK_addToMapGroup( group_handle, nn_map_handle, "dummy", "dummy" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_addToMapGroup( group_handle, mls_map_handle, "dummy", "other" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        // Each map writes its own target field.
+        for ( int p = 0; p < num_point; ++p )
+        {
+            tgt_data->field( p ) = 0.0;
+            tgt_data->other_field( p ) = 0.0;
+        }
+        DTK_applyMapGroup( group_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+        {
+            TEST_FLOATING_EQUALITY( tgt_data->field( p ) + 3.14,
+                                    1.0 * p + inverse_rank * num_point + 3.14,
+                                    1e-14 );
+            TEST_FLOATING_EQUALITY( tgt_data->other_field( p ) + 3.14,
+                                    1.0 * p + inverse_rank * num_point + 3.14,
+                                    1e-14 );
+        }
+
+        // Apply the group asynchronously.
+        for ( int p = 0; p < num_point; ++p )
+        {
+            tgt_data->field( p ) = 0.0;
+            tgt_data->other_field( p ) = 0.0;
+        }
+        auto request = DTK_applyMapGroupBegin( group_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_EQUALITY( tgt_data->field( num_point - 1 ), 0.0 );
+        TEST_EQUALITY( tgt_data->other_field( num_point - 1 ), 0.0 );
+        DTK_applyMapWait( request );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+        {
+            TEST_FLOATING_EQUALITY( tgt_data->field( p ) + 3.14,
+                                    1.0 * p + inverse_rank * num_point + 3.14,
+                                    1e-14 );
+            TEST_FLOATING_EQUALITY( tgt_data->other_field( p ) + 3.14,
+                                    1.0 * p + inverse_rank * num_point + 3.14,
+                                    1e-14 );
+        }
+
+        // A map built over another group of processes cannot join the group.
+        if ( teuchos_comm->getSize() > 1 )
+        {
+            auto self_map_handle = DTK_createMap(
+                SpaceSelector<MapSpace>::value(), MPI_COMM_SELF, src_handle,
+                tgt_handle, R"({ "Map Type": "Nearest Neighbor" })" );
+            TEST_EQUALITY( errno, DTK_SUCCESS );
+            DTK_addToMapGroup( group_handle, self_map_handle, "dummy",
+                               "dummy" );
+            TEST_EQUALITY( errno, DTK_UNKNOWN );
+            DTK_destroyMap( self_map_handle );
+            TEST_EQUALITY( errno, DTK_SUCCESS );
+        }
+
+        // The group cannot be applied once one of its maps is destroyed.
+        DTK_destroyMap( mls_map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_applyMapGroup( group_handle );
+        TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
+
+        DTK_destroyMapGroup( group_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_destroyMap( nn_map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+    }
+
+    // Check the finite element map. The target points are away from the
+    // centers of the source cells so that the value at each point depends on
+    // all the vertices of its cell.
+    {
+        auto fe_tgt_data =
+            std::make_shared<TestUserData<TargetSpace>>( num_point );
+        double const target_offsets[3] = {0.1, -0.15, 0.2};
+        for ( int p = 0; p < num_point; ++p )
+            for ( int d = 0; d < 3; ++d )
+                fe_tgt_data->coords( p, d ) =
+                    1.0 * p + inverse_rank * num_point + target_offsets[d];
+        auto fe_tgt_handle =
+            DTK_createUserApplication( SpaceSelector<TargetSpace>::value() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( fe_tgt_handle, DTK_NODE_LIST_SIZE_FUNCTION,
+                             ( void ( * )() ) & nodeListSize<TargetSpace>,
+                             fe_tgt_data.get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( fe_tgt_handle, DTK_NODE_LIST_DATA_FUNCTION,
+                             ( void ( * )() ) & nodeListData<TargetSpace>,
+                             fe_tgt_data.get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( fe_tgt_handle, DTK_FIELD_SIZE_FUNCTION,
+                             ( void ( * )() ) & fieldSize<TargetSpace>,
+                             fe_tgt_data.get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( fe_tgt_handle, DTK_PUSH_FIELD_DATA_FUNCTION,
+                             ( void ( * )() ) & pushField<TargetSpace>,
+                             fe_tgt_data.get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        auto check_fe_field = [&]() {
+            for ( int p = 0; p < num_point; ++p )
+                TEST_FLOATING_EQUALITY(
+                    fe_tgt_data->field( p ),
+                    trilinearField( fe_tgt_data->coords( p, 0 ),
+                                    fe_tgt_data->coords( p, 1 ),
+                                    fe_tgt_data->coords( p, 2 ) ),
+                    1e-12 );
+            for ( int p = 0; p < num_point; ++p )
+                fe_tgt_data->field( p ) = 0.0;
+        };
+
+        // The operator is shared with a second map. It keeps working once the
+        // map which built it and the communicator given to that map are
+        // gone.
+        auto const num_reused = DataTransferKit::numReusedOperators().load();
+        MPI_Comm first_comm;
+        MPI_Comm_dup( comm, &first_comm );
+        auto first_fe_map_handle = DTK_createMap(
+            SpaceSelector<MapSpace>::value(), first_comm, src_handle,
+            fe_tgt_handle, R"({ "Map Type": "Finite Element" })" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        MPI_Comm_free( &first_comm );
+        auto fe_map_handle = DTK_createMap(
+            SpaceSelector<MapSpace>::value(), comm, src_handle, fe_tgt_handle,
+            R"({ "Map Type": "Finite Element" })" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_EQUALITY( DataTransferKit::numReusedOperators().load(),
+                       num_reused + 1 );
+        DTK_destroyMap( first_fe_map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        DTK_applyMap( fe_map_handle, "vertex", "dummy" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        check_fe_field();
+
+        // The finite element map does not communicate when it is applied so
+        // its request does not need any message.
+        auto request = DTK_applyMapBegin( fe_map_handle, "vertex", "dummy" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_ASSERT( DTK_applyMapTest( request ) );
+        DTK_applyMapWait( request );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        check_fe_field();
+
+        // Apply the finite element map alone and together with a map which
+        // fetches values from the other processes.
+        auto fe_group_handle = DTK_createMapGroup();
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_addToMapGroup( fe_group_handle, fe_map_handle, "vertex", "dummy" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_applyMapGroup( fe_group_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        check_fe_field();
+
+        auto nn_map_handle = DTK_createMap(
+            SpaceSelector<MapSpace>::value(), comm, src_handle, tgt_handle,
+            R"({ "Map Type": "Nearest Neighbor" })" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_addToMapGroup( fe_group_handle, nn_map_handle, "dummy", "other" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+            tgt_data->other_field( p ) = 0.0;
+        DTK_applyMapGroup( fe_group_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        check_fe_field();
+        for ( int p = 0; p < num_point; ++p )
+            TEST_FLOATING_EQUALITY( tgt_data->other_field( p ) + 3.14,
+                                    1.0 * p + inverse_rank * num_point + 3.14,
+                                    1e-14 );
+
+        DTK_destroyMapGroup( fe_group_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_destroyMap( nn_map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_destroyMap( fe_map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_destroyUserApplication( fe_tgt_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+    }
+
+    // Check map apply between disjoint groups of processes. The lower half of
+    // the ranks only has the source and the upper half only has the target.
+    // The target points of the j-th rank of the target group are the source
+    // points of the rank j modulo the size of the source group.
+    int comm_size = teuchos_comm->getSize();
+    if ( comm_size > 1 )
+    {
+        int const source_size = comm_size / 2;
+        bool const is_source = comm_rank < source_size;
+        MPI_Comm group_comm;
+        MPI_Comm_split( comm, is_source, comm_rank, &group_comm );
+        MPI_Comm intercomm;
+        MPI_Intercomm_create( group_comm, 0, comm,
+                              is_source ? source_size : 0, 0, &intercomm );
+
+        int const source_rank = ( comm_rank - source_size ) % source_size;
+        for ( int p = 0; p < num_point; ++p )
+            for ( int d = 0; d < 3; ++d )
+                tgt_data->coords( p, d ) = 1.0 * p + source_rank * num_point;
+
+        for ( std::string const options : {
+                  R"({ "Map Type": "Nearest Neighbor" })",
+                  R"({ "Map Type": "Moving Least Squares" })",
+              } )
+        {
+            for ( int p = 0; p < num_point; ++p )
+                tgt_data->field( p ) = 0.0;
+
+            auto map_handle = DTK_createMap(
+                SpaceSelector<MapSpace>::value(), intercomm,
+                is_source ? src_handle : nullptr,
+                is_source ? nullptr : tgt_handle, options.c_str() );
+            TEST_EQUALITY( errno, DTK_SUCCESS );
+
+            DTK_applyMap( map_handle, "dummy", "dummy" );
+            TEST_EQUALITY( errno, DTK_SUCCESS );
+            if ( !is_source )
+                for ( int p = 0; p < num_point; ++p )
+                    TEST_FLOATING_EQUALITY(
+                        tgt_data->field( p ) + 3.14,
+                        1.0 * p + source_rank * num_point + 3.14, 1e-14 );
+
+            DTK_destroyMap( map_handle );
+            TEST_EQUALITY( errno, DTK_SUCCESS );
+        }
+
+        MPI_Comm_free( &intercomm );
+        MPI_Comm_free( &group_comm );
+    }
+
+    // Check that the maps built from applications providing the version of
+    // their geometry share the lists extracted from the applications.
+    {
+        DTK_setUserFunction( src_handle, DTK_GEOMETRY_VERSION_FUNCTION,
+                             ( void ( * )() ) & geometryVersion<SourceSpace>,
+                             src_data.get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( tgt_handle, DTK_GEOMETRY_VERSION_FUNCTION,
+                             ( void ( * )() ) & geometryVersion<TargetSpace>,
+                             tgt_data.get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        src_data->num_node_list_calls = 0;
+        tgt_data->num_node_list_calls = 0;
+        auto const num_reused = DataTransferKit::numReusedOperators().load();
+
+        auto first_map_handle = DTK_createMap(
+            SpaceSelector<MapSpace>::value(), comm, src_handle, tgt_handle,
+            R"({ "Map Type": "Nearest Neighbor" })" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        auto map_handle = DTK_createMap(
+            SpaceSelector<MapSpace>::value(), comm, src_handle, tgt_handle,
+            R"({ "Map Type": "Nearest Neighbor" })" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_EQUALITY( src_data->num_node_list_calls, 1 );
+        TEST_EQUALITY( tgt_data->num_node_list_calls, 1 );
+        TEST_EQUALITY( DataTransferKit::numReusedOperators().load(),
+                       num_reused + 1 );
+
+        // The lists are extracted again once the geometry changes. The nodes
+        // did not move so the operator is still found by their hash.
+        ++src_data->geometry_version;
+        auto new_map_handle = DTK_createMap(
+            SpaceSelector<MapSpace>::value(), comm, src_handle, tgt_handle,
+            R"({ "Map Type": "Nearest Neighbor" })" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_EQUALITY( src_data->num_node_list_calls, 2 );
+        TEST_EQUALITY( tgt_data->num_node_list_calls, 1 );
+        TEST_EQUALITY( DataTransferKit::numReusedOperators().load(),
+                       num_reused + 2 );
+
+        DTK_destroyMap( new_map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_destroyMap( map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_destroyMap( first_map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+    }
+
     DTK_destroyUserApplication( src_handle );
     TEST_EQUALITY( errno, DTK_SUCCESS );
     DTK_destroyUserApplication( tgt_handle );
@@ -0,0 +1,93 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_DELEGATED_EVALUATION_OPERATOR_DECL_HPP
+#define DTK_DELEGATED_EVALUATION_OPERATOR_DECL_HPP
+
+#include <DTK_DetailsFetchPlan.hpp>
+#include <DTK_PointCloudOperator.hpp>
+#include <DTK_Types.h>
+
+#include <mpi.h>
+
+namespace DataTransferKit
+{
+
+/**
+ * This class delegates the evaluation of the fields to the processes owning
+ * the source objects. DTK only routes each target point to the owner of the
+ * source object whose bounding box contains the point, or is the closest to
+ * it. The owners evaluate the fields at the points they receive, typically
+ * with their own locate-and-evaluate, and the values are sent back.
+ *
+ * The source values passed to apply() are the values of the fields at the
+ * points returned by evaluationPoints() on the calling process, in the
+ * objects returned by objectIds().
+ */
+template <typename DeviceType>
+class DelegatedEvaluationOperator : public PointCloudOperator<DeviceType>
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    /**
+     * Constructor. The i-th source object is bounded by the box with lower
+     * corner source_bounding_volumes(i, :, 0) and upper corner
+     * source_bounding_volumes(i, :, 1).
+     */
+    DelegatedEvaluationOperator(
+        MPI_Comm comm,
+        Kokkos::View<Coordinate const * * [2], DeviceType>
+            source_bounding_volumes,
+        Kokkos::View<Coordinate const **, DeviceType> target_points );
+
+    /**
+     * Points at which the fields are evaluated by the calling process.
+     */
+    Kokkos::View<Coordinate const **, DeviceType> evaluationPoints() const
+    {
+        return _evaluation_points;
+    }
+
+    /**
+     * Local ids of the source objects in which the evaluation points are
+     * located or to which they are the closest.
+     */
+    Kokkos::View<LocalOrdinal const *, DeviceType> objectIds() const
+    {
+        return _object_ids;
+    }
+
+    void
+    apply( Kokkos::View<double const *, DeviceType> source_values,
+           Kokkos::View<double *, DeviceType> target_values ) const override;
+
+    void
+    apply( Kokkos::View<double const **, DeviceType> source_values,
+           Kokkos::View<double **, DeviceType> target_values ) const override;
+
+    std::unique_ptr<PointCloudOperatorRequest> applyBegin(
+        Kokkos::View<double const **, DeviceType> source_values,
+        Kokkos::View<double **, DeviceType> target_values ) const override;
+
+    Details::FetchApplyStep<DeviceType> prepareApply(
+        Kokkos::View<double const **, DeviceType> source_values,
+        Kokkos::View<double **, DeviceType> target_values ) const override;
+
+  private:
+    Details::FetchPlan<DeviceType> _fetch_plan;
+    Kokkos::View<Coordinate **, DeviceType> _evaluation_points;
+    Kokkos::View<LocalOrdinal *, DeviceType> _object_ids;
+};
+
+} // namespace DataTransferKit
+
+#endif
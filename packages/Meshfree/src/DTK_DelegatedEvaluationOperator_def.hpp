@@ -0,0 +1,174 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_DELEGATED_EVALUATION_OPERATOR_DEF_HPP
+#define DTK_DELEGATED_EVALUATION_OPERATOR_DEF_HPP
+
+#include <ArborX.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_DetailsNearestNeighborOperatorImpl.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace DataTransferKit
+{
+
+template <typename DeviceType>
+DelegatedEvaluationOperator<DeviceType>::DelegatedEvaluationOperator(
+    MPI_Comm comm,
+    Kokkos::View<Coordinate const * * [2], DeviceType> source_bounding_volumes,
+    Kokkos::View<Coordinate const **, DeviceType> target_points )
+{
+    DTK_REQUIRE( source_bounding_volumes.extent_int( 1 ) == 3 );
+    DTK_REQUIRE( target_points.extent_int( 1 ) == 3 );
+
+    // Build the search tree over the bounding boxes of the source objects.
+    int const n_objects = source_bounding_volumes.extent( 0 );
+    Kokkos::View<ArborX::Box *, DeviceType> boxes( "boxes", n_objects );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "setup_bounding_boxes" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_objects ),
+        KOKKOS_LAMBDA( int const i ) {
+            for ( int d = 0; d < 3; ++d )
+            {
+                boxes( i ).minCorner()[d] = source_bounding_volumes( i, d, 0 );
+                boxes( i ).maxCorner()[d] = source_bounding_volumes( i, d, 1 );
+            }
+        } );
+    Kokkos::fence();
+    ArborX::DistributedSearchTree<DeviceType> search_tree( comm, boxes );
+    DTK_CHECK( !search_tree.empty() );
+
+    // The closest box of a point is a box containing it if there is one.
+    auto nearest_queries = Details::NearestNeighborOperatorImpl<
+        DeviceType>::makeNearestNeighborQueries( target_points );
+    Kokkos::View<int *, DeviceType> indices( "indices", 0 );
+    Kokkos::View<int *, DeviceType> offset( "offset", 0 );
+    Kokkos::View<int *, DeviceType> ranks( "ranks", 0 );
+    search_tree.query( nearest_queries, indices, offset, ranks );
+    int const n_target_points = target_points.extent( 0 );
+    DTK_ENSURE( ArborX::lastElement( offset ) == n_target_points );
+
+    // Number the points routed to each process in the order in which the
+    // plan delivers them: by increasing rank of the sender and in the order
+    // of the sender. Each process then evaluates the points in that order.
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    auto ranks_host = Kokkos::create_mirror_view( ranks );
+    Kokkos::deep_copy( ranks_host, ranks );
+    std::vector<int> counts( comm_size, 0 );
+    for ( int i = 0; i < n_target_points; ++i )
+        ++counts[ranks_host( i )];
+    std::vector<int> first( comm_size, 0 );
+    MPI_Exscan( counts.data(), first.data(), comm_size, MPI_INT, MPI_SUM,
+                comm );
+    if ( comm_rank == 0 )
+        std::fill( first.begin(), first.end(), 0 );
+    Kokkos::View<int *, DeviceType> positions( "positions", n_target_points );
+    auto positions_host = Kokkos::create_mirror_view( positions );
+    for ( int i = 0; i < n_target_points; ++i )
+        positions_host( i ) = first[ranks_host( i )]++;
+    Kokkos::deep_copy( positions, positions_host );
+    _fetch_plan = Details::FetchPlan<DeviceType>( comm, ranks, positions );
+
+    // Send the target points and the ids of the objects found to their
+    // owners. The ids are exactly represented as doubles.
+    Kokkos::View<double **, DeviceType> routed( "routed", n_target_points, 4 );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "pack_routed_points" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
+        KOKKOS_LAMBDA( int const i ) {
+            for ( int d = 0; d < 3; ++d )
+                routed( i, d ) = target_points( i, d );
+            routed( i, 3 ) = indices( i );
+        } );
+    Kokkos::fence();
+    auto received = _fetch_plan.push( routed );
+
+    int const n_evaluation_points = received.extent( 0 );
+    _evaluation_points = Kokkos::View<Coordinate **, DeviceType>(
+        "evaluation_points", n_evaluation_points, 3 );
+    _object_ids = Kokkos::View<LocalOrdinal *, DeviceType>(
+        "object_ids", n_evaluation_points );
+    auto const evaluation_points = _evaluation_points;
+    auto const object_ids = _object_ids;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "unpack_routed_points" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_evaluation_points ),
+        KOKKOS_LAMBDA( int const k ) {
+            for ( int d = 0; d < 3; ++d )
+                evaluation_points( k, d ) = received( k, d );
+            object_ids( k ) = static_cast<LocalOrdinal>( received( k, 3 ) );
+        } );
+    Kokkos::fence();
+}
+
+template <typename DeviceType>
+void DelegatedEvaluationOperator<DeviceType>::apply(
+    Kokkos::View<double const *, DeviceType> source_values,
+    Kokkos::View<double *, DeviceType> target_values ) const
+{
+    // Transfer the values as a single column.
+    Kokkos::View<double const **, DeviceType> source_column(
+        source_values.data(), source_values.extent( 0 ), 1 );
+    Kokkos::View<double **, DeviceType> target_column(
+        target_values.data(), target_values.extent( 0 ), 1 );
+    apply( source_column, target_column );
+}
+
+template <typename DeviceType>
+void DelegatedEvaluationOperator<DeviceType>::apply(
+    Kokkos::View<double const **, DeviceType> source_values,
+    Kokkos::View<double **, DeviceType> target_values ) const
+{
+    applyBegin( source_values, target_values )->wait();
+}
+
+template <typename DeviceType>
+std::unique_ptr<PointCloudOperatorRequest>
+DelegatedEvaluationOperator<DeviceType>::applyBegin(
+    Kokkos::View<double const **, DeviceType> source_values,
+    Kokkos::View<double **, DeviceType> target_values ) const
+{
+    return std::unique_ptr<PointCloudOperatorRequest>(
+        new Details::FetchApplyRequest<DeviceType>(
+            {prepareApply( source_values, target_values )} ) );
+}
+
+template <typename DeviceType>
+Details::FetchApplyStep<DeviceType>
+DelegatedEvaluationOperator<DeviceType>::prepareApply(
+    Kokkos::View<double const **, DeviceType> source_values,
+    Kokkos::View<double **, DeviceType> target_values ) const
+{
+    // Precondition: check that the source and target are properly sized
+    DTK_REQUIRE( _fetch_plan.size() == target_values.extent_int( 0 ) );
+    DTK_REQUIRE( source_values.extent( 0 ) ==
+                 _evaluation_points.extent( 0 ) );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+    // The values evaluated by the owners are the target values.
+    return {&_fetch_plan, source_values,
+            [target_values]( Kokkos::View<double **, DeviceType> values ) {
+                Kokkos::deep_copy( target_values, values );
+            }};
+}
+
+} // namespace DataTransferKit
+
+// Explicit instantiation macro
+#define DTK_DELEGATEDEVALUATIONOPERATOR_INSTANT( NODE )                        \
+    template class DelegatedEvaluationOperator<typename NODE::device_type>;
+
+#endif
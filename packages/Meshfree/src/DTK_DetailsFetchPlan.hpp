@@ -0,0 +1,583 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_DETAILS_FETCH_PLAN_HPP
+#define DTK_DETAILS_FETCH_PLAN_HPP
+
+#include <DTK_ConfigDefs.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_PointCloudOperator.hpp> // PointCloudOperatorRequest
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace DataTransferKit
+{
+namespace Details
+{
+
+template <typename DeviceType>
+class FetchPlan;
+
+/**
+ * Application of an operator whose last step is a fetch. The values in the
+ * columns of source_values are fetched with the plan and handed to finalize
+ * which computes the target values. The plan must outlive the application.
+ * Operators which do not need to fetch anything leave the plan null and
+ * finalize gets an empty view.
+ */
+template <typename DeviceType>
+struct FetchApplyStep
+{
+    using Finalize = std::function<void( Kokkos::View<double **, DeviceType> )>;
+
+    FetchPlan<DeviceType> const *plan;
+    Kokkos::View<double const **, DeviceType> source_values;
+    Finalize finalize;
+};
+
+/**
+ * Communication plan to fetch the values of the source points found by a
+ * search. The i-th value fetched is the value of the point indices(i) on the
+ * process ranks(i).
+ *
+ * The indices requested are sent to the owners of the points once when the
+ * plan is built. Fetching values then takes a single message per pair of
+ * processes, sent with non-blocking communication by FetchApplyRequest.
+ */
+template <typename DeviceType>
+class FetchPlan
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    using HostBuffer = typename Kokkos::View<double **, Kokkos::LayoutRight,
+                                             DeviceType>::HostMirror;
+
+    FetchPlan() = default;
+
+    /**
+     * Build the plan. This is a collective operation over \p comm.
+     */
+    FetchPlan( MPI_Comm comm, Kokkos::View<int const *, DeviceType> ranks,
+               Kokkos::View<int const *, DeviceType> indices );
+
+    /**
+     * Number of values fetched.
+     */
+    int size() const { return _import_permutation.extent_int( 0 ); }
+
+    /**
+     * Communicator of the plan. It is a duplicate of the communicator the
+     * plan was built over so that the messages in flight cannot match
+     * messages sent by the application.
+     */
+    MPI_Comm comm() const { return *_comm; }
+
+    /**
+     * Processes the values are sent to. The rows exportOffsets()[r] to
+     * exportOffsets()[r+1]-1 of the buffer returned by pack() are sent to
+     * exportRanks()[r].
+     */
+    std::vector<int> const &exportRanks() const { return _export_ranks; }
+    std::vector<int> const &exportOffsets() const { return _export_offsets; }
+
+    /**
+     * Processes the values are received from. The rows importOffsets()[r] to
+     * importOffsets()[r+1]-1 of the buffer passed to unpack() are received
+     * from importRanks()[r].
+     */
+    std::vector<int> const &importRanks() const { return _import_ranks; }
+    std::vector<int> const &importOffsets() const { return _import_offsets; }
+
+    /**
+     * Copy the values of the columns of \p source_values requested by the
+     * other processes in a host buffer.
+     */
+    HostBuffer
+    pack( Kokkos::View<double const **, DeviceType> source_values ) const;
+
+    /**
+     * Put the values received in the order in which they were requested.
+     */
+    Kokkos::View<double **, DeviceType> unpack( HostBuffer recv_buffer ) const;
+
+    /**
+     * Fetch the values in the columns of \p source_values. This is a blocking
+     * collective operation.
+     */
+    Kokkos::View<double **, DeviceType>
+    fetch( Kokkos::View<double const **, DeviceType> source_values ) const;
+
+    /**
+     * Send the rows of \p values the other way: row i is sent to the process
+     * the i-th value is fetched from. The rows received are returned in the
+     * order in which the indices were requested from this process, sorted by
+     * rank of the requesting process. This is a blocking collective
+     * operation.
+     */
+    Kokkos::View<double **, DeviceType>
+    push( Kokkos::View<double const **, DeviceType> values ) const;
+
+  private:
+    std::shared_ptr<MPI_Comm> _comm;
+    // Values sent to _export_ranks[r] are the values of the local points
+    // _export_indices(_export_offsets[r]) to
+    // _export_indices(_export_offsets[r+1]-1)
+    std::vector<int> _export_ranks;
+    std::vector<int> _export_offsets;
+    Kokkos::View<int *, DeviceType> _export_indices;
+    // Values received from _import_ranks[r] are stored in the rows
+    // _import_offsets[r] to _import_offsets[r+1]-1 of the receive buffer and
+    // row k is the _import_permutation(k)-th value fetched
+    std::vector<int> _import_ranks;
+    std::vector<int> _import_offsets;
+    Kokkos::View<int *, DeviceType> _import_permutation;
+};
+
+template <typename DeviceType>
+FetchPlan<DeviceType>::FetchPlan(
+    MPI_Comm comm, Kokkos::View<int const *, DeviceType> ranks,
+    Kokkos::View<int const *, DeviceType> indices )
+    : _comm( new MPI_Comm( MPI_COMM_NULL ), []( MPI_Comm *c ) {
+        int finalized;
+        MPI_Finalized( &finalized );
+        if ( !finalized && *c != MPI_COMM_NULL )
+            MPI_Comm_free( c );
+        delete c;
+    } )
+{
+    DTK_REQUIRE( ranks.extent( 0 ) == indices.extent( 0 ) );
+
+    MPI_Comm_dup( comm, _comm.get() );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    auto ranks_host = Kokkos::create_mirror_view( ranks );
+    Kokkos::deep_copy( ranks_host, ranks );
+    auto indices_host = Kokkos::create_mirror_view( indices );
+    Kokkos::deep_copy( indices_host, indices );
+
+    // Sort the requests by rank.
+    int const n_imports = ranks.extent( 0 );
+    std::vector<int> import_counts( comm_size, 0 );
+    for ( int i = 0; i < n_imports; ++i )
+        ++import_counts[ranks_host( i )];
+    std::vector<int> import_displs( comm_size + 1, 0 );
+    for ( int r = 0; r < comm_size; ++r )
+        import_displs[r + 1] = import_displs[r] + import_counts[r];
+    _import_permutation =
+        Kokkos::View<int *, DeviceType>( "import_permutation", n_imports );
+    auto import_permutation_host =
+        Kokkos::create_mirror_view( _import_permutation );
+    std::vector<int> requested_indices( n_imports );
+    std::vector<int> position( import_displs.begin(), import_displs.end() - 1 );
+    for ( int i = 0; i < n_imports; ++i )
+    {
+        int const k = position[ranks_host( i )]++;
+        import_permutation_host( k ) = i;
+        requested_indices[k] = indices_host( i );
+    }
+
+    // Send the indices requested to the owners of the points.
+    std::vector<int> export_counts( comm_size );
+    MPI_Alltoall( import_counts.data(), 1, MPI_INT, export_counts.data(), 1,
+                  MPI_INT, comm );
+    std::vector<int> export_displs( comm_size + 1, 0 );
+    for ( int r = 0; r < comm_size; ++r )
+        export_displs[r + 1] = export_displs[r] + export_counts[r];
+    int const n_exports = export_displs.back();
+    _export_indices =
+        Kokkos::View<int *, DeviceType>( "export_indices", n_exports );
+    auto export_indices_host = Kokkos::create_mirror_view( _export_indices );
+    MPI_Alltoallv( requested_indices.data(), import_counts.data(),
+                   import_displs.data(), MPI_INT, export_indices_host.data(),
+                   export_counts.data(), export_displs.data(), MPI_INT,
+                   comm );
+
+    // Only keep the processes we communicate with.
+    _export_offsets.push_back( 0 );
+    _import_offsets.push_back( 0 );
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        if ( export_counts[r] > 0 )
+        {
+            _export_ranks.push_back( r );
+            _export_offsets.push_back( export_displs[r + 1] );
+        }
+        if ( import_counts[r] > 0 )
+        {
+            _import_ranks.push_back( r );
+            _import_offsets.push_back( import_displs[r + 1] );
+        }
+    }
+
+    Kokkos::deep_copy( _export_indices, export_indices_host );
+    Kokkos::deep_copy( _import_permutation, import_permutation_host );
+}
+
+template <typename DeviceType>
+typename FetchPlan<DeviceType>::HostBuffer FetchPlan<DeviceType>::pack(
+    Kokkos::View<double const **, DeviceType> source_values ) const
+{
+    int const n_columns = source_values.extent( 1 );
+    int const n_exports = _export_indices.extent( 0 );
+
+    // Pack the values requested by each process.
+    Kokkos::View<double **, Kokkos::LayoutRight, DeviceType> send_buffer(
+        "send_buffer", n_exports, n_columns );
+    auto const export_indices = _export_indices;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "pack_source_values" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_exports ),
+        KOKKOS_LAMBDA( int const k ) {
+            for ( int j = 0; j < n_columns; ++j )
+                send_buffer( k, j ) = source_values( export_indices( k ), j );
+        } );
+    Kokkos::fence();
+    auto send_buffer_host = Kokkos::create_mirror_view( send_buffer );
+    Kokkos::deep_copy( send_buffer_host, send_buffer );
+
+    return send_buffer_host;
+}
+
+template <typename DeviceType>
+Kokkos::View<double **, DeviceType>
+FetchPlan<DeviceType>::unpack( HostBuffer recv_buffer_host ) const
+{
+    DTK_REQUIRE( recv_buffer_host.extent_int( 0 ) == size() );
+
+    // Put the values back in the order in which they were requested.
+    auto recv_buffer = Kokkos::create_mirror_view(
+        typename DeviceType::memory_space(), recv_buffer_host );
+    Kokkos::deep_copy( recv_buffer, recv_buffer_host );
+    int const n_imports = recv_buffer.extent( 0 );
+    int const n_columns = recv_buffer.extent( 1 );
+    Kokkos::View<double **, DeviceType> values( "fetched_values", n_imports,
+                                                n_columns );
+    auto const import_permutation = _import_permutation;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "unpack_source_values" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+        KOKKOS_LAMBDA( int const k ) {
+            for ( int j = 0; j < n_columns; ++j )
+                values( import_permutation( k ), j ) = recv_buffer( k, j );
+        } );
+    Kokkos::fence();
+
+    return values;
+}
+
+template <typename DeviceType>
+Kokkos::View<double **, DeviceType> FetchPlan<DeviceType>::push(
+    Kokkos::View<double const **, DeviceType> values ) const
+{
+    DTK_REQUIRE( values.extent_int( 0 ) == size() );
+
+    // Sort the rows by the process they are sent to.
+    int const n_columns = values.extent( 1 );
+    int const n_imports = size();
+    int const n_exports = _export_indices.extent( 0 );
+    Kokkos::View<double **, Kokkos::LayoutRight, DeviceType> send_buffer(
+        "send_buffer", n_imports, n_columns );
+    auto const import_permutation = _import_permutation;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "pack_pushed_values" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+        KOKKOS_LAMBDA( int const k ) {
+            for ( int j = 0; j < n_columns; ++j )
+                send_buffer( k, j ) = values( import_permutation( k ), j );
+        } );
+    Kokkos::fence();
+    auto send_buffer_host = Kokkos::create_mirror_view( send_buffer );
+    Kokkos::deep_copy( send_buffer_host, send_buffer );
+    HostBuffer recv_buffer_host( "recv_buffer", n_exports, n_columns );
+
+    // The messages go the opposite way of the fetches.
+    int const tag = 0;
+    int const n_recvs = _export_ranks.size();
+    int const n_sends = _import_ranks.size();
+    std::vector<MPI_Request> requests( n_recvs + n_sends );
+    for ( int r = 0; r < n_recvs; ++r )
+        MPI_Irecv( recv_buffer_host.data() + _export_offsets[r] * n_columns,
+                   ( _export_offsets[r + 1] - _export_offsets[r] ) * n_columns,
+                   MPI_DOUBLE, _export_ranks[r], tag, *_comm, &requests[r] );
+    for ( int r = 0; r < n_sends; ++r )
+        MPI_Isend( send_buffer_host.data() + _import_offsets[r] * n_columns,
+                   ( _import_offsets[r + 1] - _import_offsets[r] ) * n_columns,
+                   MPI_DOUBLE, _import_ranks[r], tag, *_comm,
+                   &requests[n_recvs + r] );
+    MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE );
+
+    Kokkos::View<double **, Kokkos::LayoutRight, DeviceType> recv_buffer(
+        "recv_buffer", n_exports, n_columns );
+    Kokkos::deep_copy( recv_buffer, recv_buffer_host );
+    Kokkos::View<double **, DeviceType> pushed_values( "pushed_values",
+                                                       n_exports, n_columns );
+    Kokkos::deep_copy( pushed_values, recv_buffer );
+
+    return pushed_values;
+}
+
+/**
+ * Layout of the messages exchanged with the other processes when the values
+ * of several fetches are sent together. The message exchanged with ranks[m]
+ * is stored in the elements offsets[m] to offsets[m+1]-1 of the combined
+ * buffer and the block of the k-th process of the i-th fetch starts at
+ * positions[i][k].
+ */
+struct MessageLayout
+{
+    std::vector<int> ranks;
+    std::vector<int> offsets;
+    std::vector<std::vector<int>> positions;
+};
+
+/**
+ * Combine the messages of several fetches. The i-th fetch exchanges
+ * block_offsets[i][k+1]-block_offsets[i][k] rows of n_columns[i] values with
+ * the process block_ranks[i][k].
+ */
+inline MessageLayout
+combineMessages( std::vector<std::vector<int> const *> const &block_ranks,
+                 std::vector<std::vector<int> const *> const &block_offsets,
+                 std::vector<int> const &n_columns )
+{
+    int const n_fetches = n_columns.size();
+    auto block_size = [&]( int const i, int const k ) {
+        return ( ( *block_offsets[i] )[k + 1] - ( *block_offsets[i] )[k] ) *
+               n_columns[i];
+    };
+
+    // Compute the size of the message exchanged with each process.
+    std::map<int, int> message_size;
+    for ( int i = 0; i < n_fetches; ++i )
+        for ( unsigned int k = 0; k < block_ranks[i]->size(); ++k )
+            message_size[( *block_ranks[i] )[k]] += block_size( i, k );
+
+    MessageLayout layout;
+    std::map<int, int> position;
+    layout.offsets.push_back( 0 );
+    for ( auto const &message : message_size )
+    {
+        layout.ranks.push_back( message.first );
+        position[message.first] = layout.offsets.back();
+        layout.offsets.push_back( layout.offsets.back() + message.second );
+    }
+
+    // The blocks of the fetches follow each other in the messages.
+    layout.positions.resize( n_fetches );
+    for ( int i = 0; i < n_fetches; ++i )
+        for ( unsigned int k = 0; k < block_ranks[i]->size(); ++k )
+        {
+            int &p = position[( *block_ranks[i] )[k]];
+            layout.positions[i].push_back( p );
+            p += block_size( i, k );
+        }
+
+    return layout;
+}
+
+/**
+ * Applications of operators whose last step is a fetch. The values of all
+ * the applications are exchanged together so that each pair of processes
+ * exchanges a single message, and handed to the functions computing the
+ * target values once the communication has completed. The plans must have
+ * been built over the same group of processes.
+ */
+template <typename DeviceType>
+class FetchApplyRequest : public PointCloudOperatorRequest
+{
+    using HostBuffer = typename FetchPlan<DeviceType>::HostBuffer;
+
+  public:
+    explicit FetchApplyRequest(
+        std::vector<FetchApplyStep<DeviceType>> const &steps );
+
+    ~FetchApplyRequest() override
+    {
+        // Complete the communication before releasing the buffers.
+        if ( !_done )
+            MPI_Waitall( _requests.size(), _requests.data(),
+                         MPI_STATUSES_IGNORE );
+    }
+
+    bool test() override
+    {
+        if ( _done )
+            return true;
+        int flag;
+        MPI_Testall( _requests.size(), _requests.data(), &flag,
+                     MPI_STATUSES_IGNORE );
+        return flag;
+    }
+
+    void wait() override;
+
+  private:
+    std::vector<FetchApplyStep<DeviceType>> _steps;
+    std::vector<HostBuffer> _recv_buffers;
+    MessageLayout _import_layout;
+    std::vector<double> _send_message;
+    std::vector<double> _recv_message;
+    std::vector<MPI_Request> _requests;
+    bool _done;
+};
+
+template <typename DeviceType>
+FetchApplyRequest<DeviceType>::FetchApplyRequest(
+    std::vector<FetchApplyStep<DeviceType>> const &steps )
+    : _steps( steps )
+    , _done( false )
+{
+    DTK_REQUIRE( !_steps.empty() );
+    int const n_steps = _steps.size();
+
+    // The messages of all the steps are exchanged over the communicator of
+    // the first plan. Nothing is exchanged if all the plans are null.
+    MPI_Comm comm = MPI_COMM_NULL;
+    for ( auto const &step : _steps )
+        if ( step.plan != nullptr )
+        {
+            comm = step.plan->comm();
+            break;
+        }
+
+    // Pack the values requested by the other processes.
+    std::vector<HostBuffer> send_buffers( n_steps );
+    _recv_buffers.resize( n_steps );
+    std::vector<int> const no_blocks;
+    std::vector<int> const no_offsets( 1, 0 );
+    std::vector<std::vector<int> const *> export_ranks( n_steps, &no_blocks );
+    std::vector<std::vector<int> const *> export_offsets( n_steps,
+                                                          &no_offsets );
+    std::vector<std::vector<int> const *> import_ranks( n_steps, &no_blocks );
+    std::vector<std::vector<int> const *> import_offsets( n_steps,
+                                                          &no_offsets );
+    std::vector<int> n_columns( n_steps );
+    for ( int s = 0; s < n_steps; ++s )
+    {
+        n_columns[s] = _steps[s].source_values.extent( 1 );
+        if ( _steps[s].plan == nullptr )
+            continue;
+
+        auto const &plan = *_steps[s].plan;
+        int result;
+        MPI_Comm_compare( comm, plan.comm(), &result );
+        DTK_INSIST( result == MPI_IDENT || result == MPI_CONGRUENT );
+
+        send_buffers[s] = plan.pack( _steps[s].source_values );
+        _recv_buffers[s] =
+            HostBuffer( "recv_buffer", plan.size(), n_columns[s] );
+        export_ranks[s] = &plan.exportRanks();
+        export_offsets[s] = &plan.exportOffsets();
+        import_ranks[s] = &plan.importRanks();
+        import_offsets[s] = &plan.importOffsets();
+    }
+
+    // Gather the blocks sent to each process in a single message.
+    auto const export_layout =
+        combineMessages( export_ranks, export_offsets, n_columns );
+    _import_layout = combineMessages( import_ranks, import_offsets, n_columns );
+    _send_message.resize( export_layout.offsets.back() );
+    _recv_message.resize( _import_layout.offsets.back() );
+    for ( int s = 0; s < n_steps; ++s )
+        for ( unsigned int k = 0; k < export_ranks[s]->size(); ++k )
+            std::copy( send_buffers[s].data() +
+                           ( *export_offsets[s] )[k] * n_columns[s],
+                       send_buffers[s].data() +
+                           ( *export_offsets[s] )[k + 1] * n_columns[s],
+                       _send_message.data() + export_layout.positions[s][k] );
+
+    // Post the receives before the sends.
+    int const tag = 0;
+    int const n_recvs = _import_layout.ranks.size();
+    int const n_sends = export_layout.ranks.size();
+    _requests.resize( n_recvs + n_sends );
+    for ( int m = 0; m < n_recvs; ++m )
+        MPI_Irecv( _recv_message.data() + _import_layout.offsets[m],
+                   _import_layout.offsets[m + 1] - _import_layout.offsets[m],
+                   MPI_DOUBLE, _import_layout.ranks[m], tag, comm,
+                   &_requests[m] );
+    for ( int m = 0; m < n_sends; ++m )
+        MPI_Isend( _send_message.data() + export_layout.offsets[m],
+                   export_layout.offsets[m + 1] - export_layout.offsets[m],
+                   MPI_DOUBLE, export_layout.ranks[m], tag, comm,
+                   &_requests[n_recvs + m] );
+}
+
+template <typename DeviceType>
+void FetchApplyRequest<DeviceType>::wait()
+{
+    if ( _done )
+        return;
+    MPI_Waitall( _requests.size(), _requests.data(), MPI_STATUSES_IGNORE );
+    _done = true;
+
+    // Split the messages received between the steps and compute the target
+    // values.
+    for ( unsigned int s = 0; s < _steps.size(); ++s )
+    {
+        if ( _steps[s].plan == nullptr )
+        {
+            _steps[s].finalize( Kokkos::View<double **, DeviceType>(
+                "values", 0, _steps[s].source_values.extent( 1 ) ) );
+            continue;
+        }
+
+        auto const &plan = *_steps[s].plan;
+        auto const &import_offsets = plan.importOffsets();
+        int const n_columns = _recv_buffers[s].extent( 1 );
+        for ( unsigned int k = 0; k < plan.importRanks().size(); ++k )
+        {
+            auto const begin =
+                _recv_message.data() + _import_layout.positions[s][k];
+            std::copy( begin,
+                       begin + ( import_offsets[k + 1] - import_offsets[k] ) *
+                                   n_columns,
+                       _recv_buffers[s].data() +
+                           import_offsets[k] * n_columns );
+        }
+        _steps[s].finalize( plan.unpack( _recv_buffers[s] ) );
+    }
+
+    // Release the buffers.
+    _recv_buffers.clear();
+    _send_message.clear();
+    _recv_message.clear();
+}
+
+template <typename DeviceType>
+Kokkos::View<double **, DeviceType> FetchPlan<DeviceType>::fetch(
+    Kokkos::View<double const **, DeviceType> source_values ) const
+{
+    Kokkos::View<double **, DeviceType> values;
+    FetchApplyStep<DeviceType> step{
+        this, source_values,
+        [&values]( Kokkos::View<double **, DeviceType> fetched_values ) {
+            values = fetched_values;
+        }};
+    FetchApplyRequest<DeviceType> request( {step} );
+    request.wait();
+    return values;
+}
+
+} // namespace Details
+} // namespace DataTransferKit
+
+#endif
@@ -17,6 +17,11 @@
 #include <DTK_CompactlySupportedRadialBasisFunctions.hpp>
 #include <DTK_DetailsSVDImpl.hpp>
 
+#include <mpi.h>
+
+#include <array>
+#include <limits>
+
 namespace DataTransferKit
 {
 namespace Details
@@ -26,44 +31,97 @@ struct MovingLeastSquaresOperatorImpl
 {
     using ExecutionSpace = typename DeviceType::execution_space;
 
+    // Compute the bounding box of the points on all the processors.
+    static ArborX::Box computeBoundingBox(
+        MPI_Comm comm, Kokkos::View<Coordinate const **, DeviceType> points )
+    {
+        auto const n_points = points.extent( 0 );
+        std::array<double, 3> min_corner;
+        std::array<double, 3> max_corner;
+        for ( int d = 0; d < 3; ++d )
+        {
+            Kokkos::parallel_reduce(
+                DTK_MARK_REGION( "compute_min_corner" ),
+                Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+                KOKKOS_LAMBDA( int i, double &min_value ) {
+                    if ( points( i, d ) < min_value )
+                        min_value = points( i, d );
+                },
+                Kokkos::Min<double>( min_corner[d] ) );
+            Kokkos::parallel_reduce(
+                DTK_MARK_REGION( "compute_max_corner" ),
+                Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+                KOKKOS_LAMBDA( int i, double &max_value ) {
+                    if ( points( i, d ) > max_value )
+                        max_value = points( i, d );
+                },
+                Kokkos::Max<double>( max_corner[d] ) );
+        }
+        MPI_Allreduce( MPI_IN_PLACE, min_corner.data(), 3, MPI_DOUBLE,
+                       MPI_MIN, comm );
+        MPI_Allreduce( MPI_IN_PLACE, max_corner.data(), 3, MPI_DOUBLE,
+                       MPI_MAX, comm );
+
+        ArborX::Box box;
+        for ( int d = 0; d < 3; ++d )
+        {
+            box.minCorner()[d] = min_corner[d];
+            box.maxCorner()[d] = max_corner[d];
+        }
+        return box;
+    }
+
+    // The target points farther than max_distance from source_box do not
+    // query any neighbor. If max_distance is not finite, source_box is not
+    // used and all the target points query n_neighbors neighbors.
     static Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType>
     makeKNNQueries( typename Kokkos::View<Coordinate **, DeviceType>::const_type
                         target_points,
-                    unsigned int n_neighbors )
+                    unsigned int n_neighbors, ArborX::Box const &source_box,
+                    double max_distance )
     {
         auto const n_points = target_points.extent( 0 );
+        bool const cull = ( max_distance < std::numeric_limits<double>::max() );
         Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType> queries(
             "queries", n_points );
         Kokkos::parallel_for(
             DTK_MARK_REGION( "setup_queries" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
             KOKKOS_LAMBDA( int i ) {
-                queries( i ) = nearest(
-                    ArborX::Point{{target_points( i, 0 ), target_points( i, 1 ),
-                                   target_points( i, 2 )}},
-                    n_neighbors );
+                ArborX::Point const point = {{target_points( i, 0 ),
+                                              target_points( i, 1 ),
+                                              target_points( i, 2 )}};
+                bool const culled =
+                    cull && ( ArborX::Details::distance( point, source_box ) >
+                              max_distance );
+                queries( i ) = nearest( point, culled ? 0 : n_neighbors );
             } );
         Kokkos::fence();
         return queries;
     }
 
-    static Kokkos::View<double *, DeviceType> computeTargetValues(
+    // The target points without neighbors get zero.
+    static Kokkos::View<double **, DeviceType> computeTargetValues(
         Kokkos::View<int const *, DeviceType> offset,
         Kokkos::View<double const *, DeviceType> polynomial_coeffs,
-        Kokkos::View<double const *, DeviceType> source_values )
+        Kokkos::View<double const **, DeviceType> source_values )
     {
         auto const n_target_points = offset.extent_int( 0 ) - 1;
-        Kokkos::View<double *, DeviceType> target_values(
-            std::string( "target_" ) + source_values.label(), n_target_points );
+        auto const n_columns = source_values.extent_int( 1 );
+        Kokkos::View<double **, DeviceType> target_values(
+            std::string( "target_" ) + source_values.label(), n_target_points,
+            n_columns );
 
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_values" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
             KOKKOS_LAMBDA( const int i ) {
-                target_values( i ) = 0.;
+                for ( int k = 0; k < n_columns; ++k )
+                    target_values( i, k ) = 0.;
                 for ( int j = offset( i ); j < offset( i + 1 ); ++j )
-                    target_values( i ) +=
-                        polynomial_coeffs( j ) * source_values( j );
+                    for ( int k = 0; k < n_columns; ++k )
+                        target_values( i, k ) +=
+                            polynomial_coeffs( j ) * source_values( j, k );
             } );
         Kokkos::fence();
 
@@ -240,9 +298,12 @@ struct MovingLeastSquaresOperatorImpl
 
     // Matrix pseudo-inversion using SVD
     // Takes in a 1D array of matrices of size NxN, and returns a 1D array of
-    // matrices of the same size containing corresponding pseudo-inverses
+    // matrices of the same size containing corresponding pseudo-inverses. The
+    // matrices of the target points without neighbors are zero and they are
+    // skipped, their pseudo-inverse is zero.
     static std::tuple<Kokkos::View<double *, DeviceType>, size_t>
-    invertMoments( Kokkos::View<double const *, DeviceType> a,
+    invertMoments( Kokkos::View<int const *, DeviceType> offset,
+                   Kokkos::View<double const *, DeviceType> a,
                    const int size_polynomial_basis )
     {
         Kokkos::View<double *, DeviceType> inv_a( "inv_a", a.extent( 0 ) );
@@ -265,7 +326,11 @@ struct MovingLeastSquaresOperatorImpl
         size_t num_underdetermined = 0;
         Kokkos::parallel_reduce(
             DTK_MARK_REGION( "compute_svd_inverse" ),
-            Kokkos::RangePolicy<ExecutionSpace>( 0, num_matrices ), svdFunctor,
+            Kokkos::RangePolicy<ExecutionSpace>( 0, num_matrices ),
+            KOKKOS_LAMBDA( int const i, size_t &partial_sum ) {
+                if ( offset( i + 1 ) > offset( i ) )
+                    svdFunctor( i, partial_sum );
+            },
             num_underdetermined );
 
         return std::make_tuple( inv_a, num_underdetermined );
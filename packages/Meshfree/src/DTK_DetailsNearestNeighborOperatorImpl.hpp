@@ -14,6 +14,9 @@
 
 #include <ArborX.hpp>
 #include <DTK_DBC.hpp>
+#include <DTK_DistributedRectilinearGrid.hpp>
+#include <DTK_DistributedSpatialHash.hpp>
+#include <DTK_PointCloudOperator.hpp> // SearchBackend
 
 namespace DataTransferKit
 {
@@ -44,6 +47,42 @@ struct NearestNeighborOperatorImpl
         return nearest_queries;
     }
 
+    // Build the search structure selected over the source points and find the
+    // neighbors of the target points.
+    static void
+    search( MPI_Comm comm, SearchBackend backend,
+            Kokkos::View<Coordinate const **, DeviceType> source_points,
+            Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType> queries,
+            Kokkos::View<int *, DeviceType> &indices,
+            Kokkos::View<int *, DeviceType> &offset,
+            Kokkos::View<int *, DeviceType> &ranks )
+    {
+        if ( backend == SearchBackend::SpatialHash )
+        {
+            DistributedSpatialHash<DeviceType> spatial_hash( comm,
+                                                             source_points );
+            // There must be at least one source point, otherwise it makes
+            // little sense to perform the search for nearest neighbors.
+            DTK_CHECK( !spatial_hash.empty() );
+            spatial_hash.query( queries, indices, offset, ranks );
+        }
+        else if ( backend == SearchBackend::RectilinearGrid )
+        {
+            DistributedRectilinearGrid<DeviceType> grid( comm, source_points );
+            DTK_CHECK( !grid.empty() );
+            grid.query( queries, indices, offset, ranks );
+        }
+        else
+        {
+            ArborX::DistributedSearchTree<DeviceType> search_tree(
+                comm, source_points );
+            // Tree must have at least one leaf, otherwise it makes little
+            // sense to perform the search for nearest neighbors.
+            DTK_CHECK( !search_tree.empty() );
+            search_tree.query( queries, indices, offset, ranks );
+        }
+    }
+
     template <typename View>
     static void
     pullSourceValues( MPI_Comm comm, View source_values,
@@ -0,0 +1,368 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_DISTRIBUTED_RECTILINEAR_GRID_HPP
+#define DTK_DISTRIBUTED_RECTILINEAR_GRID_HPP
+
+#include <ArborX.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_DetailsFetchPlan.hpp>
+#include <DTK_RectilinearGridLocator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace DataTransferKit
+{
+/**
+ * Nearest neighbor search among source points that are the nodes of a
+ * rectilinear grid. The source points of each processor are the nodes of a
+ * block of the grid, in any order, and the blocks of the processors
+ * partition the grid. The nodes on the boundary between two blocks may be
+ * duplicated. The grid is described by its edges and the block decomposition
+ * with a RectilinearGridLocator so no search tree is built: the nodes close
+ * to a query are found by a lookup in each dimension and are owned by known
+ * processors.
+ */
+template <typename DeviceType>
+class DistributedRectilinearGrid
+{
+  public:
+    /**
+     * Constructor. This is a collective operation. It throws if the source
+     * points are not the nodes of a partitioned rectilinear grid.
+     */
+    DistributedRectilinearGrid(
+        MPI_Comm comm, Kokkos::View<Coordinate const **, DeviceType> points );
+
+    /**
+     * Whether there is no source point on any of the processors.
+     */
+    bool empty() const { return !_locator; }
+
+    /**
+     * Find the k nearest source points of each query among the points of all
+     * the processors. The output follows DistributedSearchTree::query() and
+     * the neighbors of each query are sorted by increasing distance. This is
+     * a collective operation.
+     */
+    void
+    query( Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType> queries,
+           Kokkos::View<int *, DeviceType> &indices,
+           Kokkos::View<int *, DeviceType> &offset,
+           Kokkos::View<int *, DeviceType> &ranks ) const;
+
+  private:
+    MPI_Comm _comm;
+    std::shared_ptr<RectilinearGridLocator> _locator;
+    // Index of the local source point at each node of the block of this
+    // processor, the x index varying fastest. The indices are stored as
+    // doubles so that they can be fetched with a FetchPlan.
+    Kokkos::View<double **, DeviceType> _point_indices;
+};
+
+template <typename DeviceType>
+DistributedRectilinearGrid<DeviceType>::DistributedRectilinearGrid(
+    MPI_Comm comm, Kokkos::View<Coordinate const **, DeviceType> points )
+    : _comm( comm )
+{
+    DTK_REQUIRE( points.extent_int( 1 ) == 3 );
+
+    int comm_size;
+    MPI_Comm_size( _comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( _comm, &comm_rank );
+
+    auto points_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, points );
+    int const n_points = points.extent( 0 );
+
+    // The edges of the block of this processor are the distinct coordinates
+    // of its points.
+    std::array<std::vector<double>, 3> local_edges;
+    for ( int d = 0; d < 3; ++d )
+    {
+        auto &edges = local_edges[d];
+        edges.resize( n_points );
+        for ( int i = 0; i < n_points; ++i )
+            edges[i] = points_host( i, d );
+        std::sort( edges.begin(), edges.end() );
+        edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+    }
+
+    // Number the local points like the nodes of the block. The points must
+    // fill the block: two points at the same node would leave another node
+    // empty. The checks are reduced over all the processors so that they
+    // throw together instead of leaving the others blocked in the collective
+    // operations below.
+    int const n_x = local_edges[0].size();
+    int const n_y = local_edges[1].size();
+    std::vector<int> node_points( n_points, -1 );
+    int valid = static_cast<std::size_t>( n_points ) ==
+                local_edges[0].size() * local_edges[1].size() *
+                    local_edges[2].size();
+    for ( int i = 0; valid && i < n_points; ++i )
+    {
+        std::array<int, 3> ijk;
+        for ( int d = 0; d < 3; ++d )
+            ijk[d] = std::lower_bound( local_edges[d].begin(),
+                                       local_edges[d].end(),
+                                       points_host( i, d ) ) -
+                     local_edges[d].begin();
+        int const node = ijk[0] + n_x * ( ijk[1] + n_y * ijk[2] );
+        if ( node_points[node] != -1 )
+            valid = 0;
+        node_points[node] = i;
+    }
+    MPI_Allreduce( MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_LAND, _comm );
+    DTK_INSIST( valid );
+
+    // Merge the edges of all the blocks to find where each block starts.
+    std::array<int, 3> edge_offsets;
+    std::array<int, 6> local_block;
+    for ( int d = 0; d < 3; ++d )
+    {
+        int const n_local_edges = local_edges[d].size();
+        std::vector<int> counts( comm_size );
+        MPI_Allgather( &n_local_edges, 1, MPI_INT, counts.data(), 1, MPI_INT,
+                       _comm );
+        std::vector<int> displs( comm_size + 1, 0 );
+        for ( int r = 0; r < comm_size; ++r )
+            displs[r + 1] = displs[r] + counts[r];
+        std::vector<double> edges( displs.back() );
+        MPI_Allgatherv( local_edges[d].data(), n_local_edges, MPI_DOUBLE,
+                        edges.data(), counts.data(), displs.data(), MPI_DOUBLE,
+                        _comm );
+        std::sort( edges.begin(), edges.end() );
+        edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+
+        edge_offsets[d] =
+            n_local_edges > 0
+                ? std::lower_bound( edges.begin(), edges.end(),
+                                    local_edges[d].front() ) -
+                      edges.begin()
+                : -1;
+        // The local edges must be contiguous in the global edges.
+        for ( int i = 0; i < n_local_edges; ++i )
+            if ( edges[edge_offsets[d] + i] != local_edges[d][i] )
+                valid = 0;
+        local_block[d] = edge_offsets[d];
+        local_block[3 + d] = n_local_edges;
+    }
+    MPI_Allreduce( MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_LAND, _comm );
+    DTK_INSIST( valid );
+
+    // Each distinct offset starts a block. The processors without any point
+    // do not own a block.
+    std::vector<int> blocks( 6 * comm_size );
+    MPI_Allgather( local_block.data(), 6, MPI_INT, blocks.data(), 6, MPI_INT,
+                   _comm );
+    std::array<std::vector<int>, 3> block_offsets;
+    for ( int d = 0; d < 3; ++d )
+    {
+        for ( int r = 0; r < comm_size; ++r )
+            if ( blocks[6 * r + 3 + d] > 0 )
+                block_offsets[d].push_back( blocks[6 * r + d] );
+        std::sort( block_offsets[d].begin(), block_offsets[d].end() );
+        block_offsets[d].erase(
+            std::unique( block_offsets[d].begin(), block_offsets[d].end() ),
+            block_offsets[d].end() );
+    }
+    // There is no point on any processor.
+    if ( block_offsets[0].empty() )
+        return;
+
+    std::array<int, 3> const num_blocks = {
+        {static_cast<int>( block_offsets[0].size() ),
+         static_cast<int>( block_offsets[1].size() ),
+         static_cast<int>( block_offsets[2].size() )}};
+    std::vector<int> block_ranks( num_blocks[0] * num_blocks[1] *
+                                      num_blocks[2],
+                                  -1 );
+    std::array<int, 3> ijk_block = {{-1, -1, -1}};
+    for ( int r = 0; r < comm_size; ++r )
+    {
+        if ( blocks[6 * r + 3] == 0 )
+            continue;
+        std::array<int, 3> ijk;
+        for ( int d = 0; d < 3; ++d )
+            ijk[d] = std::lower_bound( block_offsets[d].begin(),
+                                       block_offsets[d].end(),
+                                       blocks[6 * r + d] ) -
+                     block_offsets[d].begin();
+        int const block_id =
+            ijk[0] + num_blocks[0] * ( ijk[1] + num_blocks[1] * ijk[2] );
+        // Each block must be owned by a single processor.
+        DTK_INSIST( block_ranks[block_id] == -1 );
+        block_ranks[block_id] = r;
+        if ( r == comm_rank )
+            ijk_block = ijk;
+    }
+    // The blocks must cover the grid.
+    DTK_INSIST( std::find( block_ranks.begin(), block_ranks.end(), -1 ) ==
+                block_ranks.end() );
+
+    _locator = std::make_shared<RectilinearGridLocator>(
+        _comm, num_blocks, ijk_block, local_edges, edge_offsets, block_ranks );
+
+    _point_indices = Kokkos::View<double **, DeviceType>( "point_indices",
+                                                          n_points, 1 );
+    auto point_indices_host = Kokkos::create_mirror_view( _point_indices );
+    for ( int node = 0; node < n_points; ++node )
+        point_indices_host( node, 0 ) = node_points[node];
+    Kokkos::deep_copy( _point_indices, point_indices_host );
+}
+
+template <typename DeviceType>
+void DistributedRectilinearGrid<DeviceType>::query(
+    Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType> queries,
+    Kokkos::View<int *, DeviceType> &indices,
+    Kokkos::View<int *, DeviceType> &offset,
+    Kokkos::View<int *, DeviceType> &ranks ) const
+{
+    DTK_REQUIRE( _locator );
+
+    auto queries_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, queries );
+    int const n_queries = queries.extent( 0 );
+
+    std::array<int, 3> n_nodes;
+    for ( int d = 0; d < 3; ++d )
+        n_nodes[d] = _locator->globalEdges( d ).size();
+
+    auto offset_host =
+        Kokkos::View<int *, Kokkos::HostSpace>( "offset", n_queries + 1 );
+    std::vector<int> result_ranks;
+    std::vector<int> result_nodes;
+    std::vector<std::pair<double, std::array<int, 3>>> candidates;
+    for ( int q = 0; q < n_queries; ++q )
+    {
+        offset_host( q ) = result_ranks.size();
+        int const k = queries_host( q )._k;
+        if ( k == 0 )
+            continue;
+        auto const &point = queries_host( q )._geometry;
+
+        // Start from the node closest to the query in each dimension.
+        std::array<int, 3> closest;
+        for ( int d = 0; d < 3; ++d )
+        {
+            auto const &edges = _locator->globalEdges( d );
+            int const cell = _locator->locateCell( d, point[d] );
+            if ( cell < 0 )
+                closest[d] = point[d] < edges.front() ? 0 : n_nodes[d] - 1;
+            else
+                closest[d] = point[d] - edges[cell] < edges[cell + 1] - point[d]
+                                 ? cell
+                                 : cell + 1;
+        }
+
+        // Widen the window of nodes around the closest node until the k-th
+        // neighbor in the window is closer than any node outside of it.
+        for ( int width = 0;; ++width )
+        {
+            std::array<int, 3> lo;
+            std::array<int, 3> hi;
+            double gap = std::numeric_limits<double>::max();
+            for ( int d = 0; d < 3; ++d )
+            {
+                auto const &edges = _locator->globalEdges( d );
+                lo[d] = std::max( closest[d] - width, 0 );
+                hi[d] = std::min( closest[d] + width, n_nodes[d] - 1 );
+                if ( lo[d] > 0 )
+                    gap = std::min( gap, point[d] - edges[lo[d] - 1] );
+                if ( hi[d] < n_nodes[d] - 1 )
+                    gap = std::min( gap, edges[hi[d] + 1] - point[d] );
+            }
+
+            candidates.clear();
+            for ( int k_node = lo[2]; k_node <= hi[2]; ++k_node )
+                for ( int j_node = lo[1]; j_node <= hi[1]; ++j_node )
+                    for ( int i_node = lo[0]; i_node <= hi[0]; ++i_node )
+                    {
+                        std::array<int, 3> const ijk = {
+                            {i_node, j_node, k_node}};
+                        double distance = 0.;
+                        for ( int d = 0; d < 3; ++d )
+                        {
+                            double const delta =
+                                _locator->globalEdges( d )[ijk[d]] - point[d];
+                            distance += delta * delta;
+                        }
+                        candidates.emplace_back( distance, ijk );
+                    }
+            int const n_candidates = candidates.size();
+            int const n_neighbors = std::min( k, n_candidates );
+            std::partial_sort(
+                candidates.begin(), candidates.begin() + n_neighbors,
+                candidates.end(),
+                []( std::pair<double, std::array<int, 3>> const &a,
+                    std::pair<double, std::array<int, 3>> const &b ) {
+                    return a.first < b.first;
+                } );
+            bool const complete = gap == std::numeric_limits<double>::max();
+            if ( complete ||
+                 ( n_neighbors == k &&
+                   std::sqrt( candidates[k - 1].first ) <= gap ) )
+            {
+                for ( int i = 0; i < n_neighbors; ++i )
+                {
+                    int rank;
+                    LocalOrdinal node;
+                    _locator->nodeOwner( candidates[i].second, rank, node );
+                    DTK_CHECK( rank >= 0 );
+                    result_ranks.push_back( rank );
+                    result_nodes.push_back( node );
+                }
+                break;
+            }
+        }
+    }
+    offset_host( n_queries ) = result_ranks.size();
+    offset = Kokkos::View<int *, DeviceType>( "offset", n_queries + 1 );
+    Kokkos::deep_copy( offset, offset_host );
+
+    // Get the indices of the points at the nodes found from their owners.
+    int const n_results = result_ranks.size();
+    ranks = Kokkos::View<int *, DeviceType>( "ranks", n_results );
+    Kokkos::deep_copy(
+        ranks, Kokkos::View<int *, Kokkos::HostSpace,
+                            Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                   result_ranks.data(), n_results ) );
+    Kokkos::View<int *, DeviceType> nodes( "nodes", n_results );
+    Kokkos::deep_copy(
+        nodes, Kokkos::View<int *, Kokkos::HostSpace,
+                            Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                   result_nodes.data(), n_results ) );
+    Details::FetchPlan<DeviceType> fetch_plan( _comm, ranks, nodes );
+    auto const point_indices = fetch_plan.fetch( _point_indices );
+    indices = Kokkos::View<int *, DeviceType>( "indices", n_results );
+    auto indices_ = indices;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "convert_point_indices" ),
+        Kokkos::RangePolicy<typename DeviceType::execution_space>( 0,
+                                                                   n_results ),
+        KOKKOS_LAMBDA( int i ) { indices_( i ) = point_indices( i, 0 ); } );
+    Kokkos::fence();
+}
+
+} // namespace DataTransferKit
+
+#endif
@@ -0,0 +1,600 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_DISTRIBUTED_SPATIAL_HASH_HPP
+#define DTK_DISTRIBUTED_SPATIAL_HASH_HPP
+
+#include <ArborX.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_SpatialHash.hpp>
+
+#include <Kokkos_Array.hpp>
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace DataTransferKit
+{
+/**
+ * Distributed counterpart of SpatialHash. Instead of forwarding the queries to
+ * the processors owning the source points like DistributedSearchTree, each
+ * processor receives the source points of the other processors that lie in a
+ * halo around its own queries and answers them locally.
+ *
+ * The queries are first answered with the local points only: the distance to
+ * the k-th local neighbor bounds the distance to the k-th neighbor among all
+ * the points, so the halo of a processor is as wide as the largest of these
+ * distances and a single exchange is enough when every query has k local
+ * neighbors. Otherwise, the halo of the processor is doubled and only the
+ * points in the new layer of the halo are sent, until the k-th neighbor of
+ * every query is closer than the width of the halo.
+ */
+template <typename DeviceType>
+class DistributedSpatialHash
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    /**
+     * Constructor. This is a collective operation. If \p cell_size is not
+     * positive, the cells of the hash of each processor are chosen such that
+     * they contain on average one of the points hashed.
+     */
+    DistributedSpatialHash(
+        MPI_Comm comm, Kokkos::View<Coordinate const **, DeviceType> points,
+        double cell_size = 0. );
+
+    /**
+     * Whether there is no source point on any of the processors.
+     */
+    bool empty() const { return _n_global_points == 0; }
+
+    /**
+     * Find the k nearest source points of each query among the points of all
+     * the processors. The output follows DistributedSearchTree::query(): the
+     * neighbors of query i are indices(offset(i)) to indices(offset(i+1)-1)
+     * on the processors ranks(offset(i)) to ranks(offset(i+1)-1), sorted by
+     * increasing distance. This is a collective operation.
+     */
+    void
+    query( Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType> queries,
+           Kokkos::View<int *, DeviceType> &indices,
+           Kokkos::View<int *, DeviceType> &offset,
+           Kokkos::View<int *, DeviceType> &ranks ) const;
+
+  private:
+    // Hash the points in their bounding box.
+    SpatialHash<DeviceType>
+    buildHash( Kokkos::View<Coordinate const **, DeviceType> points ) const;
+
+    MPI_Comm _comm;
+    Kokkos::View<Coordinate const **, DeviceType> _points;
+    long long _n_global_points;
+    double _cell_size;
+    // Average spacing of the points of all the processors. This is the
+    // initial width of the halo of the processors whose queries do not have
+    // enough local neighbors.
+    double _spacing;
+    // Bounding box of the local points
+    Kokkos::Array<double, 3> _local_min_corner;
+    Kokkos::Array<double, 3> _local_max_corner;
+    // Bounding box of the points of all the processors
+    Kokkos::Array<double, 3> _min_corner;
+    Kokkos::Array<double, 3> _max_corner;
+};
+
+namespace Details
+{
+// Bounding box of a set of points. An empty set of points gives an empty box
+// with the minimum corner larger than the maximum corner.
+template <typename DeviceType>
+void computeSpatialHashBox(
+    Kokkos::View<Coordinate const **, DeviceType> points,
+    Kokkos::Array<double, 3> &min_corner, Kokkos::Array<double, 3> &max_corner )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    int const n_points = points.extent( 0 );
+    for ( int d = 0; d < 3; ++d )
+    {
+        Kokkos::parallel_reduce(
+            DTK_MARK_REGION( "compute_min_corner" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+            KOKKOS_LAMBDA( int i, double &min_value ) {
+                if ( points( i, d ) < min_value )
+                    min_value = points( i, d );
+            },
+            Kokkos::Min<double>( min_corner[d] ) );
+        Kokkos::parallel_reduce(
+            DTK_MARK_REGION( "compute_max_corner" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+            KOKKOS_LAMBDA( int i, double &max_value ) {
+                if ( points( i, d ) > max_value )
+                    max_value = points( i, d );
+            },
+            Kokkos::Max<double>( max_corner[d] ) );
+    }
+}
+
+// Average spacing of n_points points in a box. The flat dimensions of the box
+// are ignored.
+inline double spatialHashSpacing( Kokkos::Array<double, 3> const &min_corner,
+                                  Kokkos::Array<double, 3> const &max_corner,
+                                  long long n_points )
+{
+    double volume = 1.;
+    int n_dims = 0;
+    for ( int d = 0; d < 3; ++d )
+    {
+        double const extent = max_corner[d] - min_corner[d];
+        if ( extent > 0. )
+        {
+            volume *= extent;
+            ++n_dims;
+        }
+    }
+    return n_dims > 0 && n_points > 0
+               ? std::pow( volume / n_points, 1. / n_dims )
+               : 1.;
+}
+} // namespace Details
+
+template <typename DeviceType>
+DistributedSpatialHash<DeviceType>::DistributedSpatialHash(
+    MPI_Comm comm, Kokkos::View<Coordinate const **, DeviceType> points,
+    double cell_size )
+    : _comm( comm )
+    , _points( points )
+    , _cell_size( cell_size )
+{
+    DTK_REQUIRE( points.extent_int( 1 ) == 3 );
+
+    Details::computeSpatialHashBox( points, _local_min_corner,
+                                    _local_max_corner );
+    MPI_Allreduce( _local_min_corner.data(), _min_corner.data(), 3,
+                   MPI_DOUBLE, MPI_MIN, _comm );
+    MPI_Allreduce( _local_max_corner.data(), _max_corner.data(), 3,
+                   MPI_DOUBLE, MPI_MAX, _comm );
+    long long const n_local_points = points.extent( 0 );
+    MPI_Allreduce( &n_local_points, &_n_global_points, 1, MPI_LONG_LONG,
+                   MPI_SUM, _comm );
+    _spacing = Details::spatialHashSpacing( _min_corner, _max_corner,
+                                            _n_global_points );
+}
+
+template <typename DeviceType>
+SpatialHash<DeviceType> DistributedSpatialHash<DeviceType>::buildHash(
+    Kokkos::View<Coordinate const **, DeviceType> points ) const
+{
+    Kokkos::Array<double, 3> min_corner;
+    Kokkos::Array<double, 3> max_corner;
+    Details::computeSpatialHashBox( points, min_corner, max_corner );
+    // The hash is not used if there is no point.
+    if ( points.extent( 0 ) == 0 )
+        for ( int d = 0; d < 3; ++d )
+            min_corner[d] = max_corner[d] = 0.;
+    double const cell_size =
+        _cell_size > 0. ? _cell_size
+                        : Details::spatialHashSpacing(
+                              min_corner, max_corner, points.extent( 0 ) );
+    return SpatialHash<DeviceType>( points, min_corner, max_corner,
+                                    cell_size );
+}
+
+template <typename DeviceType>
+void DistributedSpatialHash<DeviceType>::query(
+    Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType> queries,
+    Kokkos::View<int *, DeviceType> &indices,
+    Kokkos::View<int *, DeviceType> &offset,
+    Kokkos::View<int *, DeviceType> &ranks ) const
+{
+    int comm_size;
+    MPI_Comm_size( _comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( _comm, &comm_rank );
+
+    // Every query gets k neighbors unless there are fewer points overall.
+    int const n_queries = queries.extent( 0 );
+    long long const n_global_points = _n_global_points;
+    Kokkos::View<int *, DeviceType> count( "count", n_queries + 1 );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "count_neighbors" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_queries ),
+        KOKKOS_LAMBDA( int const i ) {
+            long long const k = queries( i )._k;
+            count( i ) = k < n_global_points ? k : n_global_points;
+        } );
+    Kokkos::fence();
+    offset = Kokkos::View<int *, DeviceType>( "offset", n_queries + 1 );
+    ArborX::exclusivePrefixSum( ExecutionSpace{}, count, offset );
+    int const n_results = ArborX::lastElement( offset );
+    auto const offset_ = offset;
+    // Index of the neighbors in the points hashed and squared distances
+    Kokkos::View<int *, DeviceType> hash_indices( "indices", n_results );
+    Kokkos::View<double *, DeviceType> squared_distances( "distances",
+                                                          n_results );
+
+    // Bounding box of the queries that look for neighbors.
+    Kokkos::Array<double, 3> query_min_corner;
+    Kokkos::Array<double, 3> query_max_corner;
+    for ( int d = 0; d < 3; ++d )
+    {
+        Kokkos::parallel_reduce(
+            DTK_MARK_REGION( "compute_queries_min_corner" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_queries ),
+            KOKKOS_LAMBDA( int i, double &min_value ) {
+                double const x = queries( i )._geometry[d];
+                if ( queries( i )._k > 0 && x < min_value )
+                    min_value = x;
+            },
+            Kokkos::Min<double>( query_min_corner[d] ) );
+        Kokkos::parallel_reduce(
+            DTK_MARK_REGION( "compute_queries_max_corner" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_queries ),
+            KOKKOS_LAMBDA( int i, double &max_value ) {
+                double const x = queries( i )._geometry[d];
+                if ( queries( i )._k > 0 && x > max_value )
+                    max_value = x;
+            },
+            Kokkos::Max<double>( query_max_corner[d] ) );
+    }
+    // Once the halo is that wide, it covers the bounding box of all the
+    // points and all the neighbors have been exchanged.
+    double full_width = 0.;
+    for ( int d = 0; d < 3; ++d )
+        full_width =
+            std::max( {full_width, query_min_corner[d] - _min_corner[d],
+                       _max_corner[d] - query_max_corner[d]} );
+
+    // The points hashed are the local points followed by the points received
+    // from the other processors.
+    int const n_local_points = _points.extent( 0 );
+    Kokkos::View<Coordinate **, DeviceType> all_points( "points",
+                                                        n_local_points, 3 );
+    Kokkos::deep_copy( all_points, _points );
+    Kokkos::View<int *, DeviceType> import_indices( "indices", 0 );
+    Kokkos::View<int *, DeviceType> import_owners( "ranks", 0 );
+
+    // Queries that are not answered yet. Initially, all of them are searched
+    // among the local points.
+    Kokkos::View<int *, DeviceType> pending( "pending", n_queries );
+    ArborX::iota( ExecutionSpace{}, pending );
+    // Width of the halo of each processor and width of the halo already sent
+    // to it. A negative width means that the processor does not need more
+    // points.
+    std::vector<double> widths( comm_size );
+    std::vector<double> sent_widths( comm_size, -1. );
+    std::vector<double> query_boxes( 6 * comm_size );
+    double width = -1.;
+    auto spatial_hash = buildHash( all_points );
+    for ( int pass = 0;; ++pass )
+    {
+        // Search the pending queries among the points hashed so far and store
+        // the neighbors in place.
+        int const n_pending = pending.extent( 0 );
+        Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType>
+            pending_queries( "queries", n_pending );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "gather_pending_queries" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_pending ),
+            KOKKOS_LAMBDA( int const i ) {
+                pending_queries( i ) = queries( pending( i ) );
+            } );
+        Kokkos::fence();
+        Kokkos::View<int *, DeviceType> pending_indices( "indices", 0 );
+        Kokkos::View<int *, DeviceType> pending_offset( "offset", 0 );
+        Kokkos::View<double *, DeviceType> pending_distances( "distances", 0 );
+        spatial_hash.query( pending_queries, pending_indices, pending_offset,
+                            pending_distances );
+
+        // A query is answered if its k-th neighbor is closer than the width
+        // of the halo: the points that were not received are farther away.
+        // The distance to the k-th local neighbor of the queries that have k
+        // local neighbors gives the width of the halo after the first pass.
+        Kokkos::View<int *, DeviceType> unanswered( "unanswered",
+                                                    n_pending + 1 );
+        double const squared_width =
+            pass == 0 || width >= full_width
+                ? std::numeric_limits<double>::max()
+                : width * width;
+        double max_distance = 0.;
+        Kokkos::parallel_reduce(
+            DTK_MARK_REGION( "store_neighbors" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_pending ),
+            KOKKOS_LAMBDA( int const i, double &max_value ) {
+                int const q = pending( i );
+                int const begin = offset_( q );
+                int const k = offset_( q + 1 ) - begin;
+                int const n_found =
+                    pending_offset( i + 1 ) - pending_offset( i );
+                for ( int j = 0; j < n_found; ++j )
+                {
+                    hash_indices( begin + j ) =
+                        pending_indices( pending_offset( i ) + j );
+                    squared_distances( begin + j ) =
+                        pending_distances( pending_offset( i ) + j );
+                }
+                bool const found_all = ( n_found == k );
+                if ( k > 0 && found_all &&
+                     squared_distances( begin + k - 1 ) > max_value )
+                    max_value = squared_distances( begin + k - 1 );
+                unanswered( i ) =
+                    k > 0 && ( !found_all || squared_distances(
+                                                 begin + k - 1 ) >
+                                                 squared_width )
+                        ? 1
+                        : 0;
+            },
+            Kokkos::Max<double>( max_distance ) );
+        Kokkos::View<int *, DeviceType> position( "position", n_pending + 1 );
+        ArborX::exclusivePrefixSum( ExecutionSpace{}, unanswered, position );
+        int const n_unanswered = ArborX::lastElement( position );
+        Kokkos::View<int *, DeviceType> still_pending( "pending",
+                                                       n_unanswered );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "compact_pending_queries" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_pending ),
+            KOKKOS_LAMBDA( int const i ) {
+                if ( unanswered( i ) )
+                    still_pending( position( i ) ) = pending( i );
+            } );
+        Kokkos::fence();
+        pending = still_pending;
+
+        // Widen the halo of this processor if some queries are not answered.
+        if ( pass == 0 )
+            width = std::max( std::sqrt( max_distance ),
+                              n_unanswered > 0 ? _spacing : 0. );
+        else if ( n_unanswered > 0 )
+            width = width > 0. ? 2. * width : _spacing;
+        double const requested_width =
+            ( pass == 0 && n_queries > 0 ) || n_unanswered > 0 ? width : -1.;
+
+        // After the first pass, only the width of the halo of each processor
+        // changes.
+        if ( pass == 0 )
+        {
+            std::vector<double> box( 7 );
+            for ( int d = 0; d < 3; ++d )
+            {
+                box[d] = query_min_corner[d];
+                box[3 + d] = query_max_corner[d];
+            }
+            box[6] = requested_width;
+            std::vector<double> boxes( 7 * comm_size );
+            MPI_Allgather( box.data(), 7, MPI_DOUBLE, boxes.data(), 7,
+                           MPI_DOUBLE, _comm );
+            for ( int r = 0; r < comm_size; ++r )
+            {
+                std::copy( boxes.begin() + 7 * r, boxes.begin() + 7 * r + 6,
+                           query_boxes.begin() + 6 * r );
+                widths[r] = boxes[7 * r + 6];
+            }
+        }
+        else
+        {
+            MPI_Allgather( &requested_width, 1, MPI_DOUBLE, widths.data(), 1,
+                           MPI_DOUBLE, _comm );
+        }
+        if ( std::all_of( widths.begin(), widths.end(),
+                          []( double w ) { return w < 0.; } ) )
+            break;
+
+        // The neighbors of this processor are the processors whose halo
+        // overlaps the local points. Only their boxes are tested and only
+        // the points in the new layer of their halo are sent.
+        std::vector<int> neighbors;
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            if ( r == comm_rank || widths[r] < 0. ||
+                 widths[r] <= sent_widths[r] )
+                continue;
+            bool overlap = true;
+            for ( int d = 0; d < 3; ++d )
+                overlap = overlap &&
+                          _local_min_corner[d] <=
+                              query_boxes[6 * r + 3 + d] + widths[r] &&
+                          _local_max_corner[d] >=
+                              query_boxes[6 * r + d] - widths[r];
+            if ( overlap )
+                neighbors.push_back( r );
+        }
+        int const n_neighbors = neighbors.size();
+        Kokkos::View<int *, DeviceType> neighbor_ranks( "neighbor_ranks",
+                                                        n_neighbors );
+        Kokkos::View<double * [6], DeviceType> halos( "halos", n_neighbors );
+        Kokkos::View<double * [6], DeviceType> sent_halos( "sent_halos",
+                                                           n_neighbors );
+        auto neighbor_ranks_host = Kokkos::create_mirror_view( neighbor_ranks );
+        auto halos_host = Kokkos::create_mirror_view( halos );
+        auto sent_halos_host = Kokkos::create_mirror_view( sent_halos );
+        for ( int n = 0; n < n_neighbors; ++n )
+        {
+            int const r = neighbors[n];
+            neighbor_ranks_host( n ) = r;
+            for ( int d = 0; d < 3; ++d )
+            {
+                halos_host( n, d ) = query_boxes[6 * r + d] - widths[r];
+                halos_host( n, 3 + d ) = query_boxes[6 * r + 3 + d] + widths[r];
+                // The halo already sent is empty if nothing was sent yet.
+                bool const sent = sent_widths[r] >= 0.;
+                sent_halos_host( n, d ) =
+                    sent ? query_boxes[6 * r + d] - sent_widths[r]
+                         : std::numeric_limits<double>::max();
+                sent_halos_host( n, 3 + d ) =
+                    sent ? query_boxes[6 * r + 3 + d] + sent_widths[r]
+                         : std::numeric_limits<double>::lowest();
+            }
+            sent_widths[r] = widths[r];
+        }
+        Kokkos::deep_copy( neighbor_ranks, neighbor_ranks_host );
+        Kokkos::deep_copy( halos, halos_host );
+        Kokkos::deep_copy( sent_halos, sent_halos_host );
+
+        auto const points = _points;
+        Kokkos::View<int *, DeviceType> n_halos( "n_halos",
+                                                 n_local_points + 1 );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "count_halo_points" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_local_points ),
+            KOKKOS_LAMBDA( int const i ) {
+                int n_in = 0;
+                for ( int n = 0; n < n_neighbors; ++n )
+                {
+                    bool in_halo = true;
+                    bool in_sent_halo = true;
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        double const x = points( i, d );
+                        in_halo = in_halo && x >= halos( n, d ) &&
+                                  x <= halos( n, 3 + d );
+                        in_sent_halo = in_sent_halo &&
+                                       x >= sent_halos( n, d ) &&
+                                       x <= sent_halos( n, 3 + d );
+                    }
+                    if ( in_halo && !in_sent_halo )
+                        ++n_in;
+                }
+                n_halos( i ) = n_in;
+            } );
+        Kokkos::fence();
+        Kokkos::View<int *, DeviceType> export_offset( "export_offset",
+                                                       n_local_points + 1 );
+        ArborX::exclusivePrefixSum( ExecutionSpace{}, n_halos, export_offset );
+        int const n_exports = ArborX::lastElement( export_offset );
+        Kokkos::View<int *, DeviceType> export_ranks( "export_ranks",
+                                                      n_exports );
+        Kokkos::View<int *, DeviceType> export_indices( "export_indices",
+                                                        n_exports );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "select_halo_points" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_local_points ),
+            KOKKOS_LAMBDA( int const i ) {
+                int pos = export_offset( i );
+                for ( int n = 0; n < n_neighbors; ++n )
+                {
+                    bool in_halo = true;
+                    bool in_sent_halo = true;
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        double const x = points( i, d );
+                        in_halo = in_halo && x >= halos( n, d ) &&
+                                  x <= halos( n, 3 + d );
+                        in_sent_halo = in_sent_halo &&
+                                       x >= sent_halos( n, d ) &&
+                                       x <= sent_halos( n, 3 + d );
+                    }
+                    if ( in_halo && !in_sent_halo )
+                    {
+                        export_ranks( pos ) = neighbor_ranks( n );
+                        export_indices( pos ) = i;
+                        ++pos;
+                    }
+                }
+            } );
+        Kokkos::fence();
+
+        // Send the halo points with their local indices and their owner.
+        ArborX::Details::Distributor<DeviceType> distributor( _comm );
+        int const n_imports =
+            distributor.createFromSends( ExecutionSpace{}, export_ranks );
+
+        Kokkos::View<Coordinate **, DeviceType> export_points( "points",
+                                                               n_exports, 3 );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "pack_halo_points" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_exports ),
+            KOKKOS_LAMBDA( int i ) {
+                for ( int d = 0; d < 3; ++d )
+                    export_points( i, d ) = points( export_indices( i ), d );
+            } );
+        Kokkos::fence();
+        Kokkos::View<Coordinate **, DeviceType> import_points( "points",
+                                                               n_imports, 3 );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( ExecutionSpace{}, distributor,
+                                            export_points, import_points );
+
+        Kokkos::View<int *, DeviceType> new_indices( "indices", n_imports );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( ExecutionSpace{}, distributor,
+                                            export_indices, new_indices );
+
+        Kokkos::View<int *, DeviceType> export_owners( "ranks", n_exports );
+        Kokkos::deep_copy( export_owners, comm_rank );
+        Kokkos::View<int *, DeviceType> new_owners( "ranks", n_imports );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( ExecutionSpace{}, distributor,
+                                            export_owners, new_owners );
+
+        // Append the points received to the points hashed. The neighbors
+        // found so far keep their indices.
+        int const n_hashed = all_points.extent( 0 );
+        int const n_previous_imports = n_hashed - n_local_points;
+        Kokkos::resize( all_points, n_hashed + n_imports, 3 );
+        Kokkos::resize( import_indices, n_previous_imports + n_imports );
+        Kokkos::resize( import_owners, n_previous_imports + n_imports );
+        auto const all_points_ = all_points;
+        auto const import_indices_ = import_indices;
+        auto const import_owners_ = import_owners;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "append_halo_points" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+            KOKKOS_LAMBDA( int const i ) {
+                for ( int d = 0; d < 3; ++d )
+                    all_points_( n_hashed + i, d ) = import_points( i, d );
+                import_indices_( n_previous_imports + i ) = new_indices( i );
+                import_owners_( n_previous_imports + i ) = new_owners( i );
+            } );
+        Kokkos::fence();
+        if ( n_imports > 0 )
+            spatial_hash = buildHash( all_points );
+
+        // All the queries are searched again once the first halo is received
+        // since their local neighbors may not be the closest ones.
+        if ( pass == 0 )
+        {
+            pending = Kokkos::View<int *, DeviceType>( "pending", n_queries );
+            ArborX::iota( ExecutionSpace{}, pending );
+        }
+    }
+
+    // Map the indices in the hash to the owners of the points.
+    indices = Kokkos::View<int *, DeviceType>( "indices", n_results );
+    ranks = Kokkos::View<int *, DeviceType>( "ranks", n_results );
+    auto indices_ = indices;
+    auto ranks_ = ranks;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "set_owners" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_results ),
+        KOKKOS_LAMBDA( int i ) {
+            int const j = hash_indices( i );
+            if ( j < n_local_points )
+            {
+                indices_( i ) = j;
+                ranks_( i ) = comm_rank;
+            }
+            else
+            {
+                indices_( i ) = import_indices( j - n_local_points );
+                ranks_( i ) = import_owners( j - n_local_points );
+            }
+        } );
+    Kokkos::fence();
+}
+
+} // namespace DataTransferKit
+
+#endif
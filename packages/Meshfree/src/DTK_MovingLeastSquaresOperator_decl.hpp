@@ -13,11 +13,14 @@
 #define DTK_MOVING_LEAST_SQUARES_OPERATOR_DECL_HPP
 
 #include <DTK_CompactlySupportedRadialBasisFunctions.hpp>
+#include <DTK_DetailsFetchPlan.hpp>
 #include <DTK_MultivariatePolynomialBasis.hpp>
 #include <DTK_PointCloudOperator.hpp>
 
 #include <mpi.h>
 
+#include <limits>
+
 namespace DataTransferKit
 {
 
@@ -41,22 +44,53 @@ class MovingLeastSquaresOperator : public PointCloudOperator<DeviceType>
     using ExecutionSpace = typename DeviceType::execution_space;
 
   public:
+    /**
+     * Constructor. The target points farther than \p max_distance from the
+     * bounding box of all the source points are not interpolated: apply()
+     * sets their value to zero and they are listed by getNotFoundTargets().
+     * By default, all the target points are interpolated. The neighbors of
+     * the target points are found with \p backend.
+     */
     MovingLeastSquaresOperator(
         MPI_Comm comm,
         Kokkos::View<Coordinate const **, DeviceType> source_points,
-        Kokkos::View<Coordinate const **, DeviceType> target_points );
+        Kokkos::View<Coordinate const **, DeviceType> target_points,
+        double max_distance = std::numeric_limits<double>::max(),
+        SearchBackend backend = SearchBackend::BoundingVolumeHierarchy );
 
     void
     apply( Kokkos::View<double const *, DeviceType> source_values,
            Kokkos::View<double *, DeviceType> target_values ) const override;
 
+    void
+    apply( Kokkos::View<double const **, DeviceType> source_values,
+           Kokkos::View<double **, DeviceType> target_values ) const override;
+
+    std::unique_ptr<PointCloudOperatorRequest> applyBegin(
+        Kokkos::View<double const **, DeviceType> source_values,
+        Kokkos::View<double **, DeviceType> target_values ) const override;
+
+    Details::FetchApplyStep<DeviceType> prepareApply(
+        Kokkos::View<double const **, DeviceType> source_values,
+        Kokkos::View<double **, DeviceType> target_values ) const override;
+
+    /**
+     * Return the indices of the target points that are not interpolated
+     * because they do not have any source point in their neighborhood, e.g.,
+     * because they are farther than max_distance from the source points.
+     */
+    Kokkos::View<int const *, DeviceType> getNotFoundTargets() const
+    {
+        return _not_found_targets;
+    }
+
   private:
     MPI_Comm _comm;
     unsigned int const _n_source_points;
     Kokkos::View<int *, DeviceType> _offset;
-    Kokkos::View<int *, DeviceType> _ranks;
-    Kokkos::View<int *, DeviceType> _indices;
+    Details::FetchPlan<DeviceType> _fetch_plan;
     Kokkos::View<double *, DeviceType> _coeffs;
+    Kokkos::View<int *, DeviceType> _not_found_targets;
 };
 
 } // end namespace DataTransferKit
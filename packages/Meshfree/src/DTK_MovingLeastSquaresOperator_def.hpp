@@ -15,7 +15,7 @@
 #include <ArborX.hpp>
 #include <DTK_DBC.hpp>
 #include <DTK_DetailsMovingLeastSquaresOperatorImpl.hpp>
-#include <DTK_DetailsNearestNeighborOperatorImpl.hpp> // fetch
+#include <DTK_DetailsNearestNeighborOperatorImpl.hpp> // search
 
 namespace DataTransferKit
 {
@@ -27,12 +27,11 @@ MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
     MovingLeastSquaresOperator(
         MPI_Comm comm,
         Kokkos::View<Coordinate const **, DeviceType> source_points,
-        Kokkos::View<Coordinate const **, DeviceType> target_points )
+        Kokkos::View<Coordinate const **, DeviceType> target_points,
+        double max_distance, SearchBackend backend )
     : _comm( comm )
     , _n_source_points( source_points.extent( 0 ) )
     , _offset( "offset", 0 )
-    , _ranks( "ranks", 0 )
-    , _indices( "indices", 0 )
     , _coeffs( "polynomial_coefficients", 0 )
 {
     DTK_REQUIRE( source_points.extent_int( 1 ) ==
@@ -40,24 +39,30 @@ MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
     // FIXME for now let's assume 3D
     DTK_REQUIRE( source_points.extent_int( 1 ) == 3 );
 
-    // Build distributed search tree over the source points.
-    ArborX::DistributedSearchTree<DeviceType> search_tree( _comm,
-                                                           source_points );
-    DTK_CHECK( !search_tree.empty() );
-
     // For each target point, query the n_neighbors points closest to the
-    // target.
+    // target. The targets far away from the source points are culled before
+    // the search, they do not have any neighbor. The bounding box of the
+    // source points, which requires a collective, is only computed if the
+    // targets can be culled.
+    ArborX::Box source_box;
+    if ( max_distance < std::numeric_limits<double>::max() )
+        source_box = Details::MovingLeastSquaresOperatorImpl<
+            DeviceType>::computeBoundingBox( _comm, source_points );
     auto queries =
         Details::MovingLeastSquaresOperatorImpl<DeviceType>::makeKNNQueries(
-            target_points, PolynomialBasis::size );
+            target_points, PolynomialBasis::size, source_box, max_distance );
 
     // Perform the actual search.
-    search_tree.query( queries, _indices, _offset, _ranks );
+    Kokkos::View<int *, DeviceType> ranks( "ranks", 0 );
+    Kokkos::View<int *, DeviceType> indices( "indices", 0 );
+    Details::NearestNeighborOperatorImpl<DeviceType>::search(
+        _comm, backend, source_points, queries, indices, _offset, ranks );
 
-    // Retrieve the coordinates of all source points that met the predicates.
+    // Build the plan to fetch the values of the source points that met the
+    // predicates and use it to retrieve their coordinates.
     // NOTE: This is the last collective.
-    source_points = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
-        _comm, _ranks, _indices, source_points );
+    _fetch_plan = Details::FetchPlan<DeviceType>( _comm, ranks, indices );
+    source_points = _fetch_plan.fetch( source_points );
 
     // Transform source points
     source_points = Details::MovingLeastSquaresOperatorImpl<
@@ -94,7 +99,7 @@ MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
     // MxM (U*E^+*V) as it will later be just used to do MxV. We could instead
     // return the (U,E^+,V) and do the MxV multiplication. But for now, it's OK.
     auto t = Details::MovingLeastSquaresOperatorImpl<DeviceType>::invertMoments(
-        a, PolynomialBasis::size );
+        _offset, a, PolynomialBasis::size );
     auto inv_a = std::get<0>( t );
 
     // std::get<1>(t) returns the number of undetermined system. However, this
@@ -109,6 +114,27 @@ MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
     _coeffs = Details::MovingLeastSquaresOperatorImpl<
         DeviceType>::computePolynomialCoefficients( _offset, inv_a, p, phi,
                                                     PolynomialBasis::size );
+
+    // List the target points that are not interpolated
+    auto const offset = _offset;
+    int const n_target_points = _offset.extent_int( 0 ) - 1;
+    _not_found_targets = Kokkos::View<int *, DeviceType>( "not_found_targets",
+                                                          n_target_points );
+    auto not_found = _not_found_targets;
+    int n_not_found = 0;
+    Kokkos::parallel_scan(
+        DTK_MARK_REGION( "find_targets_without_neighbors" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
+        KOKKOS_LAMBDA( int const i, int &update, bool const final_pass ) {
+            if ( offset( i + 1 ) == offset( i ) )
+            {
+                if ( final_pass )
+                    not_found( update ) = i;
+                ++update;
+            }
+        },
+        n_not_found );
+    Kokkos::resize( _not_found_targets, n_not_found );
 }
 
 template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
@@ -118,19 +144,61 @@ void MovingLeastSquaresOperator<
     apply( Kokkos::View<double const *, DeviceType> source_values,
            Kokkos::View<double *, DeviceType> target_values ) const
 {
-    // Precondition: check that the source and the target are properly sized
-    DTK_REQUIRE( source_values.extent( 0 ) == _n_source_points );
-    DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+    // Transfer the values as a single column.
+    Kokkos::View<double const **, DeviceType> source_column(
+        source_values.data(), source_values.extent( 0 ), 1 );
+    Kokkos::View<double **, DeviceType> target_column(
+        target_values.data(), target_values.extent( 0 ), 1 );
+    apply( source_column, target_column );
+}
 
-    // Retrieve values for all source points
-    source_values = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
-        _comm, _ranks, _indices, source_values );
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis>
+void MovingLeastSquaresOperator<
+    DeviceType, CompactlySupportedRadialBasisFunction, PolynomialBasis>::
+    apply( Kokkos::View<double const **, DeviceType> source_values,
+           Kokkos::View<double **, DeviceType> target_values ) const
+{
+    applyBegin( source_values, target_values )->wait();
+}
 
-    // Apply A-1 (P^T phi)
-    auto new_target_values = Details::MovingLeastSquaresOperatorImpl<
-        DeviceType>::computeTargetValues( _offset, _coeffs, source_values );
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis>
+std::unique_ptr<PointCloudOperatorRequest> MovingLeastSquaresOperator<
+    DeviceType, CompactlySupportedRadialBasisFunction, PolynomialBasis>::
+    applyBegin( Kokkos::View<double const **, DeviceType> source_values,
+                Kokkos::View<double **, DeviceType> target_values ) const
+{
+    return std::unique_ptr<PointCloudOperatorRequest>(
+        new Details::FetchApplyRequest<DeviceType>(
+            {prepareApply( source_values, target_values )} ) );
+}
 
-    Kokkos::deep_copy( target_values, new_target_values );
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis>
+Details::FetchApplyStep<DeviceType> MovingLeastSquaresOperator<
+    DeviceType, CompactlySupportedRadialBasisFunction, PolynomialBasis>::
+    prepareApply( Kokkos::View<double const **, DeviceType> source_values,
+                  Kokkos::View<double **, DeviceType> target_values ) const
+{
+    // Precondition: check that the source and the target are properly sized
+    DTK_REQUIRE( source_values.extent( 0 ) == _n_source_points );
+    DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+    // Retrieve values for all source points. All the columns are sent in the
+    // same messages. Once they are received, apply A-1 (P^T phi) to each
+    // column.
+    auto const offset = _offset;
+    auto const coeffs = _coeffs;
+    return {&_fetch_plan, source_values,
+            [offset, coeffs,
+             target_values]( Kokkos::View<double **, DeviceType> values ) {
+                auto new_target_values = Details::
+                    MovingLeastSquaresOperatorImpl<DeviceType>::
+                        computeTargetValues( offset, coeffs, values );
+                Kokkos::deep_copy( target_values, new_target_values );
+            }};
 }
 
 } // end namespace DataTransferKit
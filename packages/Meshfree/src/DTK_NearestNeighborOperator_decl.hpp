@@ -12,6 +12,7 @@
 #ifndef DTK_NEAREST_NEIGHBOR_OPERATOR_DECL_HPP
 #define DTK_NEAREST_NEIGHBOR_OPERATOR_DECL_HPP
 
+#include <DTK_DetailsFetchPlan.hpp>
 #include <DTK_PointCloudOperator.hpp>
 
 #include <mpi.h>
@@ -32,16 +33,28 @@ class NearestNeighborOperator : public PointCloudOperator<DeviceType>
     NearestNeighborOperator(
         MPI_Comm comm,
         Kokkos::View<Coordinate const **, DeviceType> source_points,
-        Kokkos::View<Coordinate const **, DeviceType> target_points );
+        Kokkos::View<Coordinate const **, DeviceType> target_points,
+        SearchBackend backend = SearchBackend::BoundingVolumeHierarchy );
 
     void
     apply( Kokkos::View<double const *, DeviceType> source_values,
            Kokkos::View<double *, DeviceType> target_values ) const override;
 
+    void
+    apply( Kokkos::View<double const **, DeviceType> source_values,
+           Kokkos::View<double **, DeviceType> target_values ) const override;
+
+    std::unique_ptr<PointCloudOperatorRequest> applyBegin(
+        Kokkos::View<double const **, DeviceType> source_values,
+        Kokkos::View<double **, DeviceType> target_values ) const override;
+
+    Details::FetchApplyStep<DeviceType> prepareApply(
+        Kokkos::View<double const **, DeviceType> source_values,
+        Kokkos::View<double **, DeviceType> target_values ) const override;
+
   private:
     MPI_Comm _comm;
-    Kokkos::View<int *, DeviceType> _indices;
-    Kokkos::View<int *, DeviceType> _ranks;
+    Details::FetchPlan<DeviceType> _fetch_plan;
     int const _size;
 };
 
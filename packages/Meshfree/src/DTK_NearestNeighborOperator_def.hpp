@@ -22,23 +22,14 @@ namespace DataTransferKit
 template <typename DeviceType>
 NearestNeighborOperator<DeviceType>::NearestNeighborOperator(
     MPI_Comm comm, Kokkos::View<Coordinate const **, DeviceType> source_points,
-    Kokkos::View<Coordinate const **, DeviceType> target_points )
+    Kokkos::View<Coordinate const **, DeviceType> target_points,
+    SearchBackend backend )
     : _comm( comm )
-    , _indices( "indices", 0 )
-    , _ranks( "ranks", 0 )
     , _size( source_points.extent_int( 0 ) )
 {
     // NOTE: instead of checking the pre-condition that there is at least one
-    // source point passed to one of the rank, we let the tree handle the
-    // communication and just check that the tree is not empty.
-
-    // Build distributed search tree over the source points.
-    ArborX::DistributedSearchTree<DeviceType> search_tree( _comm,
-                                                           source_points );
-
-    // Tree must have at least one leaf, otherwise it makes little sense to
-    // perform the search for nearest neighbors.
-    DTK_CHECK( !search_tree.empty() );
+    // source point passed to one of the rank, we let the search structure
+    // handle the communication and just check that it is not empty.
 
     // Query nearest neighbor for all target points.
     auto nearest_queries = Details::NearestNeighborOperatorImpl<
@@ -48,18 +39,19 @@ NearestNeighborOperator<DeviceType>::NearestNeighborOperator(
     Kokkos::View<int *, DeviceType> indices( "indices", 0 );
     Kokkos::View<int *, DeviceType> offset( "offset", 0 );
     Kokkos::View<int *, DeviceType> ranks( "ranks", 0 );
-    search_tree.query( nearest_queries, indices, offset, ranks );
+    Details::NearestNeighborOperatorImpl<DeviceType>::search(
+        _comm, backend, source_points, nearest_queries, indices, offset,
+        ranks );
 
     // Check post-condition that we did find a nearest neighbor to all target
     // points.
     DTK_ENSURE( ArborX::lastElement( offset ) ==
                 target_points.extent_int( 0 ) );
 
-    // Save results.
+    // Build the plan to fetch the values of the nearest neighbors.
     // NOTE: we don't bother keeping `offset` around since it is just `[0, 1, 2,
     // ..., n_target_poins]`
-    _indices = indices;
-    _ranks = ranks;
+    _fetch_plan = Details::FetchPlan<DeviceType>( _comm, ranks, indices );
 }
 
 template <typename DeviceType>
@@ -67,14 +59,50 @@ void NearestNeighborOperator<DeviceType>::apply(
     Kokkos::View<double const *, DeviceType> source_values,
     Kokkos::View<double *, DeviceType> target_values ) const
 {
-    // Precondition: check that the source and target are properly sized
-    DTK_REQUIRE( _indices.extent( 0 ) == target_values.extent( 0 ) );
-    DTK_REQUIRE( _size == source_values.extent_int( 0 ) );
+    // Transfer the values as a single column.
+    Kokkos::View<double const **, DeviceType> source_column(
+        source_values.data(), source_values.extent( 0 ), 1 );
+    Kokkos::View<double **, DeviceType> target_column(
+        target_values.data(), target_values.extent( 0 ), 1 );
+    apply( source_column, target_column );
+}
 
-    auto values = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
-        _comm, _ranks, _indices, source_values );
+template <typename DeviceType>
+void NearestNeighborOperator<DeviceType>::apply(
+    Kokkos::View<double const **, DeviceType> source_values,
+    Kokkos::View<double **, DeviceType> target_values ) const
+{
+    applyBegin( source_values, target_values )->wait();
+}
 
-    Kokkos::deep_copy( target_values, values );
+template <typename DeviceType>
+std::unique_ptr<PointCloudOperatorRequest>
+NearestNeighborOperator<DeviceType>::applyBegin(
+    Kokkos::View<double const **, DeviceType> source_values,
+    Kokkos::View<double **, DeviceType> target_values ) const
+{
+    return std::unique_ptr<PointCloudOperatorRequest>(
+        new Details::FetchApplyRequest<DeviceType>(
+            {prepareApply( source_values, target_values )} ) );
+}
+
+template <typename DeviceType>
+Details::FetchApplyStep<DeviceType>
+NearestNeighborOperator<DeviceType>::prepareApply(
+    Kokkos::View<double const **, DeviceType> source_values,
+    Kokkos::View<double **, DeviceType> target_values ) const
+{
+    // Precondition: check that the source and target are properly sized
+    DTK_REQUIRE( _fetch_plan.size() == target_values.extent_int( 0 ) );
+    DTK_REQUIRE( _size == source_values.extent_int( 0 ) );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+    // All the columns are sent in the same messages and the values fetched
+    // are the target values.
+    return {&_fetch_plan, source_values,
+            [target_values]( Kokkos::View<double **, DeviceType> values ) {
+                Kokkos::deep_copy( target_values, values );
+            }};
 }
 
 } // namespace DataTransferKit
@@ -16,8 +16,51 @@
 
 #include <Kokkos_View.hpp>
 
+#include <memory>
+
 namespace DataTransferKit
 {
+namespace Details
+{
+template <typename DeviceType>
+struct FetchApplyStep;
+}
+
+/**
+ * Data structure used to find the source points close to the target points.
+ * The bounding volume hierarchy makes no assumption on the distribution of
+ * the points. The spatial hash bins the points in a uniform grid and is
+ * faster for quasi-uniform point clouds. The rectilinear grid requires the
+ * source points to be the nodes of a rectilinear grid partitioned in blocks
+ * among the processors and finds the neighbors without any search structure.
+ */
+enum class SearchBackend
+{
+    BoundingVolumeHierarchy,
+    SpatialHash,
+    RectilinearGrid
+};
+
+/**
+ * Handle on an application of an operator started with
+ * PointCloudOperator::applyBegin().
+ */
+class PointCloudOperatorRequest
+{
+  public:
+    virtual ~PointCloudOperatorRequest() = default;
+
+    /**
+     * Return true if wait() does not need to wait for any communication.
+     */
+    virtual bool test() = 0;
+
+    /**
+     * Wait for the communication to complete and compute the target values.
+     */
+    virtual void wait() = 0;
+};
+
 /**
  * Base class for the MeshFree methods.
  */
@@ -34,6 +77,38 @@ class PointCloudOperator
     virtual void
     apply( Kokkos::View<double const *, DeviceType> source_values,
            Kokkos::View<double *, DeviceType> target_values ) const = 0;
+
+    /**
+     * Compute the values of several fields at the target points given their
+     * values at the source points. Each column is a field, or a component of
+     * a field, and all the columns are communicated together.
+     */
+    virtual void
+    apply( Kokkos::View<double const **, DeviceType> source_values,
+           Kokkos::View<double **, DeviceType> target_values ) const = 0;
+
+    /**
+     * Start computing the values of the fields in the columns of
+     * \p source_values at the target points. The source values may be
+     * modified once this function returns. The target values are only
+     * written when the request returned is waited on. The operator must
+     * outlive the request.
+     */
+    virtual std::unique_ptr<PointCloudOperatorRequest>
+    applyBegin( Kokkos::View<double const **, DeviceType> source_values,
+                Kokkos::View<double **, DeviceType> target_values ) const = 0;
+
+    /**
+     * Describe the application of the operator to the fields in the columns
+     * of \p source_values without starting any communication. The
+     * applications of several operators built over the same group of
+     * processes can be started together by a Details::FetchApplyRequest so
+     * that each pair of processes exchanges a single message for all of
+     * them.
+     */
+    virtual Details::FetchApplyStep<DeviceType>
+    prepareApply( Kokkos::View<double const **, DeviceType> source_values,
+                  Kokkos::View<double **, DeviceType> target_values ) const = 0;
 };
 
 } // end namespace DataTransferKit
@@ -0,0 +1,238 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <DTK_DBC.hpp>
+#include <DTK_RectilinearGridLocator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace DataTransferKit
+{
+
+RectilinearGridLocator::RectilinearGridLocator(
+    MPI_Comm comm, std::array<int, 3> const &num_blocks,
+    std::array<int, 3> const &ijk_block,
+    std::array<std::vector<double>, 3> const &local_edges,
+    std::array<int, 3> const &edge_offsets,
+    std::vector<int> const &block_ranks )
+    : _num_blocks( num_blocks )
+    , _block_ranks( block_ranks )
+{
+    DTK_REQUIRE( _block_ranks.size() ==
+                 static_cast<std::size_t>( _num_blocks[0] * _num_blocks[1] *
+                                           _num_blocks[2] ) );
+
+    for ( int d = 0; d < 3; ++d )
+    {
+        int const local_num_node = local_edges[d].size();
+        int const offset = local_num_node > 0 ? edge_offsets[d] : 0;
+
+        // Compose the global edges. Every block contributes the nodes it
+        // owns and the overlapping nodes are identical so a max reduction
+        // recovers the global array. The replicas of the grid hold the same
+        // nodes so the reduction can be done over the whole communicator.
+        int const local_end = offset + local_num_node;
+        int global_num_node = 0;
+        MPI_Allreduce( &local_end, &global_num_node, 1, MPI_INT, MPI_MAX,
+                       comm );
+        DTK_INSIST( global_num_node > 0 );
+        std::vector<double> send_edges( global_num_node,
+                                        std::numeric_limits<double>::lowest() );
+        std::copy( local_edges[d].begin(), local_edges[d].end(),
+                   send_edges.begin() + offset );
+        _global_edges[d].resize( global_num_node );
+        MPI_Allreduce( send_edges.data(), _global_edges[d].data(),
+                       global_num_node, MPI_DOUBLE, MPI_MAX, comm );
+        DTK_CHECK( std::is_sorted( _global_edges[d].begin(),
+                                   _global_edges[d].end() ) );
+
+        // Gather the cell range of each block.
+        std::vector<int> send_offsets( _num_blocks[d], 0 );
+        std::vector<int> send_num_cells( _num_blocks[d], 0 );
+        if ( local_num_node > 0 )
+        {
+            send_offsets[ijk_block[d]] = offset;
+            send_num_cells[ijk_block[d]] = local_num_node - 1;
+        }
+        _block_offsets[d].resize( _num_blocks[d] );
+        MPI_Allreduce( send_offsets.data(), _block_offsets[d].data(),
+                       _num_blocks[d], MPI_INT, MPI_MAX, comm );
+        _block_num_cells[d].resize( _num_blocks[d] );
+        MPI_Allreduce( send_num_cells.data(), _block_num_cells[d].data(),
+                       _num_blocks[d], MPI_INT, MPI_MAX, comm );
+
+        // Check if the edges are uniformly spaced so that cells can be
+        // located with a direct index computation. A flat grid has a single
+        // edge and no cell in that dimension.
+        auto const &edges = _global_edges[d];
+        int const num_cell = global_num_node - 1;
+        double const length = edges.back() - edges.front();
+        _delta[d] = num_cell > 0 ? length / num_cell : 0.;
+        double const tol = 1.0e-10 * length;
+        _uniform[d] = true;
+        for ( int n = 1; n < global_num_node; ++n )
+            if ( std::abs( edges[n] - ( edges.front() + n * _delta[d] ) ) >
+                 tol )
+            {
+                _uniform[d] = false;
+                break;
+            }
+    }
+}
+
+void RectilinearGridLocator::locate(
+    Kokkos::View<Coordinate **> points, Kokkos::View<int *> &ranks,
+    Kokkos::View<GlobalOrdinal *> &cell_ids,
+    Kokkos::View<LocalOrdinal *> &local_cell_ids ) const
+{
+    DTK_REQUIRE( points.extent( 1 ) == 3 );
+
+    int const num_points = points.extent( 0 );
+    ranks = Kokkos::View<int *>( "ranks", num_points );
+    cell_ids = Kokkos::View<GlobalOrdinal *>( "cell_ids", num_points );
+    local_cell_ids =
+        Kokkos::View<LocalOrdinal *>( "local_cell_ids", num_points );
+
+    int const x_global_num_cell = _global_edges[0].size() - 1;
+    int const y_global_num_cell = _global_edges[1].size() - 1;
+
+    for ( int p = 0; p < num_points; ++p )
+    {
+        ranks( p ) = -1;
+        cell_ids( p ) = -1;
+        local_cell_ids( p ) = -1;
+
+        // Find the cell in each dimension.
+        std::array<int, 3> ijk_cell;
+        bool found = true;
+        for ( int d = 0; d < 3 && found; ++d )
+        {
+            ijk_cell[d] = locateCell( d, points( p, d ) );
+            found = ( ijk_cell[d] >= 0 );
+        }
+        if ( !found )
+            continue;
+
+        // Find the owning rank and compose the global cell id.
+        cellOwner( ijk_cell, ranks( p ), local_cell_ids( p ) );
+        if ( ranks( p ) >= 0 )
+            cell_ids( p ) = ijk_cell[0] + x_global_num_cell * ijk_cell[1] +
+                            x_global_num_cell * y_global_num_cell * ijk_cell[2];
+    }
+}
+
+void RectilinearGridLocator::cellOwner( std::array<int, 3> const &ijk_cell,
+                                        int &rank,
+                                        LocalOrdinal &local_cell_id ) const
+{
+    rank = -1;
+    local_cell_id = -1;
+
+    // Find the owning block in each dimension.
+    std::array<int, 3> ijk_block;
+    for ( int d = 0; d < 3; ++d )
+    {
+        ijk_block[d] = locateBlock( d, ijk_cell[d], false );
+        if ( ijk_block[d] < 0 )
+            return;
+    }
+
+    // Compose the owning rank and the local cell id.
+    int const block_id = ijk_block[0] + _num_blocks[0] * ijk_block[1] +
+                         _num_blocks[0] * _num_blocks[1] * ijk_block[2];
+    rank = _block_ranks[block_id];
+
+    int const x_local_num_cell = _block_num_cells[0][ijk_block[0]];
+    int const y_local_num_cell = _block_num_cells[1][ijk_block[1]];
+    local_cell_id =
+        ( ijk_cell[0] - _block_offsets[0][ijk_block[0]] ) +
+        x_local_num_cell * ( ijk_cell[1] - _block_offsets[1][ijk_block[1]] ) +
+        x_local_num_cell * y_local_num_cell *
+            ( ijk_cell[2] - _block_offsets[2][ijk_block[2]] );
+}
+
+void RectilinearGridLocator::nodeOwner( std::array<int, 3> const &ijk_node,
+                                        int &rank,
+                                        LocalOrdinal &local_node_id ) const
+{
+    rank = -1;
+    local_node_id = -1;
+
+    std::array<int, 3> ijk_block;
+    for ( int d = 0; d < 3; ++d )
+    {
+        ijk_block[d] = locateBlock( d, ijk_node[d], true );
+        if ( ijk_block[d] < 0 )
+            return;
+    }
+
+    int const block_id = ijk_block[0] + _num_blocks[0] * ijk_block[1] +
+                         _num_blocks[0] * _num_blocks[1] * ijk_block[2];
+    rank = _block_ranks[block_id];
+
+    int const x_local_num_node = _block_num_cells[0][ijk_block[0]] + 1;
+    int const y_local_num_node = _block_num_cells[1][ijk_block[1]] + 1;
+    local_node_id =
+        ( ijk_node[0] - _block_offsets[0][ijk_block[0]] ) +
+        x_local_num_node * ( ijk_node[1] - _block_offsets[1][ijk_block[1]] ) +
+        x_local_num_node * y_local_num_node *
+            ( ijk_node[2] - _block_offsets[2][ijk_block[2]] );
+}
+
+int RectilinearGridLocator::locateCell( int dim, double x ) const
+{
+    auto const &edges = _global_edges[dim];
+    int const num_cell = edges.size() - 1;
+    if ( num_cell == 0 || x < edges.front() || x > edges.back() )
+        return -1;
+
+    int cell;
+    if ( _uniform[dim] )
+    {
+        // Compute the index directly and correct for roundoff so that the
+        // result is consistent with the edge values.
+        cell = std::floor( ( x - edges.front() ) / _delta[dim] );
+        cell = std::max( 0, std::min( cell, num_cell - 1 ) );
+        if ( x < edges[cell] )
+            --cell;
+        else if ( cell < num_cell - 1 && x >= edges[cell + 1] )
+            ++cell;
+    }
+    else
+    {
+        cell = std::distance(
+                   edges.begin(),
+                   std::upper_bound( edges.begin(), edges.end(), x ) ) -
+               1;
+    }
+
+    // Points on the upper boundary belong to the last cell.
+    return std::min( cell, num_cell - 1 );
+}
+
+int RectilinearGridLocator::locateBlock( int dim, int index, bool node ) const
+{
+    auto const &offsets = _block_offsets[dim];
+    int const block =
+        std::distance( offsets.begin(), std::upper_bound( offsets.begin(),
+                                                          offsets.end(),
+                                                          index ) ) -
+        1;
+    if ( block < 0 || index >= offsets[block] +
+                                   _block_num_cells[dim][block] +
+                                   ( node ? 1 : 0 ) )
+        return -1;
+    return block;
+}
+
+} // namespace DataTransferKit
@@ -0,0 +1,141 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_RECTILINEAR_GRID_LOCATOR_HPP
+#define DTK_RECTILINEAR_GRID_LOCATOR_HPP
+
+#include <DTK_Types.h>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <array>
+#include <vector>
+
+namespace DataTransferKit
+{
+/**
+ * Locate points in a rectilinear grid partitioned in blocks without building
+ * a search tree.
+ *
+ * The global edges of the grid and the block decomposition are gathered once
+ * from the local blocks of the processors. A point is then located with one
+ * lookup per dimension: a direct index computation when the edges of that
+ * dimension are uniformly spaced and a binary search otherwise. The block
+ * owning a cell or a node, and therefore the rank owning it, follows from a
+ * binary search over the block offsets.
+ *
+ * When blocks overlap (i.e. a boundary plane intersects a cell and the cell
+ * is ghosted on both sides, or a node is on the boundary between two blocks)
+ * the cell or the node is attributed to the block with the largest index
+ * along each dimension.
+ */
+class RectilinearGridLocator
+{
+  public:
+    /**
+     * Constructor. This is a collective operation. The grid is partitioned in
+     * \p num_blocks blocks along each dimension and the nodes of the block
+     * \p ijk_block of this processor are \p local_edges, which start at
+     * \p edge_offsets in the global edges. The block (i, j, k) is owned by
+     * the rank block_ranks[i + num_blocks[0] * (j + num_blocks[1] * k)]. The
+     * processors that do not own any block pass empty edges. The grid may be
+     * replicated, in which case several processors pass the same block.
+     */
+    RectilinearGridLocator(
+        MPI_Comm comm, std::array<int, 3> const &num_blocks,
+        std::array<int, 3> const &ijk_block,
+        std::array<std::vector<double>, 3> const &local_edges,
+        std::array<int, 3> const &edge_offsets,
+        std::vector<int> const &block_ranks );
+
+    /**
+     * Locate points in the grid. The views are accessed on the host.
+     *
+     * \param points The coordinates of the points (n points, 3).
+     *
+     * \param ranks The rank owning the cell containing each point or -1 if
+     * the point is outside of the grid.
+     *
+     * \param cell_ids The global id of the cell containing each point or -1
+     * if the point is outside of the grid.
+     *
+     * \param local_cell_ids The local id of the cell containing each point on
+     * the owning rank or -1 if the point is outside of the grid.
+     */
+    void locate( Kokkos::View<Coordinate **> points,
+                 Kokkos::View<int *> &ranks,
+                 Kokkos::View<GlobalOrdinal *> &cell_ids,
+                 Kokkos::View<LocalOrdinal *> &local_cell_ids ) const;
+
+    /**
+     * Find the rank owning a cell and the local id of the cell on that rank.
+     * The rank and the local id are -1 if no block owns the cell.
+     */
+    void cellOwner( std::array<int, 3> const &ijk_cell, int &rank,
+                    LocalOrdinal &local_cell_id ) const;
+
+    /**
+     * Find the rank owning a node and the local id of the node on that rank,
+     * the nodes of a block being numbered with the x index varying fastest.
+     * The rank and the local id are -1 if no block owns the node.
+     */
+    void nodeOwner( std::array<int, 3> const &ijk_node, int &rank,
+                    LocalOrdinal &local_node_id ) const;
+
+    /**
+     * Find the global index of the cell containing a coordinate in a given
+     * dimension. Return -1 if the coordinate is outside of the grid.
+     */
+    int locateCell( int dim, double x ) const;
+
+    // Get the global edges in a given dimension.
+    std::vector<double> const &globalEdges( int dim ) const
+    {
+        return _global_edges[dim];
+    }
+
+    // Whether the global edges in a given dimension are uniformly spaced.
+    bool isUniform( int dim ) const { return _uniform[dim]; }
+
+  private:
+    // Find the index of the block owning a global index in a given
+    // dimension. The cells of the block b range from _block_offsets[b] to
+    // _block_offsets[b] + _block_num_cells[b] - 1 and its nodes have one more
+    // index. Return -1 if no block owns the index.
+    int locateBlock( int dim, int index, bool node ) const;
+
+    // Number of blocks in each dimension.
+    std::array<int, 3> _num_blocks;
+
+    // Rank owning each block.
+    std::vector<int> _block_ranks;
+
+    // Global edges in each dimension.
+    std::array<std::vector<double>, 3> _global_edges;
+
+    // Whether the global edges are uniformly spaced in each dimension.
+    std::array<bool, 3> _uniform;
+
+    // Cell size in each dimension if the edges are uniformly spaced.
+    std::array<double, 3> _delta;
+
+    // Starting index of the cells of each block in each dimension.
+    std::array<std::vector<int>, 3> _block_offsets;
+
+    // Number of cells of each block in each dimension.
+    std::array<std::vector<int>, 3> _block_num_cells;
+};
+
+} // namespace DataTransferKit
+
+#endif
@@ -0,0 +1,286 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_SPATIAL_HASH_HPP
+#define DTK_SPATIAL_HASH_HPP
+
+#include <ArborX.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_Types.h>
+
+#include <Kokkos_Array.hpp>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace DataTransferKit
+{
+namespace Details
+{
+// Index of the cell containing x along one dimension. Points outside of the
+// grid are assigned to the closest cell.
+KOKKOS_INLINE_FUNCTION
+int spatialHashCell( double x, double origin, double cell_size, int n_cells )
+{
+    double const i = ( x - origin ) / cell_size;
+    if ( i < 0. )
+        return 0;
+    if ( i >= n_cells )
+        return n_cells - 1;
+    return static_cast<int>( i );
+}
+} // namespace Details
+
+/**
+ * Cell list over a set of points. The points are binned in a uniform grid of
+ * cubic cells. For quasi-uniform point clouds with cells about the size of
+ * the neighborhood searched, the nearest neighbors are found by visiting a
+ * few cells around the query which is cheaper to build and has a better
+ * memory access pattern than a bounding volume hierarchy.
+ */
+template <typename DeviceType>
+class SpatialHash
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    /**
+     * Bin the points in the cells of size \p cell_size covering the box
+     * defined by \p min_corner and \p max_corner. Points outside of the box
+     * are binned in the closest cell.
+     */
+    SpatialHash( Kokkos::View<Coordinate const **, DeviceType> points,
+                 Kokkos::Array<double, 3> const &min_corner,
+                 Kokkos::Array<double, 3> const &max_corner,
+                 double cell_size );
+
+    /**
+     * Find the k nearest points of each query. The indices of the points found
+     * for query i are stored in indices(offset(i)) to indices(offset(i+1)-1)
+     * by increasing distance and the corresponding squared distances are
+     * stored in squared_distances. Fewer than k points are returned if there
+     * are fewer than k points in the hash.
+     */
+    void query(
+        Kokkos::View<ArborX::Nearest<ArborX::Point> const *, DeviceType>
+            queries,
+        Kokkos::View<int *, DeviceType> &indices,
+        Kokkos::View<int *, DeviceType> &offset,
+        Kokkos::View<double *, DeviceType> &squared_distances ) const;
+
+    int size() const { return _points.extent_int( 0 ); }
+
+  private:
+    Kokkos::View<Coordinate const **, DeviceType> _points;
+    Kokkos::Array<double, 3> _origin;
+    double _cell_size;
+    Kokkos::Array<int, 3> _n_cells;
+    // Points of cell c are _permutation(_cell_offset(c)) to
+    // _permutation(_cell_offset(c+1)-1)
+    Kokkos::View<int *, DeviceType> _cell_offset;
+    Kokkos::View<int *, DeviceType> _permutation;
+};
+
+template <typename DeviceType>
+SpatialHash<DeviceType>::SpatialHash(
+    Kokkos::View<Coordinate const **, DeviceType> points,
+    Kokkos::Array<double, 3> const &min_corner,
+    Kokkos::Array<double, 3> const &max_corner, double cell_size )
+    : _points( points )
+    , _origin( min_corner )
+    , _cell_size( cell_size )
+{
+    DTK_REQUIRE( points.extent_int( 1 ) == 3 );
+    DTK_REQUIRE( cell_size > 0. );
+
+    int n_cells_total = 1;
+    for ( int d = 0; d < 3; ++d )
+    {
+        double const extent = max_corner[d] - min_corner[d];
+        _n_cells[d] = extent > 0. ? std::ceil( extent / cell_size ) : 1;
+        if ( _n_cells[d] < 1 )
+            _n_cells[d] = 1;
+        n_cells_total *= _n_cells[d];
+    }
+
+    // Count the points in each cell. The last entry is left to zero so that
+    // the exclusive prefix sum gives the offsets with the total at the end.
+    int const n_points = points.extent( 0 );
+    Kokkos::View<int *, DeviceType> cell_of_point( "cell_of_point", n_points );
+    Kokkos::View<int *, DeviceType> cell_count( "cell_count",
+                                                n_cells_total + 1 );
+    auto const origin = _origin;
+    auto const n_cells = _n_cells;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "bin_points" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+        KOKKOS_LAMBDA( int const i ) {
+            int c[3];
+            for ( int d = 0; d < 3; ++d )
+                c[d] = Details::spatialHashCell( points( i, d ), origin[d],
+                                                 cell_size, n_cells[d] );
+            int const cell = c[0] + n_cells[0] * ( c[1] + n_cells[1] * c[2] );
+            cell_of_point( i ) = cell;
+            Kokkos::atomic_increment( &cell_count( cell ) );
+        } );
+    Kokkos::fence();
+
+    _cell_offset =
+        Kokkos::View<int *, DeviceType>( "cell_offset", n_cells_total + 1 );
+    ArborX::exclusivePrefixSum( ExecutionSpace{}, cell_count, _cell_offset );
+
+    // Sort the points by cell.
+    Kokkos::deep_copy( cell_count, 0 );
+    _permutation = Kokkos::View<int *, DeviceType>( "permutation", n_points );
+    auto cell_offset = _cell_offset;
+    auto permutation = _permutation;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "sort_points_by_cell" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+        KOKKOS_LAMBDA( int const i ) {
+            int const cell = cell_of_point( i );
+            int const pos = Kokkos::atomic_fetch_add( &cell_count( cell ), 1 );
+            permutation( cell_offset( cell ) + pos ) = i;
+        } );
+    Kokkos::fence();
+}
+
+template <typename DeviceType>
+void SpatialHash<DeviceType>::query(
+    Kokkos::View<ArborX::Nearest<ArborX::Point> const *, DeviceType> queries,
+    Kokkos::View<int *, DeviceType> &indices,
+    Kokkos::View<int *, DeviceType> &offset,
+    Kokkos::View<double *, DeviceType> &squared_distances ) const
+{
+    int const n_queries = queries.extent( 0 );
+    int const n_points = size();
+
+    // Every query gets k points unless there are fewer points in the hash.
+    Kokkos::View<int *, DeviceType> count( "count", n_queries + 1 );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "count_neighbors" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_queries ),
+        KOKKOS_LAMBDA( int const i ) {
+            int const k = queries( i )._k;
+            count( i ) = k < n_points ? k : n_points;
+        } );
+    Kokkos::fence();
+    offset = Kokkos::View<int *, DeviceType>( "offset", n_queries + 1 );
+    ArborX::exclusivePrefixSum( ExecutionSpace{}, count, offset );
+    int const n_results = ArborX::lastElement( offset );
+    indices = Kokkos::View<int *, DeviceType>( "indices", n_results );
+    squared_distances =
+        Kokkos::View<double *, DeviceType>( "squared_distances", n_results );
+
+    // Visit the cells by rings of increasing Chebyshev distance around the
+    // cell of the query. The points in the cells at Chebyshev distance larger
+    // than r are at least r cell sizes away from the query so the search
+    // stops once the k-th neighbor is closer than that.
+    auto const points = _points;
+    auto const origin = _origin;
+    auto const cell_size = _cell_size;
+    auto const n_cells = _n_cells;
+    auto const cell_offset = _cell_offset;
+    auto const permutation = _permutation;
+    auto offset_ = offset;
+    auto indices_ = indices;
+    auto squared_distances_ = squared_distances;
+    int const max_ring =
+        std::max( n_cells[0], std::max( n_cells[1], n_cells[2] ) );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "query_spatial_hash" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_queries ),
+        KOKKOS_LAMBDA( int const i ) {
+            int const begin = offset_( i );
+            int const k = offset_( i + 1 ) - begin;
+            if ( k == 0 )
+                return;
+            auto const &point = queries( i )._geometry;
+            int c[3];
+            for ( int d = 0; d < 3; ++d )
+                c[d] = Details::spatialHashCell( point[d], origin[d],
+                                                 cell_size, n_cells[d] );
+            int n_found = 0;
+            for ( int r = 0; r <= max_ring; ++r )
+            {
+                if ( n_found == k && r > 0 )
+                {
+                    double const reach = ( r - 1 ) * cell_size;
+                    if ( squared_distances_( begin + k - 1 ) <=
+                         reach * reach )
+                        break;
+                }
+                for ( int di = -r; di <= r; ++di )
+                {
+                    int const ci = c[0] + di;
+                    if ( ci < 0 || ci >= n_cells[0] )
+                        continue;
+                    for ( int dj = -r; dj <= r; ++dj )
+                    {
+                        int const cj = c[1] + dj;
+                        if ( cj < 0 || cj >= n_cells[1] )
+                            continue;
+                        // Only visit the cells on the ring.
+                        bool const on_ring = ( di == -r || di == r ||
+                                               dj == -r || dj == r );
+                        int const step = on_ring ? 1 : 2 * r;
+                        for ( int dk = -r; dk <= r; dk += step )
+                        {
+                            int const ck = c[2] + dk;
+                            if ( ck < 0 || ck >= n_cells[2] )
+                                continue;
+                            int const cell =
+                                ci + n_cells[0] * ( cj + n_cells[1] * ck );
+                            for ( int j = cell_offset( cell );
+                                  j < cell_offset( cell + 1 ); ++j )
+                            {
+                                int const q = permutation( j );
+                                double d2 = 0.;
+                                for ( int d = 0; d < 3; ++d )
+                                {
+                                    double const dx = points( q, d ) - point[d];
+                                    d2 += dx * dx;
+                                }
+                                // Insert the point in the sorted list of the
+                                // neighbors found so far.
+                                int pos;
+                                if ( n_found < k )
+                                    pos = n_found++;
+                                else if ( d2 <
+                                          squared_distances_( begin + k - 1 ) )
+                                    pos = k - 1;
+                                else
+                                    continue;
+                                while ( pos > 0 &&
+                                        squared_distances_( begin + pos - 1 ) >
+                                            d2 )
+                                {
+                                    squared_distances_( begin + pos ) =
+                                        squared_distances_( begin + pos - 1 );
+                                    indices_( begin + pos ) =
+                                        indices_( begin + pos - 1 );
+                                    --pos;
+                                }
+                                squared_distances_( begin + pos ) = d2;
+                                indices_( begin + pos ) = q;
+                            }
+                        }
+                    }
+                }
+            }
+        } );
+    Kokkos::fence();
+}
+
+} // namespace DataTransferKit
+
+#endif
@@ -0,0 +1,118 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <DTK_DelegatedEvaluationOperator.hpp>
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( DelegatedEvaluationOperator, slabs,
+                                   DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    // Each rank owns a row of unit cubes along the x axis. The target points
+    // of a rank are in the cubes of the rank with the inverse rank.
+    int const n_objects = 10;
+    Kokkos::View<DataTransferKit::Coordinate * * [2], DeviceType>
+        bounding_volumes( "bounding_volumes", n_objects, 3 );
+    auto bounding_volumes_host = Kokkos::create_mirror_view( bounding_volumes );
+    for ( int i = 0; i < n_objects; ++i )
+    {
+        bounding_volumes_host( i, 0, 0 ) = comm_rank * n_objects + i;
+        bounding_volumes_host( i, 0, 1 ) = comm_rank * n_objects + i + 1.;
+        for ( int d = 1; d < 3; ++d )
+        {
+            bounding_volumes_host( i, d, 0 ) = 0.;
+            bounding_volumes_host( i, d, 1 ) = 1.;
+        }
+    }
+    Kokkos::deep_copy( bounding_volumes, bounding_volumes_host );
+
+    int const inverse_rank = comm_size - comm_rank - 1;
+    int const n_target_points = 2 * n_objects;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> target_points(
+        "target_points", n_target_points, 3 );
+    auto target_points_host = Kokkos::create_mirror_view( target_points );
+    for ( int i = 0; i < n_target_points; ++i )
+    {
+        target_points_host( i, 0 ) = inverse_rank * n_objects + 0.5 * i + 0.2;
+        target_points_host( i, 1 ) = 0.1 * ( i % 10 );
+        target_points_host( i, 2 ) = 0.5;
+    }
+    Kokkos::deep_copy( target_points, target_points_host );
+
+    DataTransferKit::DelegatedEvaluationOperator<DeviceType> op(
+        comm, bounding_volumes, target_points );
+
+    // The points received are in the objects of this rank. Evaluate two
+    // linear functions at them like an application would.
+    auto evaluation_points = op.evaluationPoints();
+    auto object_ids = op.objectIds();
+    TEST_EQUALITY( evaluation_points.extent_int( 0 ), n_target_points );
+    TEST_EQUALITY( object_ids.extent_int( 0 ), n_target_points );
+    auto evaluation_points_host =
+        Kokkos::create_mirror_view( evaluation_points );
+    Kokkos::deep_copy( evaluation_points_host, evaluation_points );
+    auto object_ids_host = Kokkos::create_mirror_view( object_ids );
+    Kokkos::deep_copy( object_ids_host, object_ids );
+    int const n_evaluation_points = evaluation_points.extent( 0 );
+    Kokkos::View<double **, DeviceType> source_values(
+        "source_values", n_evaluation_points, 2 );
+    auto source_values_host = Kokkos::create_mirror_view( source_values );
+    for ( int k = 0; k < n_evaluation_points; ++k )
+    {
+        double const x = evaluation_points_host( k, 0 );
+        double const y = evaluation_points_host( k, 1 );
+        TEST_EQUALITY( object_ids_host( k ),
+                       static_cast<int>( std::floor( x ) ) -
+                           comm_rank * n_objects );
+        source_values_host( k, 0 ) = x + 2. * y;
+        source_values_host( k, 1 ) = -x;
+    }
+    Kokkos::deep_copy( source_values, source_values_host );
+
+    Kokkos::View<double **, DeviceType> target_values( "target_values",
+                                                       n_target_points, 2 );
+    op.apply( source_values, target_values );
+
+    auto target_values_host = Kokkos::create_mirror_view( target_values );
+    Kokkos::deep_copy( target_values_host, target_values );
+    for ( int i = 0; i < n_target_points; ++i )
+    {
+        double const x = target_points_host( i, 0 );
+        double const y = target_points_host( i, 1 );
+        TEST_FLOATING_EQUALITY( target_values_host( i, 0 ), x + 2. * y,
+                                1e-14 );
+        TEST_FLOATING_EQUALITY( target_values_host( i, 1 ), -x, 1e-14 );
+    }
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( DelegatedEvaluationOperator, slabs,  \
+                                          DeviceType##NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
@@ -18,6 +18,7 @@
 
 #include <array>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -276,6 +277,59 @@ TEUCHOS_UNIT_TEST_TEMPLATE_3_DECL( MovingLeastSquaresOperator, grid, DeviceType,
     Kokkos::deep_copy( target_values_host, target_values );
     TEST_COMPARE_FLOATING_ARRAYS( target_values_host, target_values_ref,
                                   1e-14 );
+
+    // Transfer f and 2f together
+    Kokkos::View<double **, DeviceType> source_columns( "source_columns",
+                                                        n_source_points, 2 );
+    auto source_columns_host = Kokkos::create_mirror_view( source_columns );
+    for ( unsigned int i = 0; i < n_source_points; ++i )
+    {
+        source_columns_host( i, 0 ) = source_values_arr[i];
+        source_columns_host( i, 1 ) = 2. * source_values_arr[i];
+    }
+    Kokkos::deep_copy( source_columns, source_columns_host );
+    Kokkos::View<double **, DeviceType> target_columns( "target_columns",
+                                                        n_target_points, 2 );
+
+    mlsop.apply( source_columns, target_columns );
+
+    auto target_columns_host = Kokkos::create_mirror_view( target_columns );
+    Kokkos::deep_copy( target_columns_host, target_columns );
+    for ( unsigned int i = 0; i < n_target_points; ++i )
+    {
+        TEST_FLOATING_EQUALITY( target_columns_host( i, 0 ),
+                                target_values_ref[i], 1e-14 );
+        TEST_FLOATING_EQUALITY( target_columns_host( i, 1 ),
+                                2. * target_values_ref[i], 1e-14 );
+    }
+
+    // The source points of all the processors are the nodes of a rectilinear
+    // grid so their neighbors can also be found without a search tree.
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType, RadialBasisFunction,
+                                                PolynomialBasis>
+        grid_mlsop( comm, source_points, target_points,
+                    std::numeric_limits<double>::max(),
+                    SearchBackend::RectilinearGrid );
+
+    grid_mlsop.apply( source_values, target_values );
+
+    Kokkos::deep_copy( target_values_host, target_values );
+    TEST_COMPARE_FLOATING_ARRAYS( target_values_host, target_values_ref,
+                                  1e-12 );
+
+    // The processors exchange the source points around their target points
+    // and find the neighbors with a spatial hash.
+    DataTransferKit::MovingLeastSquaresOperator<DeviceType, RadialBasisFunction,
+                                                PolynomialBasis>
+        hash_mlsop( comm, source_points, target_points,
+                    std::numeric_limits<double>::max(),
+                    SearchBackend::SpatialHash );
+
+    hash_mlsop.apply( source_values, target_values );
+
+    Kokkos::deep_copy( target_values_host, target_values );
+    TEST_COMPARE_FLOATING_ARRAYS( target_values_host, target_values_ref,
+                                  1e-12 );
 }
 
 TEUCHOS_UNIT_TEST_TEMPLATE_3_DECL( MovingLeastSquaresOperator, line, DeviceType,
@@ -18,6 +18,7 @@
 
 #include <array>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -35,11 +36,14 @@ class MLS
     MLS( std::vector<std::array<DataTransferKit::Coordinate, DIM>> const
              &source_points,
          std::vector<std::array<DataTransferKit::Coordinate, DIM>> const
-             &target_points );
+             &target_points,
+         double max_distance = std::numeric_limits<double>::max() );
 
     void apply( std::vector<double> const &source_values,
                 std::vector<double> &target_values );
 
+    std::vector<int> getNotFoundTargets() const;
+
   private:
     std::shared_ptr<DataTransferKit::MovingLeastSquaresOperator<
         DeviceType, RadialBasisFunction, PolynomialBasis>>
@@ -52,7 +56,8 @@ MLS<DeviceType, RadialBasisFunction, PolynomialBasis>::MLS(
     std::vector<std::array<DataTransferKit::Coordinate, DIM>> const
         &source_points,
     std::vector<std::array<DataTransferKit::Coordinate, DIM>> const
-        &target_points )
+        &target_points,
+    double max_distance )
 {
     unsigned int const n_source_points = source_points.size();
     Kokkos::View<DataTransferKit::Coordinate **, DeviceType> sources(
@@ -73,8 +78,8 @@ MLS<DeviceType, RadialBasisFunction, PolynomialBasis>::MLS(
     Kokkos::deep_copy( targets, targets_host );
 
     _mls = std::make_shared<DataTransferKit::MovingLeastSquaresOperator<
-        DeviceType, RadialBasisFunction, PolynomialBasis>>( MPI_COMM_WORLD,
-                                                            sources, targets );
+        DeviceType, RadialBasisFunction, PolynomialBasis>>(
+        MPI_COMM_WORLD, sources, targets, max_distance );
 }
 
 template <typename DeviceType, typename RadialBasisFunction,
@@ -106,6 +111,18 @@ void MLS<DeviceType, RadialBasisFunction, PolynomialBasis>::apply(
         target_values[i] = targets_host( i );
 }
 
+template <typename DeviceType, typename RadialBasisFunction,
+          typename PolynomialBasis>
+std::vector<int>
+MLS<DeviceType, RadialBasisFunction, PolynomialBasis>::getNotFoundTargets()
+    const
+{
+    auto not_found = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, _mls->getNotFoundTargets() );
+    return std::vector<int>( not_found.data(),
+                             not_found.data() + not_found.extent( 0 ) );
+}
+
 void checkResults( std::vector<double> const &values,
                    std::vector<double> const &references,
                    Teuchos::FancyOStream &out, bool &success )
@@ -131,6 +148,7 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( MovingLeastSquaresOperatorSimpleProblem,
 
         std::vector<double> ref_values = {255.};
         checkResults( target_values, ref_values, out, success );
+        TEST_EQUALITY( mls.getNotFoundTargets().size(), 0u );
     }
 
     // One source point but no target point.
@@ -148,6 +166,43 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( MovingLeastSquaresOperatorSimpleProblem,
         std::vector<double> ref_values = {};
         checkResults( target_values, ref_values, out, success );
     }
+
+    // The second target point is far away from the source points. It is not
+    // interpolated, it is reported as not found and its value is zero.
+    {
+        std::vector<std::array<DataTransferKit::Coordinate, DIM>>
+            source_points = {
+                {0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}};
+        std::vector<std::array<DataTransferKit::Coordinate, DIM>>
+            target_points = {{.25, .25, .25}, {10., 10., 10.}};
+        MLS<DeviceType> mls( source_points, target_points, 1. );
+
+        std::vector<double> source_values = {1., 2., 2., 2.};
+        std::vector<double> target_values = {-1., -1.};
+        mls.apply( source_values, target_values );
+
+        TEST_FLOATING_EQUALITY( target_values[0], 1.75, 1e-12 );
+        TEST_EQUALITY( target_values[1], 0. );
+        std::vector<int> const ref_not_found = {1};
+        TEST_COMPARE_ARRAYS( mls.getNotFoundTargets(), ref_not_found );
+    }
+
+    // Without max_distance, the same target points are both interpolated.
+    {
+        std::vector<std::array<DataTransferKit::Coordinate, DIM>>
+            source_points = {
+                {0., 0., 0.}, {1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}};
+        std::vector<std::array<DataTransferKit::Coordinate, DIM>>
+            target_points = {{.25, .25, .25}, {10., 10., 10.}};
+        MLS<DeviceType> mls( source_points, target_points );
+
+        std::vector<double> source_values = {1., 2., 2., 2.};
+        std::vector<double> target_values = {-1., -1.};
+        mls.apply( source_values, target_values );
+
+        TEST_FLOATING_EQUALITY( target_values[0], 1.75, 1e-12 );
+        TEST_EQUALITY( mls.getNotFoundTargets().size(), 0u );
+    }
 }
 
 // Include the test macros.
@@ -136,6 +136,35 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, unique_source_point,
     Kokkos::deep_copy( target_values_host, target_values );
     std::vector<double> target_values_ref = {255.};
     TEST_COMPARE_ARRAYS( target_values_host, target_values_ref );
+
+    // Transfer several columns at once
+    Kokkos::View<double **, DeviceType> source_columns(
+        "in", source_points.extent( 0 ), 2 );
+    Kokkos::View<double **, DeviceType> target_columns(
+        "out", target_points.extent( 0 ), 2 );
+    if ( comm_rank == 0 )
+    {
+        auto source_columns_host = Kokkos::create_mirror_view( source_columns );
+        source_columns_host( 0, 0 ) = 255.;
+        source_columns_host( 0, 1 ) = -1.;
+        Kokkos::deep_copy( source_columns, source_columns_host );
+    }
+
+    nnop.apply( source_columns, target_columns );
+
+    auto target_columns_host = Kokkos::create_mirror_view( target_columns );
+    Kokkos::deep_copy( target_columns_host, target_columns );
+    TEST_EQUALITY( target_columns_host( 0, 0 ), 255. );
+    TEST_EQUALITY( target_columns_host( 0, 1 ), -1. );
+
+    // Start the transfer and modify the source values before completing it
+    Kokkos::deep_copy( target_columns, 0. );
+    auto request = nnop.applyBegin( source_columns, target_columns );
+    Kokkos::deep_copy( source_columns, 0. );
+    request->wait();
+    Kokkos::deep_copy( target_columns_host, target_columns );
+    TEST_EQUALITY( target_columns_host( 0, 0 ), 255. );
+    TEST_EQUALITY( target_columns_host( 0, 1 ), -1. );
 }
 
 TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, structured_clouds,
@@ -269,6 +298,140 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, mixed_clouds,
     }
 }
 
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, spatial_hash,
+                                   DeviceType )
+{
+    // The source and the target are random clouds. The spatial hash must find
+    // the same nearest neighbors as the search tree.
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    // Build the random clouds of points. The source points of each processor
+    // are in a slab of the domain while the target points are spread over the
+    // whole domain so that the neighbors are found on the other processors.
+    DataTransferKit::Coordinate const Lx = 3.;
+    DataTransferKit::Coordinate const Ly = 5.;
+    DataTransferKit::Coordinate const Lz = 7.;
+    unsigned int const n_source_points = 1000;
+    auto source_cloud =
+        makeRandomCloud( Lx, Ly, Lz, n_source_points, comm_rank );
+    for ( auto &point : source_cloud )
+        point[0] += comm_rank * Lx;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> source_points(
+        "source_points", 0, 0 );
+    copyPointsFromCloud<DeviceType>( source_cloud, source_points );
+
+    unsigned int const n_target_points = 200;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> target_points(
+        "target_points", 0, 0 );
+    copyPointsFromCloud<DeviceType>(
+        makeRandomCloud( comm_size * Lx, Ly, Lz, n_target_points,
+                         comm_size + comm_rank ),
+        target_points );
+
+    Kokkos::View<double *, DeviceType> source_values( "source_values",
+                                                      n_source_points );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "set_source_values" ),
+        Kokkos::RangePolicy<typename DeviceType::execution_space>(
+            0, n_source_points ),
+        KOKKOS_LAMBDA( int i ) {
+            source_values( i ) = comm_rank * n_source_points + i;
+        } );
+    Kokkos::fence();
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> tree_op(
+        comm, source_points, target_points );
+    Kokkos::View<double *, DeviceType> tree_values( "tree_values",
+                                                    n_target_points );
+    tree_op.apply( source_values, tree_values );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> hash_op(
+        comm, source_points, target_points,
+        DataTransferKit::SearchBackend::SpatialHash );
+    Kokkos::View<double *, DeviceType> hash_values( "hash_values",
+                                                    n_target_points );
+    hash_op.apply( source_values, hash_values );
+
+    // Check results
+    auto tree_values_host = Kokkos::create_mirror_view( tree_values );
+    Kokkos::deep_copy( tree_values_host, tree_values );
+    auto hash_values_host = Kokkos::create_mirror_view( hash_values );
+    Kokkos::deep_copy( hash_values_host, hash_values );
+    TEST_COMPARE_ARRAYS( hash_values_host, tree_values_host );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, rectilinear_grid,
+                                   DeviceType )
+{
+    // The source points are the nodes of a rectilinear grid partitioned in
+    // slabs among the processors. The rectilinear grid must find the same
+    // nearest neighbors as the search tree.
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    DataTransferKit::Coordinate const Lx = 3.;
+    DataTransferKit::Coordinate const Ly = 5.;
+    DataTransferKit::Coordinate const Lz = 7.;
+    int const nx = 6;
+    int const ny = 5;
+    int const nz = 4;
+    unsigned int const n_source_points = nx * ny * nz;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> source_points(
+        "source_points", 0, 0 );
+    copyPointsFromCloud<DeviceType>(
+        makeStructuredCloud( Lx, Ly, Lz, nx, ny, nz, comm_rank * Lx ),
+        source_points );
+
+    // Some of the target points are outside of the grid.
+    unsigned int const n_target_points = 200;
+    auto target_cloud = makeRandomCloud( comm_size * Lx + 2., Ly + 2., Lz + 2.,
+                                         n_target_points, comm_rank );
+    for ( auto &point : target_cloud )
+        for ( int d = 0; d < 3; ++d )
+            point[d] -= 1.;
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> target_points(
+        "target_points", 0, 0 );
+    copyPointsFromCloud<DeviceType>( target_cloud, target_points );
+
+    Kokkos::View<double *, DeviceType> source_values( "source_values",
+                                                      n_source_points );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "set_source_values" ),
+        Kokkos::RangePolicy<typename DeviceType::execution_space>(
+            0, n_source_points ),
+        KOKKOS_LAMBDA( int i ) {
+            source_values( i ) = comm_rank * n_source_points + i;
+        } );
+    Kokkos::fence();
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> tree_op(
+        comm, source_points, target_points );
+    Kokkos::View<double *, DeviceType> tree_values( "tree_values",
+                                                    n_target_points );
+    tree_op.apply( source_values, tree_values );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> grid_op(
+        comm, source_points, target_points,
+        DataTransferKit::SearchBackend::RectilinearGrid );
+    Kokkos::View<double *, DeviceType> grid_values( "grid_values",
+                                                    n_target_points );
+    grid_op.apply( source_values, grid_values );
+
+    // Check results
+    auto tree_values_host = Kokkos::create_mirror_view( tree_values );
+    Kokkos::deep_copy( tree_values_host, tree_values );
+    auto grid_values_host = Kokkos::create_mirror_view( grid_values );
+    Kokkos::deep_copy( grid_values_host, grid_values );
+    TEST_COMPARE_ARRAYS( grid_values_host, tree_values_host );
+}
+
 // Include the test macros.
 #include "DataTransferKit_ETIHelperMacros.h"
 
@@ -280,7 +443,11 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, mixed_clouds,
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
         NearestNeighborOperator, structured_clouds, DeviceType##NODE )         \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( NearestNeighborOperator,             \
-                                          mixed_clouds, DeviceType##NODE )
+                                          mixed_clouds, DeviceType##NODE )     \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( NearestNeighborOperator,             \
+                                          spatial_hash, DeviceType##NODE )     \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( NearestNeighborOperator,             \
+                                          rectilinear_grid, DeviceType##NODE )
 
 // Demangle the types
 DTK_ETI_MANGLING_TYPEDEFS()
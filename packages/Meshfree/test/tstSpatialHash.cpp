@@ -0,0 +1,176 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <DTK_SpatialHash.hpp>
+
+#include <ArborX.hpp>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <utility>
+#include <vector>
+
+template <typename DeviceType>
+void checkNearestNeighbors(
+    DataTransferKit::SpatialHash<DeviceType> const &spatial_hash,
+    std::vector<std::array<double, 3>> const &points,
+    std::vector<std::array<double, 3>> const &query_points, int const k,
+    Teuchos::FancyOStream &out, bool &success )
+{
+    int const n_queries = query_points.size();
+    Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType> queries(
+        "queries", n_queries );
+    auto queries_host = Kokkos::create_mirror_view( queries );
+    for ( int i = 0; i < n_queries; ++i )
+        queries_host( i ) = ArborX::nearest(
+            ArborX::Point{{query_points[i][0], query_points[i][1],
+                           query_points[i][2]}},
+            k );
+    Kokkos::deep_copy( queries, queries_host );
+
+    Kokkos::View<int *, DeviceType> indices( "indices", 0 );
+    Kokkos::View<int *, DeviceType> offset( "offset", 0 );
+    Kokkos::View<double *, DeviceType> squared_distances( "distances", 0 );
+    spatial_hash.query( queries, indices, offset, squared_distances );
+
+    auto indices_host = Kokkos::create_mirror_view( indices );
+    Kokkos::deep_copy( indices_host, indices );
+    auto offset_host = Kokkos::create_mirror_view( offset );
+    Kokkos::deep_copy( offset_host, offset );
+    auto squared_distances_host =
+        Kokkos::create_mirror_view( squared_distances );
+    Kokkos::deep_copy( squared_distances_host, squared_distances );
+
+    // Compare with a brute force search. The distances are compared rather
+    // than the indices since points at the same distance may come in any
+    // order.
+    int const n_points = points.size();
+    int const n_neighbors = std::min( k, n_points );
+    TEST_EQUALITY( offset_host.extent_int( 0 ), n_queries + 1 );
+    for ( int i = 0; i < n_queries; ++i )
+    {
+        std::vector<std::pair<double, int>> distances( n_points );
+        for ( int j = 0; j < n_points; ++j )
+        {
+            double distance = 0.;
+            for ( int d = 0; d < 3; ++d )
+                distance += ( points[j][d] - query_points[i][d] ) *
+                            ( points[j][d] - query_points[i][d] );
+            distances[j] = std::make_pair( distance, j );
+        }
+        std::sort( distances.begin(), distances.end() );
+
+        TEST_EQUALITY( offset_host( i + 1 ) - offset_host( i ), n_neighbors );
+        for ( int j = 0; j < n_neighbors; ++j )
+        {
+            int const pos = offset_host( i ) + j;
+            TEST_FLOATING_EQUALITY( squared_distances_host( pos ),
+                                    distances[j].first, 1e-12 );
+            int const index = indices_host( pos );
+            double distance = 0.;
+            for ( int d = 0; d < 3; ++d )
+                distance += ( points[index][d] - query_points[i][d] ) *
+                            ( points[index][d] - query_points[i][d] );
+            TEST_FLOATING_EQUALITY( distance, distances[j].first, 1e-12 );
+        }
+    }
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( SpatialHash, random_points, DeviceType )
+{
+    // Random points in a box. Some of the queries are outside of the box and
+    // one query asks for more neighbors than there are points.
+    std::default_random_engine random_engine;
+    std::uniform_real_distribution<double> distribution( 0., 1. );
+    int const n_points = 500;
+    std::vector<std::array<double, 3>> points( n_points );
+    for ( auto &point : points )
+        for ( int d = 0; d < 3; ++d )
+            point[d] = ( d + 1 ) * distribution( random_engine );
+
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> points_view(
+        "points", n_points, 3 );
+    auto points_host = Kokkos::create_mirror_view( points_view );
+    for ( int i = 0; i < n_points; ++i )
+        for ( int d = 0; d < 3; ++d )
+            points_host( i, d ) = points[i][d];
+    Kokkos::deep_copy( points_view, points_host );
+
+    Kokkos::Array<double, 3> min_corner = {{0., 0., 0.}};
+    Kokkos::Array<double, 3> max_corner = {{1., 2., 3.}};
+    DataTransferKit::SpatialHash<DeviceType> spatial_hash(
+        points_view, min_corner, max_corner, 0.2 );
+    TEST_EQUALITY( spatial_hash.size(), n_points );
+
+    int const n_queries = 100;
+    std::uniform_real_distribution<double> query_distribution( -1., 4. );
+    std::vector<std::array<double, 3>> query_points( n_queries );
+    for ( auto &query_point : query_points )
+        for ( int d = 0; d < 3; ++d )
+            query_point[d] = query_distribution( random_engine );
+
+    checkNearestNeighbors( spatial_hash, points, query_points, 1, out,
+                           success );
+    checkNearestNeighbors( spatial_hash, points, query_points, 10, out,
+                           success );
+    checkNearestNeighbors( spatial_hash, points, query_points, n_points + 1,
+                           out, success );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( SpatialHash, flat_box, DeviceType )
+{
+    // The points are the nodes of a grid in the plane z = 1 and the cells are
+    // larger than the box in that direction.
+    int const n = 10;
+    std::vector<std::array<double, 3>> points;
+    for ( int j = 0; j < n; ++j )
+        for ( int i = 0; i < n; ++i )
+            points.push_back( {{0.1 * i, 0.1 * j, 1.}} );
+    int const n_points = points.size();
+
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> points_view(
+        "points", n_points, 3 );
+    auto points_host = Kokkos::create_mirror_view( points_view );
+    for ( int i = 0; i < n_points; ++i )
+        for ( int d = 0; d < 3; ++d )
+            points_host( i, d ) = points[i][d];
+    Kokkos::deep_copy( points_view, points_host );
+
+    Kokkos::Array<double, 3> min_corner = {{0., 0., 1.}};
+    Kokkos::Array<double, 3> max_corner = {{0.9, 0.9, 1.}};
+    DataTransferKit::SpatialHash<DeviceType> spatial_hash(
+        points_view, min_corner, max_corner, 0.25 );
+
+    std::vector<std::array<double, 3>> query_points = {
+        {{0.33, 0.47, 1.}}, {{0.33, 0.47, 0.}}, {{-1., 2., 1.5}}};
+    checkNearestNeighbors( spatial_hash, points, query_points, 4, out,
+                           success );
+}
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    using DeviceType##NODE = typename NODE::device_type;                       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( SpatialHash, random_points,          \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( SpatialHash, flat_box,               \
+                                          DeviceType##NODE )
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )